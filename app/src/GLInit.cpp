@@ -25,6 +25,7 @@
 namespace TrenchBroom {
     // Glew will undefine some of the names declared in GL.h, so we create new names here
     static Func0<void>& _glewInitialize = glewInitialize;
+    static Func1<GLboolean, const char*>& _glewIsSupported = glewIsSupported;
     
     static Func0<GLenum>& _glGetError = glGetError;
     static Func1<const GLubyte*, GLenum>& _glGetString = glGetString;
@@ -76,6 +77,13 @@ namespace TrenchBroom {
     static Func4<void, GLenum, GLintptr, GLsizeiptr, const GLvoid*>& _glBufferSubData = glBufferSubData;
     static Func2<GLvoid*, GLenum, GLenum>& _glMapBuffer = glMapBuffer;
     static Func1<GLboolean, GLenum>& _glUnmapBuffer = glUnmapBuffer;
+    static Func4<void, GLenum, GLsizeiptr, const GLvoid*, GLbitfield>& _glBufferStorage = glBufferStorage;
+    static Func4<GLvoid*, GLenum, GLintptr, GLsizeiptr, GLbitfield>& _glMapBufferRange = glMapBufferRange;
+    
+    static Func2<GLsync, GLenum, GLbitfield>& _glFenceSync = glFenceSync;
+    static Func3<GLenum, GLsync, GLbitfield, GLuint64>& _glClientWaitSync = glClientWaitSync;
+    static Func1<void, GLsync>& _glDeleteSync = glDeleteSync;
+    static Func0<void>& _glFinish = glFinish;
     
     static Func1<void, GLuint>& _glEnableVertexAttribArray = glEnableVertexAttribArray;
     static Func1<void, GLuint>& _glDisableVertexAttribArray = glDisableVertexAttribArray;
@@ -84,6 +92,7 @@ namespace TrenchBroom {
     static Func1<void, GLenum>& _glClientActiveTexture = glClientActiveTexture;
     
     static Func6<void, GLuint, GLint, GLenum, GLboolean, GLsizei, const GLvoid*>& _glVertexAttribPointer = glVertexAttribPointer;
+    static Func2<void, GLuint, GLuint>& _glVertexAttribDivisor = glVertexAttribDivisor;
     static Func4<void, GLint, GLenum, GLsizei, const GLvoid*>& _glVertexPointer = glVertexPointer;
     static Func3<void, GLenum, GLsizei, const GLvoid*>& _glNormalPointer = glNormalPointer;
     static Func4<void, GLint, GLenum, GLsizei, const GLvoid*>& _glColorPointer = glColorPointer;
@@ -91,6 +100,7 @@ namespace TrenchBroom {
     
     static Func3<void, GLenum, GLint, GLsizei>& _glDrawArrays = glDrawArrays;
     static Func4<void, GLenum, const GLint*, const GLsizei*, GLsizei>& _glMultiDrawArrays = glMultiDrawArrays;
+    static Func4<void, GLenum, GLint, GLsizei, GLsizei>& _glDrawArraysInstanced = glDrawArraysInstanced;
     static Func4<void, GLenum, GLsizei, GLenum, const GLvoid*>& _glDrawElements = glDrawElements;
     static Func6<void, GLenum, GLuint, GLuint, GLsizei, GLenum, const GLvoid*>& _glDrawRangeElements = glDrawRangeElements;
     static Func5<void, GLenum, const GLsizei*, GLenum, const GLvoid**, GLsizei>& _glMultiDrawElements = glMultiDrawElements;
@@ -148,6 +158,7 @@ namespace TrenchBroom {
     static Func4<void, GLint, GLsizei, GLboolean, const GLfloat*>& _glUniformMatrix4x3fv = glUniformMatrix4x3fv;
     
     static Func2<GLint, GLuint, const GLchar*>& _glGetUniformLocation = glGetUniformLocation;
+    static Func2<GLint, GLuint, const GLchar*>& _glGetAttribLocation = glGetAttribLocation;
     
 #ifdef __APPLE__
     static Func2<void, GLenum, GLint>& _glFinishObjectAPPLE = glFinishObjectAPPLE;
@@ -155,8 +166,29 @@ namespace TrenchBroom {
 }
 
 #include <GL/glew.h>
+#if defined(_WIN32)
+#include <GL/wglew.h>
+#elif !defined(__APPLE__)
+#include <GL/glxew.h>
+#endif
 
 namespace TrenchBroom {
+    // The bundled glew does not know about GL_ARB_buffer_storage, so we must load the entry point ourselves.
+    typedef void (GLAPIENTRY * BufferStorageProc)(GLenum target, GLsizeiptr size, const GLvoid* data, GLbitfield flags);
+    
+    static BufferStorageProc getBufferStorageProc() {
+        if (!glewGetExtension("GL_ARB_buffer_storage"))
+            return nullptr;
+#if defined(_WIN32)
+        return reinterpret_cast<BufferStorageProc>(wglGetProcAddress("glBufferStorage"));
+#elif defined(__APPLE__)
+        // OS X does not support OpenGL 4.4
+        return nullptr;
+#else
+        return reinterpret_cast<BufferStorageProc>(glXGetProcAddressARB(reinterpret_cast<const GLubyte*>("glBufferStorage")));
+#endif
+    }
+    
     static void initRemainingFunctions() {
         _glGetError.bindFunc(&::glGetError);
         _glGetString.bindFunc(&::glGetString);
@@ -208,6 +240,19 @@ namespace TrenchBroom {
         _glBufferSubData.bindFunc(glBufferSubData);
         _glMapBuffer.bindFunc(glMapBuffer);
         _glUnmapBuffer.bindFunc(glUnmapBuffer);
+        _glMapBufferRange.bindFunc(glMapBufferRange);
+        
+        // glBufferStorage remains unbound if the extension is not available
+        BufferStorageProc bufferStorage = getBufferStorageProc();
+        if (bufferStorage != nullptr)
+            _glBufferStorage.bindFunc(bufferStorage);
+        else
+            _glBufferStorage.unbindFunc();
+        
+        _glFenceSync.bindFunc(glFenceSync);
+        _glClientWaitSync.bindFunc(glClientWaitSync);
+        _glDeleteSync.bindFunc(glDeleteSync);
+        _glFinish.bindFunc(&::glFinish);
         
         _glEnableVertexAttribArray.bindFunc(glEnableVertexAttribArray);
         _glDisableVertexAttribArray.bindFunc(glDisableVertexAttribArray);
@@ -216,6 +261,7 @@ namespace TrenchBroom {
         _glClientActiveTexture.bindFunc(glClientActiveTexture);
         
         _glVertexAttribPointer.bindFunc(glVertexAttribPointer);
+        _glVertexAttribDivisor.bindFunc(glVertexAttribDivisorARB);
         _glVertexPointer.bindFunc(&::glVertexPointer);
         _glNormalPointer.bindFunc(&::glNormalPointer);
         _glColorPointer.bindFunc(&::glColorPointer);
@@ -223,6 +269,7 @@ namespace TrenchBroom {
         
         _glDrawArrays.bindFunc(&::glDrawArrays);
         _glMultiDrawArrays.bindFunc(glMultiDrawArrays);
+        _glDrawArraysInstanced.bindFunc(glDrawArraysInstancedARB);
         _glDrawElements.bindFunc(&::glDrawElements);
         _glDrawRangeElements.bindFunc(glDrawRangeElements);
         _glMultiDrawElements.bindFunc(glMultiDrawElements);
@@ -280,6 +327,7 @@ namespace TrenchBroom {
         _glUniformMatrix4x3fv.bindFunc(glUniformMatrix4x3fv);
         
         _glGetUniformLocation.bindFunc(glGetUniformLocation);
+        _glGetAttribLocation.bindFunc(glGetAttribLocation);
         
 #ifdef __APPLE__
         _glFinishObjectAPPLE.bindFunc(glFinishObjectAPPLE);
@@ -297,6 +345,7 @@ namespace TrenchBroom {
 
         static bool initialized = false;
         if (!initialized) {
+            _glewIsSupported.bindFunc(&::glewIsSupported);
             initRemainingFunctions();
             initialized = true;
         }
@@ -110,6 +110,21 @@ namespace TrenchBroom {
             return model.transformedBounds(transformation);
         }
 
+        Vec3f::List Bsp29Model::doGetTriangles(const size_t frameIndex) const {
+            const SubModel& model = m_subModels.front();
+            
+            Vec3f::List result;
+            for (const Face& face : model.faces) {
+                const Face::VertexList& vertices = face.vertices();
+                for (size_t i = 2; i < vertices.size(); ++i) {
+                    result.push_back(vertices[0].v1);
+                    result.push_back(vertices[i - 1].v1);
+                    result.push_back(vertices[i].v1);
+                }
+            }
+            return result;
+        }
+
         void Bsp29Model::doPrepare(const int minFilter, const int magFilter) {
             m_textureCollection->prepare(minFilter, magFilter);
         }
@@ -157,6 +157,10 @@ namespace TrenchBroom {
         m_bounds(bounds),
         m_modelDefinition(modelDefinition) {}
         
+        EntityDefinition* PointEntityDefinition::clone() const {
+            return new PointEntityDefinition(name(), color(), m_bounds, description(), attributeDefinitions(), m_modelDefinition);
+        }
+        
         EntityDefinition::Type PointEntityDefinition::type() const {
             return Type_PointEntity;
         }
@@ -180,6 +184,10 @@ namespace TrenchBroom {
         BrushEntityDefinition::BrushEntityDefinition(const String& name, const Color& color, const String& description, const AttributeDefinitionList& attributeDefinitions) :
         EntityDefinition(name, color, description, attributeDefinitions) {}
         
+        EntityDefinition* BrushEntityDefinition::clone() const {
+            return new BrushEntityDefinition(name(), color(), description(), attributeDefinitions());
+        }
+        
         EntityDefinition::Type BrushEntityDefinition::type() const {
             return Type_BrushEntity;
         }
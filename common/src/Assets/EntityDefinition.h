@@ -58,6 +58,12 @@ namespace TrenchBroom {
         public:
             virtual ~EntityDefinition();
             
+            /**
+             * Returns a copy of this definition. The attribute definitions and the model definition are immutable and
+             * are therefore shared with the copy. The index and the usage count are not copied.
+             */
+            virtual EntityDefinition* clone() const = 0;
+            
             size_t index() const;
             void setIndex(size_t index);
             
@@ -91,6 +97,7 @@ namespace TrenchBroom {
         public:
             PointEntityDefinition(const String& name, const Color& color, const BBox3& bounds, const String& description, const AttributeDefinitionList& attributeDefinitions, const ModelDefinition& modelDefinition);
             
+            EntityDefinition* clone() const override;
             Type type() const override;
             const BBox3& bounds() const;
             ModelSpecification model(const Model::EntityAttributes& attributes) const;
@@ -101,6 +108,7 @@ namespace TrenchBroom {
         class BrushEntityDefinition : public EntityDefinition {
         public:
             BrushEntityDefinition(const String& name, const Color& color, const String& description, const AttributeDefinitionList& attributeDefinitions);
+            EntityDefinition* clone() const override;
             Type type() const override;
         };
     }
@@ -34,11 +34,13 @@ namespace TrenchBroom {
         }
 
         void EntityDefinitionManager::loadDefinitions(const IO::Path& path, const IO::EntityDefinitionLoader& loader, IO::ParserStatus& status) {
-            using std::swap;
-            
-            EntityDefinitionList newDefinitions = loader.loadEntityDefinitions(status, path);
-            std::swap(m_definitions, newDefinitions);
-            VectorUtils::clearAndDelete(newDefinitions);
+            setDefinitions(loader.loadEntityDefinitions(status, path));
+        }
+        
+        void EntityDefinitionManager::setDefinitions(const EntityDefinitionList& newDefinitions) {
+            EntityDefinitionList oldDefinitions = newDefinitions;
+            std::swap(m_definitions, oldDefinitions);
+            VectorUtils::clearAndDelete(oldDefinitions);
             
             updateIndices();
             updateGroups();
@@ -38,6 +38,10 @@ namespace TrenchBroom {
             return doGetTransformedBounds(skinIndex, frameIndex, transformation);
         }
 
+        Vec3f::List EntityModel::triangles(const size_t frameIndex) const {
+            return doGetTriangles(frameIndex);
+        }
+
         bool EntityModel::prepared() const {
             return m_prepared;
         }
@@ -39,6 +39,11 @@ namespace TrenchBroom {
             BBox3f bounds(const size_t skinIndex, const size_t frameIndex) const;
             BBox3f transformedBounds(const size_t skinIndex, const size_t frameIndex, const Mat4x4f& transformation) const;
             
+            /**
+             * Returns the triangles of the given frame as a list of vertex positions, three per triangle.
+             */
+            Vec3f::List triangles(const size_t frameIndex) const;
+            
             bool prepared() const;
             void prepare(int minFilter, int magFilter);
             void setTextureMode(int minFilter, int magFilter);
@@ -46,6 +51,7 @@ namespace TrenchBroom {
             virtual Renderer::TexturedIndexRangeRenderer* doBuildRenderer(const size_t skinIndex, const size_t frameIndex) const = 0;
             virtual BBox3f doGetBounds(const size_t skinIndex, const size_t frameIndex) const = 0;
             virtual BBox3f doGetTransformedBounds(const size_t skinIndex, const size_t frameIndex, const Mat4x4f& transformation) const = 0;
+            virtual Vec3f::List doGetTriangles(const size_t frameIndex) const = 0;
             virtual void doPrepare(int minFilter, int magFilter) = 0;
             virtual void doSetTextureMode(int minFilter, int magFilter) = 0;
         };
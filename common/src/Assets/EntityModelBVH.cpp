@@ -0,0 +1,171 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EntityModelBVH.h"
+
+#include "Assets/EntityModel.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace TrenchBroom {
+    namespace Assets {
+        EntityModelBVH::Node::Node(const BBox3f& i_bounds, const size_t i_index, const size_t i_count) :
+        bounds(i_bounds),
+        index(i_index),
+        count(i_count) {}
+        
+        bool EntityModelBVH::Node::leaf() const {
+            return count > 0;
+        }
+
+        EntityModelBVH::EntityModelBVH(const EntityModel* model, const size_t frameIndex) :
+        m_model(model),
+        m_frameIndex(frameIndex),
+        m_built(false) {
+            ensure(m_model != nullptr, "model is null");
+        }
+        
+        EntityModelBVH::EntityModelBVH(const Vec3f::List& triangles) :
+        m_model(nullptr),
+        m_frameIndex(0),
+        m_built(false) {
+            build(triangles);
+        }
+
+        size_t EntityModelBVH::triangleCount() const {
+            validate();
+            return m_vertices.size() / 3;
+        }
+        
+        size_t EntityModelBVH::nodeCount() const {
+            validate();
+            return m_nodes.size();
+        }
+
+        float EntityModelBVH::intersectWithRay(const Ray3f& ray) const {
+            validate();
+            
+            float closest = Math::nan<float>();
+            if (m_nodes.empty())
+                return closest;
+            
+            std::vector<size_t> stack;
+            stack.push_back(0);
+            
+            while (!stack.empty()) {
+                const size_t nodeIndex = stack.back();
+                stack.pop_back();
+                
+                const Node& node = m_nodes[nodeIndex];
+                
+                const float distance = node.bounds.contains(ray.origin) ? 0.0f : node.bounds.intersectWithRay(ray);
+                if (Math::isnan(distance) || (!Math::isnan(closest) && distance > closest))
+                    continue;
+                
+                if (node.leaf()) {
+                    for (size_t i = node.index; i < node.index + node.count; ++i) {
+                        const Vec3f& v0 = m_vertices[3 * i + 0];
+                        const Vec3f& v1 = m_vertices[3 * i + 1];
+                        const Vec3f& v2 = m_vertices[3 * i + 2];
+                        
+                        const float hit = intersectRayWithTriangle(ray, v0, v1, v2);
+                        if (!Math::isnan(hit) && (Math::isnan(closest) || hit < closest))
+                            closest = hit;
+                    }
+                } else {
+                    stack.push_back(node.index);
+                    stack.push_back(nodeIndex + 1);
+                }
+            }
+            
+            return closest;
+        }
+
+        void EntityModelBVH::validate() const {
+            if (!m_built) {
+                assert(m_model != nullptr);
+                build(m_model->triangles(m_frameIndex));
+            }
+        }
+
+        void EntityModelBVH::build(const Vec3f::List& triangles) const {
+            ensure(triangles.size() % 3 == 0, "vertex count must be a multiple of three");
+            
+            const size_t triangleCount = triangles.size() / 3;
+            
+            Vec3f::List centers;
+            centers.reserve(triangleCount);
+            for (size_t i = 0; i < triangleCount; ++i)
+                centers.push_back((triangles[3 * i + 0] + triangles[3 * i + 1] + triangles[3 * i + 2]) / 3.0f);
+            
+            std::vector<size_t> order(triangleCount);
+            std::iota(std::begin(order), std::end(order), 0);
+            
+            m_nodes.clear();
+            if (triangleCount > 0) {
+                m_nodes.reserve(2 * (triangleCount / MaxLeafSize + 1));
+                buildNode(order, centers, triangles, 0, triangleCount);
+            }
+            
+            m_vertices.clear();
+            m_vertices.reserve(triangles.size());
+            for (const size_t i : order) {
+                m_vertices.push_back(triangles[3 * i + 0]);
+                m_vertices.push_back(triangles[3 * i + 1]);
+                m_vertices.push_back(triangles[3 * i + 2]);
+            }
+            
+            m_built = true;
+        }
+
+        void EntityModelBVH::buildNode(std::vector<size_t>& order, const Vec3f::List& centers, const Vec3f::List& triangles, const size_t first, const size_t count) const {
+            const auto begin = std::next(std::begin(order), static_cast<long>(first));
+            const auto end = std::next(begin, static_cast<long>(count));
+            
+            BBox3f bounds(triangles[3 * *begin], triangles[3 * *begin]);
+            BBox3f centerBounds(centers[*begin], centers[*begin]);
+            for (auto it = begin; it != end; ++it) {
+                bounds.mergeWith(triangles[3 * *it + 0]);
+                bounds.mergeWith(triangles[3 * *it + 1]);
+                bounds.mergeWith(triangles[3 * *it + 2]);
+                centerBounds.mergeWith(centers[*it]);
+            }
+            
+            const size_t nodeIndex = m_nodes.size();
+            m_nodes.push_back(Node(bounds, first, count));
+            
+            if (count <= MaxLeafSize)
+                return;
+            
+            // split at the median of the triangle centers along the longest axis of their bounds
+            const size_t axis = centerBounds.size().firstComponent();
+            const size_t leftCount = count / 2;
+            const auto mid = std::next(begin, static_cast<long>(leftCount));
+            std::nth_element(begin, mid, end, [&centers, axis](const size_t lhs, const size_t rhs) {
+                return centers[lhs][axis] < centers[rhs][axis];
+            });
+            
+            m_nodes[nodeIndex].count = 0;
+            buildNode(order, centers, triangles, first, leftCount);
+            m_nodes[nodeIndex].index = m_nodes.size();
+            buildNode(order, centers, triangles, first + leftCount, count - leftCount);
+        }
+    }
+}
@@ -0,0 +1,90 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_EntityModelBVH
+#define TrenchBroom_EntityModelBVH
+
+#include "VecMath.h"
+#include "Macros.h"
+
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Assets {
+        class EntityModel;
+        
+        /**
+         * A bounding volume hierarchy over the triangles of one frame of an entity model. The hierarchy is stored
+         * as a flat array of nodes in depth first order, and the triangles are reordered so that every leaf refers
+         * to a contiguous run of them.
+         *
+         * If the hierarchy is created for a model frame, the triangles are only fetched from the model and the
+         * hierarchy is only built when it is first queried.
+         */
+        class EntityModelBVH {
+        private:
+            static const size_t MaxLeafSize = 4;
+            
+            /**
+             * A leaf refers to the triangles [index, index + count). An inner node has a count of zero; its left
+             * child immediately follows it, and its right child is found at index.
+             */
+            struct Node {
+                BBox3f bounds;
+                size_t index;
+                size_t count;
+                
+                Node(const BBox3f& i_bounds, size_t i_index, size_t i_count);
+                bool leaf() const;
+            };
+            typedef std::vector<Node> NodeList;
+            
+            const EntityModel* m_model;
+            size_t m_frameIndex;
+            
+            mutable bool m_built;
+            mutable Vec3f::List m_vertices;
+            mutable NodeList m_nodes;
+        public:
+            EntityModelBVH(const EntityModel* model, size_t frameIndex);
+            
+            /**
+             * Creates a hierarchy over the given triangles, each of which is given by three consecutive vertices.
+             */
+            explicit EntityModelBVH(const Vec3f::List& triangles);
+            
+            size_t triangleCount() const;
+            size_t nodeCount() const;
+            
+            /**
+             * Returns the distance along the given ray to the closest triangle hit by it, or NaN if the ray does not
+             * hit any triangle.
+             */
+            float intersectWithRay(const Ray3f& ray) const;
+        private:
+            void validate() const;
+            void build(const Vec3f::List& triangles) const;
+            void buildNode(std::vector<size_t>& order, const Vec3f::List& centers, const Vec3f::List& triangles, size_t first, size_t count) const;
+            
+            deleteCopyAndAssignment(EntityModelBVH)
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_EntityModelBVH) */
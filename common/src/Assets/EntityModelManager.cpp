@@ -22,7 +22,9 @@
 #include "CollectionUtils.h"
 #include "Exceptions.h"
 #include "Logger.h"
+#include "ThreadPool.h"
 #include "Assets/EntityModel.h"
+#include "Assets/EntityModelBVH.h"
 #include "IO/EntityModelLoader.h"
 #include "Model/Entity.h"
 #include "Renderer/TexturedIndexRangeRenderer.h"
@@ -34,13 +36,17 @@ namespace TrenchBroom {
         m_loader(nullptr),
         m_minFilter(minFilter),
         m_magFilter(magFilter),
-        m_resetTextureMode(false) {}
+        m_resetTextureMode(false),
+        m_loaderPool(new ThreadPool()) {}
         
         EntityModelManager::~EntityModelManager() {
             clear();
         }
         
         void EntityModelManager::clear() {
+            cancelPendingModels();
+            
+            MapUtils::clearAndDelete(m_bvhs);
             MapUtils::clearAndDelete(m_renderers);
             MapUtils::clearAndDelete(m_models);
             m_rendererMismatches.clear();
@@ -63,6 +69,10 @@ namespace TrenchBroom {
             m_loader = loader;
         }
 
+        void EntityModelManager::setLoadCallback(LoadCallback loadCallback) {
+            m_loadCallback = loadCallback;
+        }
+
         EntityModel* EntityModelManager::model(const IO::Path& path) const {
             if (path.isEmpty())
                 return nullptr;
@@ -74,6 +84,16 @@ namespace TrenchBroom {
             if (m_modelMismatches.count(path) > 0)
                 return nullptr;
             
+            // If the model is already being loaded in the background, wait for it instead of loading it twice.
+            PendingModels::iterator pIt = m_pendingModels.find(path);
+            if (pIt != std::end(m_pendingModels)) {
+                EntityModel* model = commitLoadedModel(path, pIt->second);
+                m_pendingModels.erase(pIt);
+                if (model == nullptr)
+                    throw GameException("Cannot load model " + path.asString());
+                return model;
+            }
+            
             try {
                 EntityModel* model = loadModel(path);
                 ensure(model != nullptr, "model is null");
@@ -127,18 +147,129 @@ namespace TrenchBroom {
             return renderer;
         }
         
+        Renderer::TexturedIndexRangeRenderer* EntityModelManager::rendererIfLoaded(const Assets::ModelSpecification& spec) const {
+            if (spec.path.isEmpty() || m_models.count(spec.path) == 0)
+                return nullptr;
+            return renderer(spec);
+        }
+
+        const EntityModelBVH* EntityModelManager::bvhIfLoaded(const Assets::ModelSpecification& spec) const {
+            if (spec.path.isEmpty())
+                return nullptr;
+            
+            const BVHKey key(spec.path, spec.frameIndex);
+            BVHCache::const_iterator it = m_bvhs.find(key);
+            if (it != std::end(m_bvhs))
+                return it->second;
+            
+            ModelCache::const_iterator modelIt = m_models.find(spec.path);
+            if (modelIt == std::end(m_models) || modelIt->second == nullptr)
+                return nullptr;
+            
+            EntityModelBVH* bvh = new EntityModelBVH(modelIt->second, spec.frameIndex);
+            m_bvhs.insert(std::make_pair(key, bvh));
+            return bvh;
+        }
+
         bool EntityModelManager::hasModel(const Model::Entity* entity) const {
             return hasModel(entity->modelSpecification());
         }
         
         bool EntityModelManager::hasModel(const Assets::ModelSpecification& spec) const {
-            return renderer(spec) != nullptr;
+            return rendererIfLoaded(spec) != nullptr;
+        }
+
+        void EntityModelManager::requestModel(const IO::Path& path) {
+            if (!path.isEmpty() && m_models.count(path) == 0 && m_modelMismatches.count(path) == 0)
+                loadModelAsync(path);
+        }
+
+        bool EntityModelManager::hasPendingModels() const {
+            return !m_pendingModels.empty();
+        }
+        
+        bool EntityModelManager::hasLoadedModels() const {
+            for (const auto& entry : m_pendingModels) {
+                const std::future<EntityModel*>& future = entry.second;
+                if (future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                    return true;
+            }
+            return false;
+        }
+
+        void EntityModelManager::commitLoadedModels() {
+            bool committed = false;
+            
+            PendingModels::iterator it = std::begin(m_pendingModels);
+            while (it != std::end(m_pendingModels)) {
+                std::future<EntityModel*>& future = it->second;
+                if (future.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+                    commitLoadedModel(it->first, future);
+                    it = m_pendingModels.erase(it);
+                    committed = true;
+                } else {
+                    ++it;
+                }
+            }
+            
+            if (committed)
+                modelsWereLoadedNotifier();
         }
 
         EntityModel* EntityModelManager::loadModel(const IO::Path& path) const {
             ensure(m_loader != nullptr, "loader is null");
             return m_loader->loadEntityModel(path);
         }
+        
+        void EntityModelManager::loadModelAsync(const IO::Path& path) const {
+            if (m_loader == nullptr || m_pendingModels.count(path) > 0)
+                return;
+            
+            const IO::EntityModelLoader* loader = m_loader;
+            const LoadCallback callback = m_loadCallback;
+            m_pendingModels[path] = m_loaderPool->submit([loader, callback, path]() {
+                struct NotifyOnExit {
+                    const LoadCallback& callback;
+                    ~NotifyOnExit() {
+                        if (callback)
+                            callback();
+                    }
+                } notifyOnExit = { callback };
+                
+                return loader->loadEntityModel(path);
+            });
+        }
+        
+        EntityModel* EntityModelManager::commitLoadedModel(const IO::Path& path, std::future<EntityModel*>& future) const {
+            try {
+                EntityModel* model = future.get();
+                ensure(model != nullptr, "model is null");
+                m_models[path] = model;
+                m_unpreparedModels.push_back(model);
+                
+                if (m_logger != nullptr)
+                    m_logger->debug("Loaded entity model %s", path.asString().c_str());
+                return model;
+            } catch (const std::exception& e) {
+                m_modelMismatches.insert(path);
+                
+                if (m_logger != nullptr)
+                    m_logger->error("Failed to load entity model %s: %s", path.asString().c_str(), e.what());
+                return nullptr;
+            }
+        }
+        
+        void EntityModelManager::cancelPendingModels() {
+            // The loader may be destroyed after this, so wait for all running loads and discard their results. This
+            // is called from the destructor, so nothing that a load throws may escape.
+            for (auto& entry : m_pendingModels) {
+                std::future<EntityModel*>& future = entry.second;
+                try {
+                    delete future.get();
+                } catch (...) {}
+            }
+            m_pendingModels.clear();
+        }
 
         void EntityModelManager::prepare(Renderer::Vbo& vbo) {
             resetTextureMode();
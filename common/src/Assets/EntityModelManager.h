@@ -20,16 +20,23 @@
 #ifndef TrenchBroom_EntityModelManager
 #define TrenchBroom_EntityModelManager
 
+#include "Notifier.h"
 #include "Assets/ModelDefinition.h"
 #include "IO/Path.h"
 #include "Model/ModelTypes.h"
 
+#include <functional>
+#include <future>
 #include <map>
+#include <memory>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace TrenchBroom {
     class Logger;
+    class ThreadPool;
     
     namespace IO {
         class EntityModelLoader;
@@ -42,17 +49,24 @@ namespace TrenchBroom {
     
     namespace Assets {
         class EntityModel;
+        class EntityModelBVH;
         
         class EntityModelManager {
+        public:
+            typedef std::function<void()> LoadCallback;
         private:
-            typedef std::map<IO::Path, EntityModel*> ModelCache;
-            typedef std::set<IO::Path> ModelMismatches;
+            typedef std::unordered_map<IO::Path, EntityModel*, IO::Path::Hash> ModelCache;
+            typedef std::unordered_set<IO::Path, IO::Path::Hash> ModelMismatches;
             typedef std::vector<EntityModel*> ModelList;
+            typedef std::unordered_map<IO::Path, std::future<EntityModel*>, IO::Path::Hash> PendingModels;
             
             typedef std::map<Assets::ModelSpecification, Renderer::TexturedIndexRangeRenderer*> RendererCache;
             typedef std::set<Assets::ModelSpecification> RendererMismatches;
             typedef std::vector<Renderer::TexturedIndexRangeRenderer*> RendererList;
             
+            typedef std::pair<IO::Path, size_t> BVHKey;
+            typedef std::map<BVHKey, EntityModelBVH*> BVHCache;
+            
             Logger* m_logger;
             const IO::EntityModelLoader* m_loader;
 
@@ -64,9 +78,20 @@ namespace TrenchBroom {
             mutable ModelMismatches m_modelMismatches;
             mutable RendererCache m_renderers;
             mutable RendererMismatches m_rendererMismatches;
+            mutable BVHCache m_bvhs;
 
             mutable ModelList m_unpreparedModels;
             mutable RendererList m_unpreparedRenderers;
+            
+            std::unique_ptr<ThreadPool> m_loaderPool;
+            mutable PendingModels m_pendingModels;
+            LoadCallback m_loadCallback;
+        public:
+            /**
+             * Notifies observers that models which were loaded in the background have been added to this manager. Only
+             * ever called from commitLoadedModels, i.e., from the thread that owns this manager.
+             */
+            Notifier0 modelsWereLoadedNotifier;
         public:
             EntityModelManager(Logger* logger, int minFilter, int magFilter);
             ~EntityModelManager();
@@ -76,14 +101,60 @@ namespace TrenchBroom {
             void setTextureMode(int minFilter, int magFilter);
             void setLoader(const IO::EntityModelLoader* loader);
             
+            /**
+             * Sets a callback that is invoked on a worker thread whenever a background model load finishes. The
+             * callback must be thread safe; its only purpose is to wake up the UI thread so that it calls
+             * commitLoadedModels.
+             */
+            void setLoadCallback(LoadCallback loadCallback);
+            
             EntityModel* model(const IO::Path& path) const;
             EntityModel* safeGetModel(const IO::Path& path) const;
             Renderer::TexturedIndexRangeRenderer* renderer(const Assets::ModelSpecification& spec) const;
             
+            /**
+             * Returns the renderer for the given model specification if its model has already been loaded, and null
+             * otherwise. Does not load the model; callers should request it with requestModel, render a placeholder
+             * and update themselves when modelsWereLoadedNotifier fires.
+             */
+            Renderer::TexturedIndexRangeRenderer* rendererIfLoaded(const Assets::ModelSpecification& spec) const;
+            
+            /**
+             * Returns the bounding volume hierarchy for the model frame given by the specification if its model has
+             * already been loaded, and null otherwise. The hierarchy is shared by all callers and only built when it
+             * is first queried. It is valid until this manager is cleared.
+             */
+            const EntityModelBVH* bvhIfLoaded(const Assets::ModelSpecification& spec) const;
+            
             bool hasModel(const Model::Entity* entity) const;
             bool hasModel(const Assets::ModelSpecification& spec) const;
+            
+            /**
+             * Schedules the model at the given path to be loaded in the background unless it has already been loaded,
+             * is being loaded, or has failed to load.
+             */
+            void requestModel(const IO::Path& path);
+            
+            /**
+             * Indicates whether there are any models being loaded in the background or waiting to be committed.
+             */
+            bool hasPendingModels() const;
+            
+            /**
+             * Indicates whether any background model loads have finished, but have not been committed yet.
+             */
+            bool hasLoadedModels() const;
+            
+            /**
+             * Adds all models that have finished loading in the background to this manager and notifies the observers
+             * if any models were added.
+             */
+            void commitLoadedModels();
         private:
             EntityModel* loadModel(const IO::Path& path) const;
+            void loadModelAsync(const IO::Path& path) const;
+            EntityModel* commitLoadedModel(const IO::Path& path, std::future<EntityModel*>& future) const;
+            void cancelPendingModels();
         public:
             void prepare(Renderer::Vbo& vbo);
         private:
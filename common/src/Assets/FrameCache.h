@@ -0,0 +1,99 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_FrameCache
+#define TrenchBroom_FrameCache
+
+#include "Ensure.h"
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <utility>
+
+namespace TrenchBroom {
+    namespace Assets {
+        /**
+         * Holds a small number of decoded entity model frames. Frames are decoded on demand using the given loader
+         * function, and the least recently used frame is evicted once the cache is full.
+         *
+         * Frames are handed out as shared pointers so that an evicted frame stays valid for as long as a caller still
+         * holds on to it.
+         */
+        template <typename F>
+        class FrameCache {
+        public:
+            typedef std::shared_ptr<const F> FramePtr;
+            typedef std::function<F*(size_t)> Loader;
+            
+            static const size_t DefaultCapacity = 4;
+        private:
+            typedef std::pair<size_t, FramePtr> Entry;
+            typedef std::list<Entry> EntryList;
+            
+            Loader m_loader;
+            size_t m_capacity;
+            mutable EntryList m_entries;
+        public:
+            FrameCache(Loader loader, const size_t capacity = DefaultCapacity) :
+            m_loader(loader),
+            m_capacity(capacity) {
+                ensure(m_capacity > 0, "capacity must be positive");
+            }
+            
+            /**
+             * Returns the frame with the given index, decoding it if it is not cached.
+             */
+            FramePtr frame(const size_t index) const {
+                FramePtr result = cachedFrame(index);
+                if (result != nullptr)
+                    return result;
+                
+                result = FramePtr(m_loader(index));
+                m_entries.push_front(std::make_pair(index, result));
+                if (m_entries.size() > m_capacity)
+                    m_entries.pop_back();
+                return result;
+            }
+            
+            /**
+             * Returns the frame with the given index if it is cached, and null otherwise. Never decodes a frame.
+             */
+            FramePtr cachedFrame(const size_t index) const {
+                for (auto it = std::begin(m_entries), end = std::end(m_entries); it != end; ++it) {
+                    if (it->first == index) {
+                        m_entries.splice(std::begin(m_entries), m_entries, it);
+                        return m_entries.front().second;
+                    }
+                }
+                return FramePtr();
+            }
+            
+            size_t size() const {
+                return m_entries.size();
+            }
+            
+            void clear() {
+                m_entries.clear();
+            }
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_FrameCache) */
@@ -60,30 +60,59 @@ namespace TrenchBroom {
             return m_bounds;
         }
 
-        Md2Model::Md2Model(const String& name, const TextureList& skins, const FrameList& frames) :
+        Md2Model::FrameSource::~FrameSource() {}
+        
+        size_t Md2Model::FrameSource::frameCount() const {
+            return doGetFrameCount();
+        }
+        
+        Md2Model::Frame* Md2Model::FrameSource::loadFrame(const size_t index) const {
+            ensure(index < frameCount(), "frame index out of range");
+            return doLoadFrame(index);
+        }
+        
+        BBox3f Md2Model::FrameSource::bounds(const size_t index) const {
+            ensure(index < frameCount(), "frame index out of range");
+            return doGetBounds(index);
+        }
+        
+        BBox3f Md2Model::FrameSource::transformedBounds(const size_t index, const Mat4x4f& transformation) const {
+            ensure(index < frameCount(), "frame index out of range");
+            return doGetTransformedBounds(index, transformation);
+        }
+
+        Md2Model::Md2Model(const String& name, const TextureList& skins, FrameSource* frameSource) :
         m_name(name),
         m_skins(new TextureCollection(IO::Path(name), skins)),
-        m_frames(frames) {}
+        m_frameSource(frameSource),
+        m_frames([frameSource](const size_t index) { return frameSource->loadFrame(index); }) {
+            ensure(m_frameSource != nullptr, "frame source is null");
+        }
         
         Md2Model::~Md2Model() {
-            VectorUtils::clearAndDelete(m_frames);
+            m_frames.clear();
             delete m_skins;
             m_skins = nullptr;
         }
 
+        size_t Md2Model::frameCount() const {
+            return m_frameSource->frameCount();
+        }
+
         Renderer::TexturedIndexRangeRenderer* Md2Model::doBuildRenderer(const size_t skinIndex, const size_t frameIndex) const {
             const TextureList& textures = m_skins->textures();
             
             ensure(skinIndex < textures.size(), "skin index out of range");
-            ensure(frameIndex < m_frames.size(), "frame index out of range");
+            ensure(frameIndex < frameCount(), "frame index out of range");
 
             const Assets::Texture* skin = textures[skinIndex];
-            const Frame* frame = m_frames[frameIndex];
+            const FrameCache<Frame>::FramePtr frame = m_frames.frame(frameIndex);
             
             const VertexList& vertices = frame->vertices();
             const Renderer::IndexRangeMap& indices = frame->indices();
             
-            const Renderer::VertexArray vertexArray = Renderer::VertexArray::ref(vertices);
+            // The frame may be evicted from the cache, so the renderer must own its vertices.
+            const Renderer::VertexArray vertexArray = Renderer::VertexArray::copy(vertices);
             const Renderer::TexturedIndexRangeMap texturedIndices(skin, indices);
             
             return new Renderer::TexturedIndexRangeRenderer(vertexArray, texturedIndices);
@@ -91,18 +120,58 @@ namespace TrenchBroom {
         
         BBox3f Md2Model::doGetBounds(const size_t skinIndex, const size_t frameIndex) const {
             ensure(skinIndex < m_skins->textures().size(), "skin index out of range");
-            ensure(frameIndex < m_frames.size(), "frame index out of range");
+            ensure(frameIndex < frameCount(), "frame index out of range");
             
-            const Frame* frame = m_frames[frameIndex];
-            return frame->bounds();
+            const FrameCache<Frame>::FramePtr frame = m_frames.cachedFrame(frameIndex);
+            if (frame != nullptr)
+                return frame->bounds();
+            return m_frameSource->bounds(frameIndex);
         }
         
         BBox3f Md2Model::doGetTransformedBounds(const size_t skinIndex, const size_t frameIndex, const Mat4x4f& transformation) const {
             ensure(skinIndex < m_skins->textures().size(), "skin index out of range");
-            ensure(frameIndex < m_frames.size(), "frame index out of range");
+            ensure(frameIndex < frameCount(), "frame index out of range");
+            
+            const FrameCache<Frame>::FramePtr frame = m_frames.cachedFrame(frameIndex);
+            if (frame != nullptr)
+                return frame->transformedBounds(transformation);
+            return m_frameSource->transformedBounds(frameIndex, transformation);
+        }
+
+        Vec3f::List Md2Model::doGetTriangles(const size_t frameIndex) const {
+            Vec3f::List result;
+            if (frameIndex >= frameCount())
+                return result;
+            
+            const FrameCache<Frame>::FramePtr frame = m_frames.frame(frameIndex);
+            const VertexList& vertices = frame->vertices();
             
-            const Frame* frame = m_frames[frameIndex];
-            return frame->transformedBounds(transformation);
+            frame->indices().forEachRange([&vertices, &result](const PrimType primType, const size_t index, const size_t count) {
+                for (size_t i = 2; i < count; ++i) {
+                    switch (primType) {
+                        case GL_TRIANGLE_FAN:
+                            result.push_back(vertices[index].v1);
+                            result.push_back(vertices[index + i - 1].v1);
+                            result.push_back(vertices[index + i].v1);
+                            break;
+                        case GL_TRIANGLE_STRIP:
+                            result.push_back(vertices[index + i - 2].v1);
+                            result.push_back(vertices[index + i - 1].v1);
+                            result.push_back(vertices[index + i].v1);
+                            break;
+                        case GL_TRIANGLES:
+                            if (i % 3 == 2) {
+                                result.push_back(vertices[index + i - 2].v1);
+                                result.push_back(vertices[index + i - 1].v1);
+                                result.push_back(vertices[index + i].v1);
+                            }
+                            break;
+                        default:
+                            break;
+                    }
+                }
+            });
+            return result;
         }
 
         void Md2Model::doPrepare(const int minFilter, const int magFilter) {
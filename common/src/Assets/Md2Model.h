@@ -22,11 +22,13 @@
 
 #include "Assets/AssetTypes.h"
 #include "Assets/EntityModel.h"
+#include "Assets/FrameCache.h"
 #include "StringUtils.h"
 #include "VecMath.h"
 #include "Renderer/VertexSpec.h"
 #include "Renderer/IndexRangeMap.h"
 
+#include <memory>
 #include <vector>
 
 namespace TrenchBroom {
@@ -53,18 +55,39 @@ namespace TrenchBroom {
                 const BBox3f& bounds() const;
             };
 
-            typedef std::vector<Frame*> FrameList;
+            /**
+             * Decodes the frames of a model on demand. Implementations keep the raw model data around and must be
+             * able to compute the bounds of a frame without decoding it.
+             */
+            class FrameSource {
+            public:
+                virtual ~FrameSource();
+                
+                size_t frameCount() const;
+                Frame* loadFrame(size_t index) const;
+                BBox3f bounds(size_t index) const;
+                BBox3f transformedBounds(size_t index, const Mat4x4f& transformation) const;
+            private:
+                virtual size_t doGetFrameCount() const = 0;
+                virtual Frame* doLoadFrame(size_t index) const = 0;
+                virtual BBox3f doGetBounds(size_t index) const = 0;
+                virtual BBox3f doGetTransformedBounds(size_t index, const Mat4x4f& transformation) const = 0;
+            };
         private:
             String m_name;
             TextureCollection* m_skins;
-            FrameList m_frames;
+            std::unique_ptr<FrameSource> m_frameSource;
+            FrameCache<Frame> m_frames;
         public:
-            Md2Model(const String& name, const TextureList& skins, const FrameList& frames);
+            Md2Model(const String& name, const TextureList& skins, FrameSource* frameSource);
             ~Md2Model() override;
+            
+            size_t frameCount() const;
         private:
             Renderer::TexturedIndexRangeRenderer* doBuildRenderer(const size_t skinIndex, const size_t frameIndex) const override;
             BBox3f doGetBounds(const size_t skinIndex, const size_t frameIndex) const override;
             BBox3f doGetTransformedBounds(const size_t skinIndex, const size_t frameIndex, const Mat4x4f& transformation) const override;
+            Vec3f::List doGetTriangles(const size_t frameIndex) const override;
             void doPrepare(int minFilter, int magFilter) override;
             void doSetTextureMode(int minFilter, int magFilter) override;
         };
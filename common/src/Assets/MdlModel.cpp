@@ -53,17 +53,11 @@ namespace TrenchBroom {
             return m_textures.textures().front();
         }
 
-        MdlBaseFrame::~MdlBaseFrame() {}
-
         MdlFrame::MdlFrame(const String& name, const VertexList& triangles, const BBox3f& bounds) :
         m_name(name),
         m_triangles(triangles),
         m_bounds(bounds) {}
         
-        const MdlFrame* MdlFrame::firstFrame() const {
-            return this;
-        }
-
         const MdlFrame::VertexList& MdlFrame::triangles() const {
             return m_triangles;
         }
@@ -91,68 +85,102 @@ namespace TrenchBroom {
             return bounds;
         }
 
-        MdlFrameGroup::~MdlFrameGroup() {
-            VectorUtils::clearAndDelete(m_frames);
+        MdlModel::FrameSource::~FrameSource() {}
+        
+        size_t MdlModel::FrameSource::frameCount() const {
+            return doGetFrameCount();
         }
         
-        const MdlFrame* MdlFrameGroup::firstFrame() const {
-            if (m_frames.empty())
-                return nullptr;
-            return m_frames[0]->firstFrame();
+        MdlFrame* MdlModel::FrameSource::loadFrame(const size_t index) const {
+            ensure(index < frameCount(), "frame index out of range");
+            return doLoadFrame(index);
+        }
+        
+        BBox3f MdlModel::FrameSource::bounds(const size_t index) const {
+            ensure(index < frameCount(), "frame index out of range");
+            return doGetBounds(index);
         }
         
-        void MdlFrameGroup::addFrame(MdlFrame* frame, const float time) {
-            m_frames.push_back(frame);
-            m_times.push_back(time);
+        BBox3f MdlModel::FrameSource::transformedBounds(const size_t index, const Mat4x4f& transformation) const {
+            ensure(index < frameCount(), "frame index out of range");
+            return doGetTransformedBounds(index, transformation);
         }
 
-        MdlModel::MdlModel(const String& name) :
-        m_name(name) {}
+        MdlModel::MdlModel(const String& name, FrameSource* frameSource) :
+        m_name(name),
+        m_frameSource(frameSource),
+        m_frames([frameSource](const size_t index) { return frameSource->loadFrame(index); }) {
+            ensure(m_frameSource != nullptr, "frame source is null");
+        }
 
         MdlModel::~MdlModel() {
+            m_frames.clear();
             VectorUtils::clearAndDelete(m_skins);
-            VectorUtils::clearAndDelete(m_frames);
         }
 
         void MdlModel::addSkin(MdlSkin* skin) {
             m_skins.push_back(skin);
         }
 
-        void MdlModel::addFrame(MdlBaseFrame* frame) {
-            m_frames.push_back(frame);
+        size_t MdlModel::frameCount() const {
+            return m_frameSource->frameCount();
+        }
+
+        size_t MdlModel::decodedFrameCount() const {
+            return m_frames.size();
         }
 
         Renderer::TexturedIndexRangeRenderer* MdlModel::doBuildRenderer(const size_t skinIndex, const size_t frameIndex) const {
             if (skinIndex >= m_skins.size())
                 return nullptr;
-            if (frameIndex >= m_frames.size())
+            if (frameIndex >= frameCount())
                 return nullptr;
             
             const MdlSkin* skin = m_skins[skinIndex];
-            const MdlFrame* frame = m_frames[frameIndex]->firstFrame();
+            const FrameCache<MdlFrame>::FramePtr frame = m_frames.frame(frameIndex);
 
             const Assets::Texture* texture = skin->firstPicture();
             const MdlFrame::VertexList& vertices = frame->triangles();
             const size_t vertexCount = vertices.size();
             
-            const Renderer::VertexArray vertexArray = Renderer::VertexArray::ref(vertices);
+            // The frame may be evicted from the cache, so the renderer must own its vertices.
+            const Renderer::VertexArray vertexArray = Renderer::VertexArray::copy(vertices);
             const Renderer::TexturedIndexRangeMap indexArray(texture, GL_TRIANGLES, 0, vertexCount);
             
             return new Renderer::TexturedIndexRangeRenderer(vertexArray, indexArray);
         }
 
         BBox3f MdlModel::doGetBounds(const size_t skinIndex, const size_t frameIndex) const {
-            if (frameIndex >= m_frames.size())
+            if (frameIndex >= frameCount())
                 return BBox3f(-8.0f, 8.0f);
-            const MdlFrame* frame = m_frames[frameIndex]->firstFrame();
-            return frame->bounds();
+            
+            const FrameCache<MdlFrame>::FramePtr frame = m_frames.cachedFrame(frameIndex);
+            if (frame != nullptr)
+                return frame->bounds();
+            return m_frameSource->bounds(frameIndex);
         }
 
         BBox3f MdlModel::doGetTransformedBounds(const size_t skinIndex, const size_t frameIndex, const Mat4x4f& transformation) const {
-            if (frameIndex >= m_frames.size())
+            if (frameIndex >= frameCount())
                 return BBox3f(-8.0f, 8.0f);
-            const MdlFrame* frame = m_frames[frameIndex]->firstFrame();
-            return frame->transformedBounds(transformation);
+            
+            const FrameCache<MdlFrame>::FramePtr frame = m_frames.cachedFrame(frameIndex);
+            if (frame != nullptr)
+                return frame->transformedBounds(transformation);
+            return m_frameSource->transformedBounds(frameIndex, transformation);
+        }
+
+        Vec3f::List MdlModel::doGetTriangles(const size_t frameIndex) const {
+            Vec3f::List result;
+            if (frameIndex < frameCount()) {
+                const FrameCache<MdlFrame>::FramePtr frame = m_frames.frame(frameIndex);
+                const MdlFrame::VertexList& vertices = frame->triangles();
+                
+                result.reserve(vertices.size());
+                for (const MdlFrame::Vertex& vertex : vertices)
+                    result.push_back(vertex.v1);
+            }
+            return result;
         }
 
         
@@ -24,11 +24,13 @@
 #include "StringUtils.h"
 #include "Assets/AssetTypes.h"
 #include "Assets/EntityModel.h"
+#include "Assets/FrameCache.h"
 #include "Assets/TextureCollection.h"
 #include "Renderer/VertexSpec.h"
 #include "Renderer/Vertex.h"
 #include "Renderer/IndexRangeMap.h"
 
+#include <memory>
 #include <vector>
 
 namespace TrenchBroom {
@@ -48,15 +50,7 @@ namespace TrenchBroom {
             const Texture* firstPicture() const;
         };
 
-        class MdlFrame;
-        
-        class MdlBaseFrame {
-        public:
-            virtual ~MdlBaseFrame();
-            virtual const MdlFrame* firstFrame() const = 0;
-        };
-        
-        class MdlFrame : public MdlBaseFrame {
+        class MdlFrame {
         public:
             typedef Renderer::VertexSpecs::P3T2::Vertex Vertex;
             typedef Vertex::List VertexList;
@@ -66,42 +60,54 @@ namespace TrenchBroom {
             BBox3f m_bounds;
         public:
             MdlFrame(const String& name, const VertexList& triangles, const BBox3f& bounds);
-            const MdlFrame* firstFrame() const override;
             const VertexList& triangles() const;
             BBox3f bounds() const;
             BBox3f transformedBounds(const Mat4x4f& transformation) const;
         };
         
-        class MdlFrameGroup : public MdlBaseFrame {
-        private:
-            typedef std::vector<MdlFrame*> SingleFrameList;
-            
-            MdlTimeList m_times;
-            SingleFrameList m_frames;
-        public:
-            ~MdlFrameGroup() override;
-            const MdlFrame* firstFrame() const override;
-            void addFrame(MdlFrame* frame, const float time);
-        };
-        
         class MdlModel : public EntityModel {
+        public:
+            /**
+             * Decodes the frames of a model on demand. For frame groups, only the first frame of the group is ever
+             * decoded. Implementations must be able to compute the bounds of a frame without decoding it.
+             */
+            class FrameSource {
+            public:
+                virtual ~FrameSource();
+                
+                size_t frameCount() const;
+                MdlFrame* loadFrame(size_t index) const;
+                BBox3f bounds(size_t index) const;
+                BBox3f transformedBounds(size_t index, const Mat4x4f& transformation) const;
+            private:
+                virtual size_t doGetFrameCount() const = 0;
+                virtual MdlFrame* doLoadFrame(size_t index) const = 0;
+                virtual BBox3f doGetBounds(size_t index) const = 0;
+                virtual BBox3f doGetTransformedBounds(size_t index, const Mat4x4f& transformation) const = 0;
+            };
         private:
             typedef std::vector<MdlSkin*> MdlSkinList;
-            typedef std::vector<MdlBaseFrame*> MdlFrameList;
             
             String m_name;
             MdlSkinList m_skins;
-            MdlFrameList m_frames;
+            std::unique_ptr<FrameSource> m_frameSource;
+            FrameCache<MdlFrame> m_frames;
         public:
-            explicit MdlModel(const String& name);
+            MdlModel(const String& name, FrameSource* frameSource);
             ~MdlModel() override;
             
             void addSkin(MdlSkin* skin);
-            void addFrame(MdlBaseFrame* frame);
+            size_t frameCount() const;
+            
+            /**
+             * Returns the number of frames that are currently decoded and held in the frame cache.
+             */
+            size_t decodedFrameCount() const;
         private:
             Renderer::TexturedIndexRangeRenderer* doBuildRenderer(const size_t skinIndex, const size_t frameIndex) const override;
             BBox3f doGetBounds(const size_t skinIndex, const size_t frameIndex) const override;
             BBox3f doGetTransformedBounds(const size_t skinIndex, const size_t frameIndex, const Mat4x4f& transformation) const override;
+            Vec3f::List doGetTriangles(const size_t frameIndex) const override;
             void doPrepare(int minFilter, int magFilter) override;
             void doSetTextureMode(int minFilter, int magFilter) override;
         };
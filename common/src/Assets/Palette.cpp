@@ -21,7 +21,6 @@
 
 #include "Exceptions.h"
 #include "StringUtils.h"
-#include "IO/CharArrayReader.h"
 #include "IO/FileSystem.h"
 
 #include <algorithm>
@@ -30,6 +29,9 @@
 
 namespace TrenchBroom {
     namespace Assets {
+        // 256 RGB colors
+        static const size_t PaletteSize = 768;
+        
         Palette::Data::Data(const size_t size, unsigned char* data) :
         m_size(size),
         m_data(data) {
@@ -37,12 +39,25 @@ namespace TrenchBroom {
             ensure(m_data != nullptr, "data is null");
         }
         
+        Palette::Data::Data(const size_t size, const unsigned char* data, IO::MappedFile::Ptr file) :
+        m_size(size),
+        m_data(data),
+        m_file(file) {
+            ensure(m_size > 0, "size is 0");
+            ensure(m_data != nullptr, "data is null");
+            ensure(m_file != nullptr, "file is null");
+        }
+        
         Palette::Data::~Data() {
-            delete [] m_data;
+            if (m_file == nullptr)
+                delete [] m_data;
         }
 
         Palette::Palette(const size_t size, unsigned char* data) :
         m_data(new Data(size, data)) {}
+        
+        Palette::Palette(const size_t size, const unsigned char* data, IO::MappedFile::Ptr file) :
+        m_data(new Data(size, data, file)) {}
 
         Palette Palette::loadFile(const IO::FileSystem& fs, const IO::Path& path) {
             try {
@@ -61,23 +76,20 @@ namespace TrenchBroom {
         
         Palette Palette::loadLmp(IO::MappedFile::Ptr file) {
             const size_t size = file->size();
-            unsigned char* data = new unsigned char[size];
+            if (size < PaletteSize)
+                throw AssetException("Could not load palette file '" + file->path().asString() + "': File is too short");
             
-            IO::CharArrayReader reader(file->begin(), file->end());
-            reader.read(data, size);
-            
-            return Palette(size, data);
+            const unsigned char* data = reinterpret_cast<const unsigned char*>(file->begin());
+            return Palette(size, data, file);
         }
         
         Palette Palette::loadPcx(IO::MappedFile::Ptr file) {
-            const size_t size = 768;
-            unsigned char* data = new unsigned char[size];
-            
-            IO::CharArrayReader reader(file->begin(), file->end());
-            reader.seekFromEnd(size);
-            reader.read(data, size);
+            if (file->size() < PaletteSize)
+                throw AssetException("Could not load palette file '" + file->path().asString() + "': File is too short");
             
-            return Palette(size, data);
+            // the palette is stored at the end of the file
+            const unsigned char* data = reinterpret_cast<const unsigned char*>(file->end() - PaletteSize);
+            return Palette(PaletteSize, data, file);
         }
     }
 }
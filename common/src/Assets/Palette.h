@@ -38,9 +38,11 @@ namespace TrenchBroom {
             class Data {
             private:
                 size_t m_size;
-                unsigned char* m_data;
+                const unsigned char* m_data;
+                IO::MappedFile::Ptr m_file;
             public:
                 Data(const size_t size, unsigned char* data);
+                Data(const size_t size, const unsigned char* data, IO::MappedFile::Ptr file);
                 ~Data();
 
                 template <typename IndexT, typename ColorT>
@@ -71,8 +73,17 @@ namespace TrenchBroom {
             typedef std::shared_ptr<Data> DataPtr;
             DataPtr m_data;
         public:
+            /**
+             * Creates a palette which takes ownership of the given data.
+             */
             Palette(const size_t size, unsigned char* data);
             
+            /**
+             * Creates a palette which refers to the given data in the given file without copying it. The palette
+             * keeps the file open for as long as it exists.
+             */
+            Palette(const size_t size, const unsigned char* data, IO::MappedFile::Ptr file);
+            
             static Palette loadFile(const IO::FileSystem& fs, const IO::Path& path);
             static Palette loadLmp(IO::MappedFile::Ptr file);
             static Palette loadPcx(IO::MappedFile::Ptr file);
@@ -136,6 +136,10 @@ namespace TrenchBroom {
             m_func = 0;
         }
         
+        bool bound() const {
+            return m_func != nullptr;
+        }
+        
         R operator()() {
             ensure(m_func != nullptr, "func is null");
             return (*m_func)();
@@ -252,6 +256,10 @@ namespace TrenchBroom {
             m_func = 0;
         }
         
+        bool bound() const {
+            return m_func != nullptr;
+        }
+        
         R operator()(A1 a1) {
             ensure(m_func != nullptr, "func is null");
             return (*m_func)(a1);
@@ -368,6 +376,10 @@ namespace TrenchBroom {
             m_func = 0;
         }
         
+        bool bound() const {
+            return m_func != nullptr;
+        }
+        
         R operator()(A1 a1, A2 a2) {
             ensure(m_func != nullptr, "func is null");
             return (*m_func)(a1, a2);
@@ -484,6 +496,10 @@ namespace TrenchBroom {
             m_func = 0;
         }
         
+        bool bound() const {
+            return m_func != nullptr;
+        }
+        
         R operator()(A1 a1, A2 a2, A3 a3) {
             ensure(m_func != nullptr, "func is null");
             return (*m_func)(a1, a2, a3);
@@ -600,6 +616,10 @@ namespace TrenchBroom {
             m_func = 0;
         }
         
+        bool bound() const {
+            return m_func != nullptr;
+        }
+        
         R operator()(A1 a1, A2 a2, A3 a3, A4 a4) {
             ensure(m_func != nullptr, "func is null");
             return (*m_func)(a1, a2, a3, a4);
@@ -716,6 +736,10 @@ namespace TrenchBroom {
             m_func = 0;
         }
         
+        bool bound() const {
+            return m_func != nullptr;
+        }
+        
         R operator()(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5) {
             ensure(m_func != nullptr, "func is null");
             return (*m_func)(a1, a2, a3, a4, a5);
@@ -832,6 +856,10 @@ namespace TrenchBroom {
             m_func = 0;
         }
         
+        bool bound() const {
+            return m_func != nullptr;
+        }
+        
         R operator()(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6) {
             ensure(m_func != nullptr, "func is null");
             return (*m_func)(a1, a2, a3, a4, a5, a6);
@@ -948,6 +976,10 @@ namespace TrenchBroom {
             m_func = 0;
         }
         
+        bool bound() const {
+            return m_func != nullptr;
+        }
+        
         R operator()(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7) {
             ensure(m_func != nullptr, "func is null");
             return (*m_func)(a1, a2, a3, a4, a5, a6, a7);
@@ -1064,6 +1096,10 @@ namespace TrenchBroom {
             m_func = 0;
         }
         
+        bool bound() const {
+            return m_func != nullptr;
+        }
+        
         R operator()(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8) {
             ensure(m_func != nullptr, "func is null");
             return (*m_func)(a1, a2, a3, a4, a5, a6, a7, a8);
@@ -1180,6 +1216,10 @@ namespace TrenchBroom {
             m_func = 0;
         }
         
+        bool bound() const {
+            return m_func != nullptr;
+        }
+        
         R operator()(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9) {
             ensure(m_func != nullptr, "func is null");
             return (*m_func)(a1, a2, a3, a4, a5, a6, a7, a8, a9);
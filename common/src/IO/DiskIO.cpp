@@ -107,6 +107,14 @@ namespace TrenchBroom {
                 return ::wxFileExists(fixedPath.asString());
             }
             
+            time_t fileModificationTime(const Path& path) {
+                const Path fixedPath = fixPath(path);
+                const time_t time = ::wxFileModificationTime(fixedPath.asString());
+                if (time == static_cast<time_t>(-1))
+                    throw FileSystemException("Cannot get modification time of file: '" + fixedPath.asString() + "'");
+                return time;
+            }
+            
             String replaceForbiddenChars(const String& name) {
                 static const String forbidden = wxFileName::GetForbiddenChars().ToStdString();
                 return StringUtils::replaceChars(name, forbidden, "_");
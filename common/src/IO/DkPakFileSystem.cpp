@@ -22,6 +22,7 @@
 #include "CollectionUtils.h"
 #include "IO/CharArrayReader.h"
 #include "IO/DiskFileSystem.h"
+#include "IO/DiskIO.h"
 #include "IO/IOUtils.h"
 
 #include <cassert>
@@ -35,13 +36,67 @@ namespace TrenchBroom {
             static const String HeaderMagic       = "PACK";
         }
         
-        DkPakFileSystem::CompressedFile::CompressedFile(MappedFile::Ptr file, const size_t uncompressedSize) :
+        DkPakFileSystem::FileCache& DkPakFileSystem::FileCache::instance() {
+            static FileCache instance(MaxCacheSize);
+            return instance;
+        }
+        
+        DkPakFileSystem::FileCache::FileCache(const size_t maxSize) :
+        m_maxSize(maxSize),
+        m_size(0) {}
+        
+        MappedFile::Ptr DkPakFileSystem::FileCache::get(const Key& key) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            
+            const auto it = m_index.find(key);
+            if (it == std::end(m_index))
+                return MappedFile::Ptr();
+            
+            // move the entry to the front of the list to mark it as the most recently used one
+            m_entries.splice(std::begin(m_entries), m_entries, it->second);
+            return it->second->second;
+        }
+        
+        void DkPakFileSystem::FileCache::put(const Key& key, MappedFile::Ptr contents) {
+            ensure(contents != nullptr, "contents is null");
+            if (contents->size() > m_maxSize)
+                return;
+            
+            std::lock_guard<std::mutex> lock(m_mutex);
+            
+            // another thread might have decompressed the same entry in the meantime
+            if (m_index.count(key) > 0)
+                return;
+            
+            m_entries.push_front(Entry(key, contents));
+            m_index.insert(std::make_pair(key, std::begin(m_entries)));
+            m_size += contents->size();
+            evict();
+        }
+        
+        void DkPakFileSystem::FileCache::evict() {
+            while (m_size > m_maxSize) {
+                const Entry& entry = m_entries.back();
+                m_size -= entry.second->size();
+                m_index.erase(entry.first);
+                m_entries.pop_back();
+            }
+        }
+        
+        DkPakFileSystem::CompressedFile::CompressedFile(MappedFile::Ptr file, const size_t uncompressedSize, const FileCache::Key& cacheKey) :
         m_file(file),
-        m_uncompressedSize(uncompressedSize) {}
+        m_uncompressedSize(uncompressedSize),
+        m_cacheKey(cacheKey) {}
 
         MappedFile::Ptr DkPakFileSystem::CompressedFile::doOpen() {
-            const char* data = decompress();
-            return MappedFile::Ptr(new MappedFileBuffer(m_file->path(), data, m_uncompressedSize));
+            FileCache& cache = FileCache::instance();
+            MappedFile::Ptr result = cache.get(m_cacheKey);
+            if (result == nullptr) {
+                const char* data = decompress();
+                result = MappedFile::Ptr(new MappedFileBuffer(m_file->path(), data, m_uncompressedSize));
+                cache.put(m_cacheKey, result);
+            }
+            return result;
         }
 
         char* DkPakFileSystem::CompressedFile::decompress() const {
@@ -91,7 +146,8 @@ namespace TrenchBroom {
         }
         
         DkPakFileSystem::DkPakFileSystem(const Path& path, MappedFile::Ptr file) :
-        ImageFileSystem(path, file) {
+        ImageFileSystem(path, file),
+        m_modificationTime(Disk::fileExists(file->path()) ? Disk::fileModificationTime(file->path()) : 0) {
             initialize();
         }
         
@@ -120,7 +176,7 @@ namespace TrenchBroom {
                 if (compressed)
                     m_root.addFile(filePath, new SimpleFile(entryFile));
                 else
-                    m_root.addFile(filePath, new CompressedFile(entryFile, uncompressedSize));
+                    m_root.addFile(filePath, new CompressedFile(entryFile, uncompressedSize, FileCache::Key(m_file->path(), m_modificationTime, filePath)));
             }
         }
     }
@@ -24,22 +24,69 @@
 #include "IO/ImageFileSystem.h"
 #include "IO/Path.h"
 
+#include <ctime>
+#include <list>
 #include <map>
+#include <mutex>
+#include <tuple>
 
 namespace TrenchBroom {
     namespace IO {
         class DkPakFileSystem : public ImageFileSystem {
         private:
+            class CompressedFile;
+            
+            /**
+             * Keeps the decompressed contents of the most recently opened entries so that opening an entry again does
+             * not decompress it again. If the total size of the cached contents exceeds the given budget, the least
+             * recently opened entries are evicted. Entries which are larger than the budget are never cached.
+             *
+             * The cache is shared by all file systems, so it survives when the game file system is rebuilt, e.g. after
+             * the game path or the mods have changed. Entries are identified by the path and the modification time of
+             * their archive, so a modified archive does not return stale contents.
+             *
+             * The cache can be accessed from several threads at once, e.g. when entity models are loaded in the
+             * background.
+             */
+            class FileCache {
+            public:
+                // archive path, archive modification time, entry path
+                typedef std::tuple<Path, std::time_t, Path> Key;
+            private:
+                typedef std::pair<Key, MappedFile::Ptr> Entry;
+                typedef std::list<Entry> EntryList;
+                typedef std::map<Key, EntryList::iterator> EntryMap;
+                
+                const size_t m_maxSize;
+                size_t m_size;
+                EntryList m_entries;
+                EntryMap m_index;
+                std::mutex m_mutex;
+            public:
+                static FileCache& instance();
+                
+                FileCache(size_t maxSize);
+                
+                MappedFile::Ptr get(const Key& key);
+                void put(const Key& key, MappedFile::Ptr contents);
+            private:
+                void evict();
+            };
+            
             class CompressedFile : public File {
             private:
                 MappedFile::Ptr m_file;
                 const size_t m_uncompressedSize;
+                const FileCache::Key m_cacheKey;
             public:
-                CompressedFile(MappedFile::Ptr file, size_t uncompressedSize);
+                CompressedFile(MappedFile::Ptr file, size_t uncompressedSize, const FileCache::Key& cacheKey);
             private:
                 MappedFile::Ptr doOpen() override;
                 char* decompress() const;
             };
+            
+            static const size_t MaxCacheSize = 32 * 1024 * 1024;
+            std::time_t m_modificationTime;
         public:
             DkPakFileSystem(const Path& path, MappedFile::Ptr file);
         private:
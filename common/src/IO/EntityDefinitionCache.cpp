@@ -0,0 +1,113 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EntityDefinitionCache.h"
+
+#include "CollectionUtils.h"
+#include "Assets/EntityDefinition.h"
+#include "IO/ParserStatus.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace TrenchBroom {
+    namespace IO {
+        EntityDefinitionCache::Entry::Entry(const time_t i_modificationTime, const Color& i_defaultColor, const Assets::EntityDefinitionList& i_definitions, const MessageList& i_messages) :
+        modificationTime(i_modificationTime),
+        defaultColor(i_defaultColor),
+        definitions(i_definitions),
+        messages(i_messages) {}
+        
+        /**
+         * Passes the progress and messages of a parser on to another status and records the messages.
+         */
+        class EntityDefinitionCache::RecordingParserStatus : public ParserStatus {
+        private:
+            ParserStatus& m_status;
+            MessageList m_messages;
+        public:
+            RecordingParserStatus(ParserStatus& status) :
+            ParserStatus(nullptr),
+            m_status(status) {}
+            
+            const MessageList& messages() const {
+                return m_messages;
+            }
+        private:
+            void doProgress(const double progress) override {
+                m_status.progress(progress);
+            }
+            
+            void doLog(const Logger::LogLevel level, const String& str) override {
+                m_messages.push_back(Message(level, str));
+                m_status.replay(level, str);
+            }
+        };
+        
+        EntityDefinitionCache& EntityDefinitionCache::instance() {
+            static EntityDefinitionCache instance;
+            return instance;
+        }
+        
+        EntityDefinitionCache::EntityDefinitionCache() {}
+        
+        EntityDefinitionCache::~EntityDefinitionCache() {
+            clear();
+        }
+        
+        Assets::EntityDefinitionList EntityDefinitionCache::definitions(const Path& path, const time_t modificationTime, const Color& defaultColor, ParserStatus& status, const ParseFunc& parse) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            
+            auto it = m_entries.find(path);
+            if (it != std::end(m_entries)) {
+                const Entry& entry = it->second;
+                if (entry.modificationTime == modificationTime && entry.defaultColor == defaultColor) {
+                    for (const Message& message : entry.messages)
+                        status.replay(message.first, message.second);
+                    return cloneDefinitions(entry.definitions);
+                }
+                
+                Assets::EntityDefinitionList definitions = entry.definitions;
+                m_entries.erase(it);
+                VectorUtils::clearAndDelete(definitions);
+            }
+            
+            // if parsing fails, the exception is passed on to the caller and nothing is cached
+            RecordingParserStatus recordingStatus(status);
+            const Assets::EntityDefinitionList definitions = parse(recordingStatus);
+            m_entries.insert(std::make_pair(path, Entry(modificationTime, defaultColor, definitions, recordingStatus.messages())));
+            return cloneDefinitions(definitions);
+        }
+        
+        void EntityDefinitionCache::clear() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (auto& entry : m_entries)
+                VectorUtils::clearAndDelete(entry.second.definitions);
+            m_entries.clear();
+        }
+        
+        Assets::EntityDefinitionList EntityDefinitionCache::cloneDefinitions(const Assets::EntityDefinitionList& definitions) {
+            Assets::EntityDefinitionList result;
+            result.reserve(definitions.size());
+            std::transform(std::begin(definitions), std::end(definitions), std::back_inserter(result),
+                           [](const Assets::EntityDefinition* definition) { return definition->clone(); });
+            return result;
+        }
+    }
+}
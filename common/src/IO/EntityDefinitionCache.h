@@ -0,0 +1,97 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_EntityDefinitionCache
+#define TrenchBroom_EntityDefinitionCache
+
+#include "Color.h"
+#include "Logger.h"
+#include "Macros.h"
+#include "StringUtils.h"
+#include "Assets/AssetTypes.h"
+#include "IO/Path.h"
+
+#include <ctime>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace IO {
+        /**
+         * Keeps the entity definitions parsed from entity definition files so that loading the same file again, e.g.
+         * when another map of the same game is opened, does not parse the file again. A file is parsed again if it
+         * was modified since it was parsed, or if it is loaded with a different default entity color.
+         *
+         * The cached definitions are never handed out. Instead, every caller receives its own copies, which share
+         * the immutable attribute and model definitions with the cached definitions. The messages which were logged
+         * while parsing a file are cached with its definitions and replayed to every caller.
+         *
+         * The cache can be accessed from several threads at once.
+         */
+        class ParserStatus;
+        
+        class EntityDefinitionCache {
+        public:
+            typedef std::function<Assets::EntityDefinitionList(ParserStatus& status)> ParseFunc;
+        private:
+            typedef std::pair<Logger::LogLevel, String> Message;
+            typedef std::vector<Message> MessageList;
+            
+            struct Entry {
+                time_t modificationTime;
+                Color defaultColor;
+                Assets::EntityDefinitionList definitions;
+                MessageList messages;
+                
+                Entry(time_t i_modificationTime, const Color& i_defaultColor, const Assets::EntityDefinitionList& i_definitions, const MessageList& i_messages);
+            };
+            
+            class RecordingParserStatus;
+            
+            typedef std::unordered_map<Path, Entry, Path::Hash> EntryMap;
+            
+            EntryMap m_entries;
+            std::mutex m_mutex;
+        public:
+            static EntityDefinitionCache& instance();
+            
+            EntityDefinitionCache();
+            ~EntityDefinitionCache();
+            
+            /**
+             * Returns copies of the definitions parsed from the file at the given path. If the file was not parsed yet
+             * with the given modification time and default color, the given function is called to parse it, and the
+             * messages it logs are passed on to the given status. Otherwise, the messages which were logged when the
+             * file was parsed are replayed to the given status. The caller takes ownership of the returned
+             * definitions.
+             */
+            Assets::EntityDefinitionList definitions(const Path& path, time_t modificationTime, const Color& defaultColor, ParserStatus& status, const ParseFunc& parse);
+            void clear();
+        private:
+            static Assets::EntityDefinitionList cloneDefinitions(const Assets::EntityDefinitionList& definitions);
+            
+            deleteCopyAndAssignment(EntityDefinitionCache)
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_EntityDefinitionCache) */
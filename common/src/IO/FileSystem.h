@@ -43,6 +43,12 @@ namespace TrenchBroom {
 
             Path makeAbsolute(const Path& relPath) const;
             
+            /**
+             * Indicates whether the contents of this file system never change after it has been created. The
+             * directory structure of such a file system may be cached by its clients.
+             */
+            bool immutable() const;
+            
             bool directoryExists(const Path& path) const;
             bool fileExists(const Path& path) const;
 
@@ -77,6 +83,7 @@ namespace TrenchBroom {
             }
 
             virtual Path doMakeAbsolute(const Path& relPath) const = 0;
+            virtual bool doIsImmutable() const;
             virtual bool doDirectoryExists(const Path& path) const = 0;
             virtual bool doFileExists(const Path& path) const = 0;
             
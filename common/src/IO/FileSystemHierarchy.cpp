@@ -36,9 +36,11 @@ namespace TrenchBroom {
         void FileSystemHierarchy::addFileSystem(FileSystem* fileSystem) {
             ensure(fileSystem != nullptr, "fileSystem is null");
             m_fileSystems.push_back(fileSystem);
+            invalidatePathIndex();
         }
 
         void FileSystemHierarchy::clear() {
+            invalidatePathIndex();
             VectorUtils::clearAndDelete(m_fileSystems);
         }
 
@@ -50,9 +52,13 @@ namespace TrenchBroom {
         }
 
         bool FileSystemHierarchy::doDirectoryExists(const Path& path) const {
-            for (auto it = m_fileSystems.rbegin(), end = m_fileSystems.rend(); it != end; ++it) {
-                const FileSystem* fileSystem = *it;
-                if (fileSystem->directoryExists(path))
+            const PathIndexPtr index = pathIndex();
+            if (index->directories.count(indexKey(path)) > 0)
+                return true;
+            
+            for (size_t i = index->fileSystems.size(); i > 0; --i) {
+                const FileSystem* fileSystem = index->fileSystems[i - 1];
+                if (!index->indexed[i - 1] && fileSystem->directoryExists(path))
                     return true;
             }
             return false;
@@ -63,14 +69,69 @@ namespace TrenchBroom {
         }
         
         FileSystem* FileSystemHierarchy::findFileSystemContaining(const Path& path) const {
-            for (auto it = m_fileSystems.rbegin(), end = m_fileSystems.rend(); it != end; ++it) {
-                FileSystem* fileSystem = *it;
-                if (fileSystem->fileExists(path))
+            const PathIndexPtr index = pathIndex();
+            
+            // position of the indexed file system that contains the path, plus one, or zero if there is none
+            const PathIndex::FileMap::const_iterator it = index->files.find(indexKey(path));
+            const size_t indexedPosition = it != std::end(index->files) ? it->second + 1 : 0;
+            
+            for (size_t i = index->fileSystems.size(); i > indexedPosition; --i) {
+                FileSystem* fileSystem = index->fileSystems[i - 1];
+                if (!index->indexed[i - 1] && fileSystem->fileExists(path))
                     return fileSystem;
             }
+            
+            if (indexedPosition > 0)
+                return index->fileSystems[indexedPosition - 1];
             return nullptr;
         }
 
+        FileSystemHierarchy::PathIndexPtr FileSystemHierarchy::pathIndex() const {
+            PathIndexPtr index = std::atomic_load(&m_index);
+            if (index == nullptr) {
+                std::lock_guard<std::mutex> lock(m_indexMutex);
+                index = std::atomic_load(&m_index);
+                if (index == nullptr) {
+                    index = buildPathIndex();
+                    std::atomic_store(&m_index, index);
+                }
+            }
+            return index;
+        }
+        
+        FileSystemHierarchy::PathIndexPtr FileSystemHierarchy::buildPathIndex() const {
+            std::shared_ptr<PathIndex> index = std::make_shared<PathIndex>();
+            index->fileSystems = m_fileSystems;
+            index->indexed.reserve(m_fileSystems.size());
+            
+            for (size_t i = 0; i < m_fileSystems.size(); ++i) {
+                const FileSystem* fileSystem = m_fileSystems[i];
+                const bool indexed = fileSystem->immutable();
+                index->indexed.push_back(indexed);
+                
+                if (indexed) {
+                    index->directories.insert(indexKey(Path("")));
+                    
+                    // later file systems shadow earlier ones, so we just overwrite existing entries
+                    for (const Path& file : fileSystem->findItemsRecursively(Path(""), FileTypeMatcher(true, false)))
+                        index->files[indexKey(file)] = i;
+                    for (const Path& directory : fileSystem->findItemsRecursively(Path(""), FileTypeMatcher(false, true)))
+                        index->directories.insert(indexKey(directory));
+                }
+            }
+            
+            return index;
+        }
+
+        void FileSystemHierarchy::invalidatePathIndex() {
+            std::lock_guard<std::mutex> lock(m_indexMutex);
+            std::atomic_store(&m_index, PathIndexPtr());
+        }
+
+        String FileSystemHierarchy::indexKey(const Path& path) {
+            return StringUtils::toLower(path.makeCanonical().asString('/'));
+        }
+
         Path::List FileSystemHierarchy::doGetDirectoryContents(const Path& path) const {
             Path::List result;
             for (auto it = m_fileSystems.rbegin(), end = m_fileSystems.rend(); it != end; ++it) {
@@ -86,9 +147,17 @@ namespace TrenchBroom {
         }
         
         const MappedFile::Ptr FileSystemHierarchy::doOpenFile(const Path& path) const {
+            const FileSystem* shadowingFileSystem = findFileSystemContaining(path);
+            if (shadowingFileSystem != nullptr) {
+                const MappedFile::Ptr file = shadowingFileSystem->openFile(path);
+                if (file.get() != nullptr)
+                    return file;
+            }
+            
+            // the file could not be opened, so fall back to any other file system that contains it
             for (auto it = m_fileSystems.rbegin(), end = m_fileSystems.rend(); it != end; ++it) {
                 const FileSystem* fileSystem = *it;
-                if (fileSystem->fileExists(path)) {
+                if (fileSystem != shadowingFileSystem && fileSystem->fileExists(path)) {
                     const MappedFile::Ptr file = fileSystem->openFile(path);
                     if (file.get() != nullptr)
                         return file;
@@ -26,16 +26,46 @@
 #include "IO/FileSystem.h"
 #include "IO/Path.h"
 
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace TrenchBroom {
     namespace IO {
         class Path;
         
+        /**
+         * Combines several file systems so that files in later file systems shadow files with the same path in
+         * earlier ones.
+         *
+         * The contents of all immutable file systems are merged into a single index that maps each lower cased file
+         * path to the last immutable file system containing it. The index is built on the first lookup after the
+         * file systems have changed. Other file systems are only queried if they come after the file system found in
+         * the index, since only they could shadow it.
+         *
+         * Lookups may be performed from several threads concurrently, but the file systems must not be changed while
+         * any lookups are running.
+         */
         class FileSystemHierarchy : public virtual FileSystem {
         private:
             typedef std::vector<FileSystem*> FileSystemList;
+            
+            struct PathIndex {
+                typedef std::unordered_map<String, size_t> FileMap;
+                typedef std::unordered_set<String> DirectorySet;
+                
+                FileSystemList fileSystems;
+                std::vector<bool> indexed;
+                FileMap files;
+                DirectorySet directories;
+            };
+            typedef std::shared_ptr<const PathIndex> PathIndexPtr;
+            
             FileSystemList m_fileSystems;
+            mutable PathIndexPtr m_index;
+            mutable std::mutex m_indexMutex;
         public:
             FileSystemHierarchy();
             virtual ~FileSystemHierarchy() override;
@@ -48,6 +78,11 @@ namespace TrenchBroom {
             bool doFileExists(const Path& path) const override;
             FileSystem* findFileSystemContaining(const Path& path) const;
             
+            PathIndexPtr pathIndex() const;
+            PathIndexPtr buildPathIndex() const;
+            void invalidatePathIndex();
+            static String indexKey(const Path& path);
+            
             Path::List doGetDirectoryContents(const Path& path) const override;
             const MappedFile::Ptr doOpenFile(const Path& path) const override;
 
@@ -144,6 +144,10 @@ namespace TrenchBroom {
         Path ImageFileSystem::doMakeAbsolute(const Path& relPath) const {
             return m_path + relPath.makeCanonical();
         }
+
+        bool ImageFileSystem::doIsImmutable() const {
+            return true;
+        }
         
         bool ImageFileSystem::doDirectoryExists(const Path& path) const {
             const Path searchPath = path.makeLowerCase();
@@ -84,6 +84,7 @@ namespace TrenchBroom {
             void initialize();
         private:
             Path doMakeAbsolute(const Path& relPath) const override;
+            bool doIsImmutable() const override;
             bool doDirectoryExists(const Path& path) const override;
             bool doFileExists(const Path& path) const override;
             
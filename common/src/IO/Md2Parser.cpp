@@ -221,15 +221,97 @@ namespace TrenchBroom {
         vertexCount(static_cast<size_t>(i_vertexCount < 0 ? -i_vertexCount : i_vertexCount)),
         vertices(vertexCount) {}
 
-        Md2Parser::Md2Parser(const String& name, const char* begin, const char* end, const Assets::Palette& palette, const FileSystem& fs) :
+        /**
+         * Decodes the frames of an MD2 model directly from the mapped model file when they are requested. Keeps the
+         * file mapped for as long as the model exists. The bounds of a frame are computed from the vertices that are
+         * referenced by the meshes, which are exactly the vertices of the decoded frame.
+         */
+        class Md2Parser::FrameSource : public Assets::Md2Model::FrameSource {
+        private:
+            MappedFile::Ptr m_file;
+            const char* m_frames;
+            size_t m_frameCount;
+            size_t m_frameSize;
+            size_t m_frameVertexCount;
+            Md2MeshList m_meshes;
+            std::vector<size_t> m_meshVertexIndices;
+        public:
+            FrameSource(MappedFile::Ptr file, const char* frames, const size_t frameCount, const size_t frameSize, const size_t frameVertexCount, const Md2MeshList& meshes) :
+            m_file(file),
+            m_frames(frames),
+            m_frameCount(frameCount),
+            m_frameSize(frameSize),
+            m_frameVertexCount(frameVertexCount),
+            m_meshes(meshes) {
+                if (m_frameSize < Md2Layout::FrameHeaderSize + m_frameVertexCount * sizeof(Md2Vertex))
+                    throw AssetException() << "MD2 frame size " << m_frameSize << " is too small for " << m_frameVertexCount << " vertices";
+                if (m_frames > m_file->end() || (m_frameSize > 0 && m_frameCount > static_cast<size_t>(m_file->end() - m_frames) / m_frameSize))
+                    throw AssetException() << "MD2 frames exceed file size";
+                
+                for (const Md2Mesh& mesh : m_meshes) {
+                    for (const Md2MeshVertex& vertex : mesh.vertices) {
+                        if (vertex.vertexIndex >= m_frameVertexCount)
+                            throw AssetException() << "MD2 mesh vertex index " << vertex.vertexIndex << " is out of range";
+                        m_meshVertexIndices.push_back(vertex.vertexIndex);
+                    }
+                }
+                
+                if (m_meshVertexIndices.empty())
+                    throw AssetException() << "MD2 model has no triangles";
+                VectorUtils::sortAndRemoveDuplicates(m_meshVertexIndices);
+            }
+        private:
+            size_t doGetFrameCount() const override {
+                return m_frameCount;
+            }
+            
+            Assets::Md2Model::Frame* doLoadFrame(const size_t index) const override {
+                return buildFrame(parseFrame(frameBegin(index), m_frameVertexCount), m_meshes);
+            }
+            
+            BBox3f doGetBounds(const size_t index) const override {
+                return doGetTransformedBounds(index, Mat4x4f::Identity);
+            }
+            
+            BBox3f doGetTransformedBounds(const size_t index, const Mat4x4f& transformation) const override {
+                // Read the packed positions in place instead of building the frame's vertex list.
+                const char* cursor = frameBegin(index);
+                const Vec3f scale = readVec3f(cursor);
+                const Vec3f offset = readVec3f(cursor);
+                const char* vertices = cursor + Md2Layout::FrameNameLength;
+                
+                BBox3f bounds;
+                for (size_t i = 0; i < m_meshVertexIndices.size(); ++i) {
+                    const char* vertex = vertices + m_meshVertexIndices[i] * sizeof(Md2Vertex);
+                    const Vec3f position(static_cast<float>(static_cast<unsigned char>(vertex[0])),
+                                         static_cast<float>(static_cast<unsigned char>(vertex[1])),
+                                         static_cast<float>(static_cast<unsigned char>(vertex[2])));
+                    const Vec3f transformed = transformation * (position * scale + offset);
+                    if (i == 0)
+                        bounds.min = bounds.max = transformed;
+                    else
+                        bounds.mergeWith(transformed);
+                }
+                return bounds;
+            }
+            
+            const char* frameBegin(const size_t index) const {
+                return m_frames + index * m_frameSize;
+            }
+        };
+
+        Md2Parser::Md2Parser(const String& name, MappedFile::Ptr file, const Assets::Palette& palette, const FileSystem& fs) :
         m_name(name),
-        m_begin(begin),
-        /* m_end(end), */
+        m_file(file),
+        m_begin(m_file->begin()),
         m_palette(palette),
         m_fs(fs) {}
         
         // http://tfc.duke.free.fr/old/models/md2.htm
         Assets::EntityModel* Md2Parser::doParseModel() {
+            if (static_cast<size_t>(m_file->end() - m_begin) < Md2Layout::HeaderSize)
+                throw AssetException() << "MD2 file is too short";
+            
             const char* cursor = m_begin;
             const int ident = readInt<int32_t>(cursor);
             const int version = readInt<int32_t>(cursor);
@@ -241,7 +323,7 @@ namespace TrenchBroom {
             
             /*const size_t skinWidth =*/ readSize<int32_t>(cursor);
             /*const size_t skinHeight =*/ readSize<int32_t>(cursor);
-            /*const size_t frameSize =*/ readSize<int32_t>(cursor);
+            const size_t frameSize = readSize<int32_t>(cursor);
             
             const size_t skinCount = readSize<int32_t>(cursor);
             const size_t frameVertexCount = readSize<int32_t>(cursor);
@@ -256,11 +338,30 @@ namespace TrenchBroom {
             const size_t frameOffset = readSize<int32_t>(cursor);
             const size_t commandOffset = readSize<int32_t>(cursor);
 
+            if (!inFile(skinOffset, skinCount * sizeof(Md2Skin)))
+                throw AssetException() << "MD2 skins exceed file size";
+            if (!inFile(commandOffset, commandCount * 4))
+                throw AssetException() << "MD2 commands exceed file size";
+            if (!inFile(frameOffset, 0))
+                throw AssetException() << "MD2 frames exceed file size";
+
             const Md2SkinList skins = parseSkins(m_begin + skinOffset, skinCount);
-            const Md2FrameList frames = parseFrames(m_begin + frameOffset, frameCount, frameVertexCount);
             const Md2MeshList meshes = parseMeshes(m_begin + commandOffset, commandCount);
             
-            return buildModel(skins, frames, meshes);
+            // Frames are only decoded when they are requested, most models are only ever displayed in one frame.
+            FrameSource* frames = new FrameSource(m_file, m_begin + frameOffset, frameCount, frameSize, frameVertexCount, meshes);
+            try {
+                const Assets::TextureList modelTextures = loadTextures(skins);
+                return new Assets::Md2Model(m_name, modelTextures, frames);
+            } catch (...) {
+                delete frames;
+                throw;
+            }
+        }
+
+        bool Md2Parser::inFile(const size_t offset, const size_t length) const {
+            const size_t fileSize = static_cast<size_t>(m_file->end() - m_begin);
+            return offset <= fileSize && length <= fileSize - offset;
         }
 
         Md2Parser::Md2SkinList Md2Parser::parseSkins(const char* begin, const size_t skinCount) {
@@ -269,18 +370,16 @@ namespace TrenchBroom {
             return skins;
         }
 
-        Md2Parser::Md2FrameList Md2Parser::parseFrames(const char* begin, const size_t frameCount, const size_t frameVertexCount) {
-            Md2FrameList frames(frameCount, Md2Frame(frameVertexCount));
+        Md2Parser::Md2Frame Md2Parser::parseFrame(const char* begin, const size_t frameVertexCount) {
+            Md2Frame frame(frameVertexCount);
 
             const char* cursor = begin;
-            for (size_t i = 0; i < frameCount; ++i) {
-                frames[i].scale = readVec3f(cursor);
-                frames[i].offset = readVec3f(cursor);
-                readBytes(cursor, frames[i].name, Md2Layout::FrameNameLength);
-                readVector(cursor, frames[i].vertices);
-            }
+            frame.scale = readVec3f(cursor);
+            frame.offset = readVec3f(cursor);
+            readBytes(cursor, frame.name, Md2Layout::FrameNameLength);
+            readVector(cursor, frame.vertices);
             
-            return frames;
+            return frame;
         }
 
         Md2Parser::Md2MeshList Md2Parser::parseMeshes(const char* begin, const size_t commandCount) {
@@ -290,8 +389,9 @@ namespace TrenchBroom {
             const char* end = begin + commandCount * 4;
             while (cursor < end) {
                 Md2Mesh mesh(readInt<int32_t>(cursor));
+                if (mesh.vertexCount > static_cast<size_t>(end - cursor) / 12)
+                    throw AssetException() << "MD2 mesh exceeds command list";
                 for (size_t i = 0; i < mesh.vertexCount; ++i) {
-                    assert(cursor < end);
                     mesh.vertices[i].texCoords[0] = readFloat<float>(cursor);
                     mesh.vertices[i].texCoords[1] = readFloat<float>(cursor);
                     mesh.vertices[i].vertexIndex = readSize<int32_t>(cursor);
@@ -303,12 +403,6 @@ namespace TrenchBroom {
             return meshes;
         }
 
-        Assets::EntityModel* Md2Parser::buildModel(const Md2SkinList& skins, const Md2FrameList& frames, const Md2MeshList& meshes) {
-            const Assets::TextureList modelTextures = loadTextures(skins);
-            const Assets::Md2Model::FrameList modelFrames = buildFrames(frames, meshes);
-            return new Assets::Md2Model(m_name, modelTextures, modelFrames);
-        }
-
         Assets::TextureList Md2Parser::loadTextures(const Md2SkinList& skins) {
             Assets::TextureList textures;
             textures.reserve(skins.size());
@@ -337,15 +431,6 @@ namespace TrenchBroom {
             return new Assets::Texture(skin.name, image.width(), image.height(), avgColor, rgbImage);
         }
 
-        Assets::Md2Model::FrameList Md2Parser::buildFrames(const Md2FrameList& frames, const Md2MeshList& meshes) {
-            Assets::Md2Model::FrameList modelFrames;
-            modelFrames.reserve(frames.size());
-            
-            for (const Md2Frame& frame : frames)
-                modelFrames.push_back(buildFrame(frame, meshes));
-            return modelFrames;
-        }
-
         Assets::Md2Model::Frame* Md2Parser::buildFrame(const Md2Frame& frame, const Md2MeshList& meshes) {
             size_t vertexCount = 0;
             Renderer::IndexRangeMap::Size size;
@@ -371,7 +456,7 @@ namespace TrenchBroom {
             return new Assets::Md2Model::Frame(builder.vertices(), builder.indexArray());
         }
         
-        Assets::Md2Model::VertexList Md2Parser::getVertices(const Md2Frame& frame, const Md2MeshVertexList& meshVertices) const {
+        Assets::Md2Model::VertexList Md2Parser::getVertices(const Md2Frame& frame, const Md2MeshVertexList& meshVertices) {
             typedef Assets::Md2Model::Vertex Vertex;
 
             Vertex::List result(0);
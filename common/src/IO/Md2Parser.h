@@ -25,6 +25,7 @@
 #include "Assets/AssetTypes.h"
 #include "Assets/Md2Model.h"
 #include "IO/EntityModelParser.h"
+#include "IO/MappedFile.h"
 
 #include <vector>
 
@@ -43,6 +44,8 @@ namespace TrenchBroom {
             static const int Version = 8;
             static const size_t SkinNameLength = 64;
             static const size_t FrameNameLength = 16;
+            static const size_t HeaderSize = 17 * sizeof(int32_t);
+            static const size_t FrameHeaderSize = 6 * sizeof(float) + FrameNameLength;
         }
 
         // see http://tfc.duke.free.fr/coding/md2-specs-en.html
@@ -71,7 +74,6 @@ namespace TrenchBroom {
                 Vec3f vertex(size_t index) const;
                 const Vec3f& normal(size_t index) const;
             };
-            typedef std::vector<Md2Frame> Md2FrameList;
 
             struct Md2MeshVertex {
                 Vec2f texCoords;
@@ -93,25 +95,25 @@ namespace TrenchBroom {
             };
             typedef std::vector<Md2Mesh> Md2MeshList;
             
+            class FrameSource;
             
             String m_name;
+            MappedFile::Ptr m_file;
             const char* m_begin;
-            /* const char* m_end; */
             const Assets::Palette& m_palette;
             const FileSystem& m_fs;
         public:
-            Md2Parser(const String& name, const char* begin, const char* end, const Assets::Palette& palette, const FileSystem& fs);
+            Md2Parser(const String& name, MappedFile::Ptr file, const Assets::Palette& palette, const FileSystem& fs);
         private:
             Assets::EntityModel* doParseModel() override;
+            bool inFile(size_t offset, size_t length) const;
             Md2SkinList parseSkins(const char* begin, const size_t skinCount);
-            Md2FrameList parseFrames(const char* begin, const size_t frameCount, const size_t frameVertexCount);
+            static Md2Frame parseFrame(const char* begin, const size_t frameVertexCount);
             Md2MeshList parseMeshes(const char* begin, const size_t commandCount);
-            Assets::EntityModel* buildModel(const Md2SkinList& skins, const Md2FrameList& frames, const Md2MeshList& meshes);
             Assets::TextureList loadTextures(const Md2SkinList& skins);
             Assets::Texture* readTexture(const Md2Skin& skin);
-            Assets::Md2Model::FrameList buildFrames(const Md2FrameList& frames, const Md2MeshList& meshes);
-            Assets::Md2Model::Frame* buildFrame(const Md2Frame& frame, const Md2MeshList& meshes);
-            Assets::Md2Model::VertexList getVertices(const Md2Frame& frame, const Md2MeshVertexList& meshVertices) const;
+            static Assets::Md2Model::Frame* buildFrame(const Md2Frame& frame, const Md2MeshList& meshes);
+            static Assets::Md2Model::VertexList getVertices(const Md2Frame& frame, const Md2MeshVertexList& meshVertices);
         };
     }
 }
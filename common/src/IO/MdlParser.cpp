@@ -37,7 +37,7 @@ namespace TrenchBroom {
             static const unsigned int SimpleFrameName   = 0x8;
             static const unsigned int SimpleFrameLength = 0x10;
             static const unsigned int MultiFrameTimes   = 0xC;
-            // static const unsigned int FrameVertexSize   = 0x4;
+            static const unsigned int FrameVertexSize   = 0x4;
         }
 
         const Vec3f MdlParser::Normals[] = {
@@ -206,18 +206,82 @@ namespace TrenchBroom {
         };
 
         
-        MdlParser::MdlParser(const String& name, const char* begin, const char* end, const Assets::Palette& palette) :
+        /**
+         * Decodes the frames of an MDL model directly from the mapped model file when they are requested. Keeps the
+         * file mapped for as long as the model exists. The bounds of a frame are read from its header.
+         */
+        class MdlParser::FrameSource : public Assets::MdlModel::FrameSource {
+        private:
+            MappedFile::Ptr m_file;
+            FrameOffsetList m_frames;
+            MdlSkinTriangleList m_skinTriangles;
+            MdlSkinVertexList m_skinVertices;
+            size_t m_skinWidth;
+            size_t m_skinHeight;
+            Vec3f m_origin;
+            Vec3f m_scale;
+        public:
+            FrameSource(MappedFile::Ptr file, const FrameOffsetList& frames, const MdlSkinTriangleList& skinTriangles, const MdlSkinVertexList& skinVertices, const size_t skinWidth, const size_t skinHeight, const Vec3f& origin, const Vec3f& scale) :
+            m_file(file),
+            m_frames(frames),
+            m_skinTriangles(skinTriangles),
+            m_skinVertices(skinVertices),
+            m_skinWidth(skinWidth),
+            m_skinHeight(skinHeight),
+            m_origin(origin),
+            m_scale(scale) {}
+        private:
+            size_t doGetFrameCount() const override {
+                return m_frames.size();
+            }
+            
+            Assets::MdlFrame* doLoadFrame(const size_t index) const override {
+                return parseFrame(m_frames[index], m_skinTriangles, m_skinVertices, m_skinWidth, m_skinHeight, m_origin, m_scale);
+            }
+            
+            BBox3f doGetBounds(const size_t index) const override {
+                if (m_skinVertices.empty())
+                    return BBox3f(-8.0f, 8.0f);
+                
+                const char* cursor = m_frames[index];
+                const Vec3f min = unpackFrameVertex(readPackedVertex(cursor), m_origin, m_scale);
+                const Vec3f max = unpackFrameVertex(readPackedVertex(cursor), m_origin, m_scale);
+                return BBox3f(min, max);
+            }
+            
+            BBox3f doGetTransformedBounds(const size_t index, const Mat4x4f& transformation) const override {
+                if (m_skinVertices.empty())
+                    return BBox3f(-8.0f, 8.0f);
+                
+                // Read the packed positions in place instead of building the frame's triangles.
+                const char* cursor = m_frames[index] + MdlLayout::SimpleFrameName + MdlLayout::SimpleFrameLength;
+                
+                BBox3f bounds;
+                bounds.min = bounds.max = transformation * unpackFrameVertex(readPackedVertex(cursor), m_origin, m_scale);
+                for (size_t i = 1; i < m_skinVertices.size(); ++i)
+                    bounds.mergeWith(transformation * unpackFrameVertex(readPackedVertex(cursor), m_origin, m_scale));
+                return bounds;
+            }
+            
+            static PackedFrameVertex readPackedVertex(const char*& cursor) {
+                PackedFrameVertex result;
+                for (size_t i = 0; i < MdlLayout::FrameVertexSize; ++i)
+                    result[i] = static_cast<unsigned char>(*cursor++);
+                return result;
+            }
+        };
+
+        MdlParser::MdlParser(const String& name, MappedFile::Ptr file, const Assets::Palette& palette) :
         m_name(name),
-        m_begin(begin),
-        m_end(end),
+        m_file(file),
+        m_begin(m_file->begin()),
+        m_end(m_file->end()),
         m_palette(palette) {
             assert(m_begin < m_end);
             unused(m_end);
         }
 
         Assets::EntityModel* MdlParser::doParseModel() {
-            Assets::MdlModel* model = new Assets::MdlModel(m_name);
-            
             const char* cursor = m_begin + MdlLayout::HeaderScale;
             const Vec3f scale = readVec3f(cursor);
             const Vec3f origin = readVec3f(cursor);
@@ -230,16 +294,28 @@ namespace TrenchBroom {
             const size_t skinTriangleCount = readSize<int32_t>(cursor);
             const size_t frameCount = readSize<int32_t>(cursor);
             
-            parseSkins(cursor, *model, skinCount, skinWidth, skinHeight);
-            const MdlSkinVertexList skinVertices = parseSkinVertices(cursor, skinVertexCount);
-            const MdlSkinTriangleList skinTriangles = parseSkinTriangles(cursor, skinTriangleCount);
-            parseFrames(cursor, *model, frameCount, skinTriangles, skinVertices, skinWidth, skinHeight, origin, scale);
-
-            assert(cursor <= m_end);
-            return model;
+            SkinList skins = parseSkins(cursor, skinCount, skinWidth, skinHeight);
+            try {
+                const MdlSkinVertexList skinVertices = parseSkinVertices(cursor, skinVertexCount);
+                const MdlSkinTriangleList skinTriangles = parseSkinTriangles(cursor, skinTriangleCount);
+                const FrameOffsetList frames = parseFrameOffsets(cursor, frameCount, skinVertexCount);
+                assert(cursor <= m_end);
+                
+                // Frames are only decoded when they are requested, most models are only ever displayed in one frame.
+                Assets::MdlModel* model = new Assets::MdlModel(m_name, new FrameSource(m_file, frames, skinTriangles, skinVertices, skinWidth, skinHeight, origin, scale));
+                for (Assets::MdlSkin* skin : skins)
+                    model->addSkin(skin);
+                return model;
+            } catch (...) {
+                VectorUtils::clearAndDelete(skins);
+                throw;
+            }
         }
 
-        void MdlParser::parseSkins(const char*& cursor, Assets::MdlModel& model, const size_t count, const size_t width, const size_t height) {
+        MdlParser::SkinList MdlParser::parseSkins(const char*& cursor, const size_t count, const size_t width, const size_t height) {
+            SkinList skins;
+            skins.reserve(count);
+            
             const size_t size = width * height;
             Color avgColor;
             StringStream textureName;
@@ -256,7 +332,7 @@ namespace TrenchBroom {
                     textureName << m_name << "_" << i;
                     
                     Assets::Texture* texture = new Assets::Texture(textureName.str(), width, height, avgColor, rgbImage);
-                    model.addSkin(new Assets::MdlSkin(texture));
+                    skins.push_back(new Assets::MdlSkin(texture));
                 } else {
                     const size_t pictureCount = readSize<int32_t>(cursor);
                     const char* base = cursor;
@@ -279,9 +355,11 @@ namespace TrenchBroom {
                         textures[j] = new Assets::Texture(textureName.str(), width, height, avgColor, rgbImage);
                     }
                     
-                    model.addSkin(new Assets::MdlSkin(textures, times));
+                    skins.push_back(new Assets::MdlSkin(textures, times));
                 }
             }
+            
+            return skins;
         }
 
         MdlParser::MdlSkinVertexList MdlParser::parseSkinVertices(const char*& cursor, const size_t count) {
@@ -304,33 +382,34 @@ namespace TrenchBroom {
             return triangles;
         }
 
-        void MdlParser::parseFrames(const char*& cursor, Assets::MdlModel& model, const size_t count, const MdlSkinTriangleList& skinTriangles, const MdlSkinVertexList& skinVertices, const size_t skinWidth, const size_t skinHeight, const Vec3f& origin, const Vec3f& scale) {
+        MdlParser::FrameOffsetList MdlParser::parseFrameOffsets(const char*& cursor, const size_t count, const size_t frameVertexCount) {
+            const size_t simpleFrameSize = MdlLayout::SimpleFrameName + MdlLayout::SimpleFrameLength + frameVertexCount * MdlLayout::FrameVertexSize;
+            
+            FrameOffsetList frames;
+            frames.reserve(count);
+            
             for (size_t i = 0; i < count; ++i) {
                 const int type = readInt<int32_t>(cursor);
                 if (type == 0) { // single frame
-                    model.addFrame(parseFrame(cursor, skinTriangles, skinVertices, skinWidth, skinHeight, origin, scale));
-                } else { // frame group
-                    Assets::MdlFrameGroup* frameGroup = new Assets::MdlFrameGroup();
-                    
+                    frames.push_back(cursor);
+                    cursor += simpleFrameSize;
+                } else { // frame group, only its first frame is ever displayed
                     const char* base = cursor;
                     const size_t groupFrameCount = readSize<int32_t>(cursor);
                     
-                    const char* timeCursor = base + MdlLayout::MultiFrameTimes;
                     const char* frameCursor = base + MdlLayout::MultiFrameTimes + groupFrameCount * sizeof(float);
-
-                    for (size_t j = 0; j < groupFrameCount; ++j) {
-                        const float time = readFloat<float>(timeCursor);
-                        Assets::MdlFrame* frame = parseFrame(frameCursor, skinTriangles, skinVertices, skinWidth, skinHeight, origin, scale);
-                        frameGroup->addFrame(frame, time);
-                    }
-                    
-                    model.addFrame(frameGroup);
-                    cursor = frameCursor;
+                    frames.push_back(frameCursor);
+                    cursor = frameCursor + groupFrameCount * simpleFrameSize;
                 }
+                
+                if (cursor > m_end)
+                    throw AssetException() << "MDL frame " << i << " exceeds file size";
             }
+            
+            return frames;
         }
 
-        Assets::MdlFrame* MdlParser::parseFrame(const char*& cursor, const MdlSkinTriangleList& skinTriangles, const MdlSkinVertexList& skinVertices, const size_t skinWidth, const size_t skinHeight, const Vec3f& origin, const Vec3f& scale) {
+        Assets::MdlFrame* MdlParser::parseFrame(const char* cursor, const MdlSkinTriangleList& skinTriangles, const MdlSkinVertexList& skinVertices, const size_t skinWidth, const size_t skinHeight, const Vec3f& origin, const Vec3f& scale) {
             char name[MdlLayout::SimpleFrameLength + 1];
             name[MdlLayout::SimpleFrameLength] = 0;
             cursor += MdlLayout::SimpleFrameName;
@@ -374,7 +453,7 @@ namespace TrenchBroom {
             return new Assets::MdlFrame(String(name), frameTriangles, bounds);
         }
 
-        Vec3f MdlParser::unpackFrameVertex(const PackedFrameVertex& vertex, const Vec3f& origin, const Vec3f& scale) const {
+        Vec3f MdlParser::unpackFrameVertex(const PackedFrameVertex& vertex, const Vec3f& origin, const Vec3f& scale) {
             Vec3f result;
             for (size_t i = 0; i < 3; ++i)
                 result[i] = origin[i] + scale[i]*static_cast<float>(vertex[i]);
@@ -25,13 +25,14 @@
 #include "ByteBuffer.h"
 #include "Assets/AssetTypes.h"
 #include "IO/EntityModelParser.h"
+#include "IO/MappedFile.h"
 
 #include <vector>
 
 namespace TrenchBroom {
     namespace Assets {
-        class MdlModel;
         class MdlFrame;
+        class MdlSkin;
         class Palette;
     }
     
@@ -55,22 +56,27 @@ namespace TrenchBroom {
             typedef std::vector<MdlSkinTriangle> MdlSkinTriangleList;
             typedef Vec<unsigned char, 4> PackedFrameVertex;
             typedef std::vector<PackedFrameVertex> PackedFrameVertexList;
+            typedef std::vector<Assets::MdlSkin*> SkinList;
+            typedef std::vector<const char*> FrameOffsetList;
+            
+            class FrameSource;
             
             String m_name;
+            MappedFile::Ptr m_file;
             const char* m_begin;
             const char* m_end;
             const Assets::Palette& m_palette;
         public:
-            MdlParser(const String& name, const char* begin, const char* end, const Assets::Palette& palette);
+            MdlParser(const String& name, MappedFile::Ptr file, const Assets::Palette& palette);
         private:
             Assets::EntityModel* doParseModel() override;
             
-            void parseSkins(const char*& cursor, Assets::MdlModel& model, const size_t count, const size_t width, const size_t height);
+            SkinList parseSkins(const char*& cursor, const size_t count, const size_t width, const size_t height);
             MdlSkinVertexList parseSkinVertices(const char*& cursor, const size_t count);
             MdlSkinTriangleList parseSkinTriangles(const char*& cursor, const size_t count);
-            void parseFrames(const char*& cursor, Assets::MdlModel& model, const size_t count, const MdlSkinTriangleList& skinTriangles, const MdlSkinVertexList& skinVertices, const size_t skinWidth, const size_t skinHeight, const Vec3f& origin, const Vec3f& scale);
-            Assets::MdlFrame* parseFrame(const char*& cursor, const MdlSkinTriangleList& skinTriangles, const MdlSkinVertexList& skinVertices, const size_t skinWidth, const size_t skinHeight, const Vec3f& origin, const Vec3f& scale);
-            Vec3f unpackFrameVertex(const PackedFrameVertex& vertex, const Vec3f& origin, const Vec3f& scale) const;
+            FrameOffsetList parseFrameOffsets(const char*& cursor, const size_t count, const size_t frameVertexCount);
+            static Assets::MdlFrame* parseFrame(const char* cursor, const MdlSkinTriangleList& skinTriangles, const MdlSkinVertexList& skinVertices, const size_t skinWidth, const size_t skinHeight, const Vec3f& origin, const Vec3f& scale);
+            static Vec3f unpackFrameVertex(const PackedFrameVertex& vertex, const Vec3f& origin, const Vec3f& scale);
         };
     }
 }
@@ -46,6 +46,12 @@ namespace TrenchBroom {
             void warn(size_t line, const String& str);
             void error(size_t line, const String& str);
             void errorAndThrow(size_t line, const String& str);
+            
+            /**
+             * Logs a message which another parser status has already built, e.g. to replay the messages of a parser
+             * whose result was cached.
+             */
+            void replay(Logger::LogLevel level, const String& message);
         private:
             void log(Logger::LogLevel level, size_t line, size_t column, const String& str);
             String buildMessage(size_t line, size_t column, const String& str) const;
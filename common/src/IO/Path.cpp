@@ -28,6 +28,7 @@
 namespace TrenchBroom {
     namespace IO {
         const Path::List Path::EmptyList = Path::List(0);
+        const char Path::InternalSeparator;
 
         char Path::separator() {
 #ifdef _WIN32
@@ -44,27 +45,58 @@ namespace TrenchBroom {
         }
 
         Path::Path(bool absolute, const StringList& components) :
-        m_components(components),
-        m_absolute(absolute) {}
+        m_absolute(absolute),
+        m_hash(0) {
+            m_offsets.reserve(components.size());
+            for (const String& component : components)
+                appendComponent(component.data(), component.data() + component.size());
+            updateHash();
+        }
+        
+        Path::Path(bool absolute, const String& path, const OffsetList& offsets) :
+        m_path(path),
+        m_offsets(offsets),
+        m_absolute(absolute),
+        m_hash(0) {
+            updateHash();
+        }
 
-        Path::Path(const String& path) {
+        Path::Path(const String& path) :
+        m_absolute(false),
+        m_hash(0) {
             const String trimmed = StringUtils::trim(path);
-            m_components = StringUtils::split(trimmed, separators());
+            
+            // leading and trailing separators are ignored, but consecutive separators yield empty components
+            const size_t first = trimmed.find_first_not_of(separators());
+            if (first != String::npos) {
+                const size_t last = trimmed.find_last_not_of(separators());
+                size_t begin = first;
+                while (begin <= last) {
+                    const size_t end = std::min(trimmed.find_first_of(separators(), begin), last + 1);
+                    appendComponent(trimmed.data() + begin, trimmed.data() + end);
+                    begin = end + 1;
+                }
+            }
+            
 #ifdef _WIN32
-            m_absolute = (hasDriveSpec(m_components) ||
+            m_absolute = (hasDriveSpec() ||
                           (!trimmed.empty() && trimmed[0] == '/') ||
                           (!trimmed.empty() && trimmed[0] == '\\'));
 #else
             m_absolute = !trimmed.empty() && trimmed[0] == separator();
 #endif
+            updateHash();
         }
 
         Path Path::operator+(const Path& rhs) const {
             if (rhs.isAbsolute())
                 throw PathException("Cannot concatenate absolute path");
-            StringList components = m_components;
-            components.insert(std::end(components), std::begin(rhs.m_components), std::end(rhs.m_components));
-            return Path(m_absolute, components);
+            Path result(*this);
+            result.m_offsets.reserve(length() + rhs.length());
+            for (size_t i = 0; i < rhs.length(); ++i)
+                result.appendComponent(rhs.componentBegin(i), rhs.componentEnd(i));
+            result.updateHash();
+            return result;
         }
 
         int Path::compare(const Path& rhs) const {
@@ -73,28 +105,31 @@ namespace TrenchBroom {
             if (isAbsolute() && !rhs.isAbsolute())
                 return 1;
             
-            const StringList& rcomps = rhs.m_components;
-            
             size_t i = 0;
-            const size_t max = std::min(m_components.size(), rcomps.size());
+            const size_t max = std::min(length(), rhs.length());
             while (i < max) {
-                const String& mcomp = m_components[i];
-                const String& rcomp = rcomps[i];
-                const int result = mcomp.compare(rcomp);
+                const size_t mlen = static_cast<size_t>(componentEnd(i) - componentBegin(i));
+                const size_t rlen = static_cast<size_t>(rhs.componentEnd(i) - rhs.componentBegin(i));
+                int result = std::char_traits<char>::compare(componentBegin(i), rhs.componentBegin(i), std::min(mlen, rlen));
+                if (result == 0)
+                    result = mlen < rlen ? -1 : (mlen > rlen ? 1 : 0);
                 if (result < 0)
                     return -1;
                 if (result > 0)
                     return 1;
                 ++i;
             }
-            if (m_components.size() < rcomps.size())
+            if (length() < rhs.length())
                 return -1;
-            if (m_components.size() > rcomps.size())
+            if (length() > rhs.length())
                 return 1;
             return 0;
         }
 
         bool Path::operator==(const Path& rhs) const {
+            // equal paths always have equal hashes
+            if (m_hash != rhs.m_hash)
+                return false;
             return compare(rhs) == 0;
         }
 
@@ -110,32 +145,43 @@ namespace TrenchBroom {
             return compare(rhs) > 0;
         }
 
+        size_t Path::hash() const {
+            return m_hash;
+        }
+
         String Path::asString(const char separator) const {
+            String result = m_path;
+            if (separator != InternalSeparator)
+                std::replace(std::begin(result), std::end(result), InternalSeparator, separator);
             if (m_absolute) {
 #ifdef _WIN32
-                if (hasDriveSpec(m_components))
-                    return StringUtils::join(m_components, separator);
+                if (hasDriveSpec())
+                    return result;
                 else
-                    return separator + StringUtils::join(m_components, separator);
+                    return separator + result;
 #else
-                return separator + StringUtils::join(m_components, separator);
+                return separator + result;
 #endif
             }
-            return StringUtils::join(m_components, separator);
+            return result;
         }
 
         String Path::asString(const String& separator) const {
+            if (separator.size() == 1)
+                return asString(separator[0]);
+            
+            const StringList components = this->components();
             if (m_absolute) {
 #ifdef _WIN32
-                if (hasDriveSpec(m_components))
-                    return StringUtils::join(m_components, separator);
+                if (hasDriveSpec())
+                    return StringUtils::join(components, separator);
                 else
-                    return separator + StringUtils::join(m_components, separator);
+                    return separator + StringUtils::join(components, separator);
 #else
-                return separator + StringUtils::join(m_components, separator);
+                return separator + StringUtils::join(components, separator);
 #endif
             }
-            return StringUtils::join(m_components, separator);
+            return StringUtils::join(components, separator);
         }
 
         StringList Path::asStrings(const Path::List& paths, const char separator) {
@@ -155,21 +201,21 @@ namespace TrenchBroom {
         }
 
         size_t Path::length() const {
-            return m_components.size();
+            return m_offsets.size();
         }
 
         bool Path::isEmpty() const {
-            return !m_absolute && m_components.empty();
+            return !m_absolute && m_offsets.empty();
         }
 
         Path Path::firstComponent() const {
             if (isEmpty())
                 throw PathException("Cannot return first component of empty path");
             if (!m_absolute)
-                return Path(m_components.front());
+                return Path(component(0));
 #ifdef _WIN32
-            if (hasDriveSpec(m_components))
-                return Path(m_components.front());
+            if (hasDriveSpec())
+                return Path(component(0));
             return Path("\\");
 #else
             return Path("/");
@@ -179,30 +225,22 @@ namespace TrenchBroom {
         Path Path::deleteFirstComponent() const {
             if (isEmpty())
                 throw PathException("Cannot delete first component of empty path");
-            if (!m_absolute) {
-                StringList components;
-                components.reserve(m_components.size() - 1);
-                components.insert(std::begin(components), std::begin(m_components) + 1, std::end(m_components));
-                return Path(false, components);
-            }
+            if (!m_absolute)
+                return slice(false, 1, length() - 1);
 #ifdef _WIN32
-            if (!m_components.empty() && hasDriveSpec(m_components[0])) {
-                StringList components;
-                components.reserve(m_components.size() - 1);
-                components.insert(std::begin(components), std::begin(m_components) + 1, std::end(m_components));
-                return Path(false, components);
-            }
-            return Path(false, m_components);
+            if (hasDriveSpec())
+                return slice(false, 1, length() - 1);
+            return slice(false, 0, length());
 #else
-            return Path(false, m_components);
+            return slice(false, 0, length());
 #endif
         }
 
         Path Path::lastComponent() const {
             if (isEmpty())
                 throw PathException("Cannot return last component of empty path");
-            if (!m_components.empty()) {
-                return Path(m_components.back());
+            if (!m_offsets.empty()) {
+                return Path(component(length() - 1));
             } else {
                 return Path("");
             }
@@ -211,13 +249,10 @@ namespace TrenchBroom {
         Path Path::deleteLastComponent() const {
             if (isEmpty())
                 throw PathException("Cannot delete last component of empty path");
-            if (!m_components.empty()) {
-                StringList components;
-                components.reserve(m_components.size() - 1);
-                components.insert(std::begin(components), std::begin(m_components), std::end(m_components) - 1);
-                return Path(m_absolute, components);
+            if (!m_offsets.empty()) {
+                return slice(m_absolute, 0, length() - 1);
             } else {
-                return Path(m_absolute, m_components);
+                return *this;
             }
         }
 
@@ -226,31 +261,24 @@ namespace TrenchBroom {
         }
         
         Path Path::suffix(const size_t count) const {
-            return subPath(m_components.size() - count, count);
+            return subPath(length() - count, count);
         }
         
         Path Path::subPath(const size_t index, const size_t count) const {
-            if (index + count > m_components.size())
+            if (index + count > length())
                 throw PathException("Sub path out of bounds");
             if (count == 0)
                 return Path("");
-            
-            auto begin = std::begin(m_components);
-            std::advance(begin, static_cast<StringList::const_iterator::difference_type>(index));
-            auto end = begin;
-            std::advance(end, static_cast<StringList::const_iterator::difference_type>(count));
-            StringList newComponents(count);
-            std::copy(begin, end, std::begin(newComponents));
-            return Path(m_absolute && index == 0, newComponents);
+            return slice(m_absolute && index == 0, index, count);
         }
 
         String Path::filename() const {
             if (isEmpty())
                 throw PathException("Cannot get filename of empty path");
-            if (m_components.empty()) {
+            if (m_offsets.empty()) {
                 return "";
             } else {
-                return m_components.back();
+                return component(length() - 1);
             }
         }
         
@@ -281,17 +309,21 @@ namespace TrenchBroom {
         Path Path::addExtension(const String& extension) const {
             if (isEmpty())
                 throw PathException("Cannot add extension to empty path");
-            auto components = m_components;
-            if (components.empty()
+            
+            const String dotExtension = "." + extension;
+            Path result(*this);
+            if (m_offsets.empty()
 #ifdef _WIN32
-				|| hasDriveSpec(m_components.back())
+				|| hasDriveSpec(component(length() - 1))
 #endif
 				) {
-                components.push_back("." + extension);
+                result.appendComponent(dotExtension.data(), dotExtension.data() + dotExtension.size());
             } else {
-                components.back() += "." + extension;
+                // the last component is at the end of the buffer
+                result.m_path += dotExtension;
             }
-            return Path(m_absolute, components);
+            result.updateHash();
+            return result;
         }
 
         Path Path::replaceExtension(const String& extension) const {
@@ -307,9 +339,9 @@ namespace TrenchBroom {
                     isAbsolute() && absolutePath.isAbsolute()
 #ifdef _WIN32
                     && 
-                    !m_components.empty() && !absolutePath.m_components.empty()
+                    !m_offsets.empty() && !absolutePath.m_offsets.empty()
                     &&
-                    m_components[0] == absolutePath.m_components[0]
+                    component(0) == absolutePath.component(0)
 #endif
             );
         }
@@ -333,16 +365,16 @@ namespace TrenchBroom {
                 throw PathException("Cannot make relative path with relative sub path");
 
 #ifdef _WIN32
-            if (m_components.empty())
+            if (m_offsets.empty())
                 throw PathException("Cannot make relative path from an reference path with no drive spec");
-            if (absolutePath.m_components.empty())
+            if (absolutePath.m_offsets.empty())
                 throw PathException("Cannot make relative path with sub path with no drive spec");
-            if (m_components[0] != absolutePath.m_components[0])
+            if (component(0) != absolutePath.component(0))
                 throw PathException("Cannot make relative path if reference path has different drive spec");
 #endif
             
-            const StringList myResolved = resolvePath(true, m_components);
-            const StringList theirResolved = resolvePath(true, absolutePath.m_components);
+            const StringList myResolved = resolvePath(true, components());
+            const StringList theirResolved = resolvePath(true, absolutePath.components());
             
             // cross off all common prefixes
             size_t p = 0;
@@ -362,15 +394,14 @@ namespace TrenchBroom {
         }
 
         Path Path::makeCanonical() const {
-            return Path(m_absolute, resolvePath(m_absolute, m_components));
+            return Path(m_absolute, resolvePath(m_absolute, components()));
         }
 
         Path Path::makeLowerCase() const {
-            StringList lcComponents;
-            lcComponents.reserve(m_components.size());
-            std::transform(std::begin(m_components), std::end(m_components), std::back_inserter(lcComponents),
-                           [](const String& component) { return StringUtils::toLower(component); });
-            return Path(m_absolute, lcComponents);
+            // the hash is computed from the case folded components, so it remains valid
+            Path result(*this);
+            result.m_path = StringUtils::toLower(m_path);
+            return result;
         }
 
         Path::List Path::makeAbsoluteAndCanonical(const List& paths, const Path& relativePath) {
@@ -381,11 +412,69 @@ namespace TrenchBroom {
             return result;
         }
 
-        bool Path::hasDriveSpec(const StringList& components) {
+        const char* Path::componentBegin(const size_t index) const {
+            assert(index < m_offsets.size());
+            return m_path.data() + m_offsets[index];
+        }
+        
+        const char* Path::componentEnd(const size_t index) const {
+            assert(index < m_offsets.size());
+            if (index + 1 < m_offsets.size())
+                return m_path.data() + m_offsets[index + 1] - 1;
+            return m_path.data() + m_path.size();
+        }
+        
+        String Path::component(const size_t index) const {
+            return String(componentBegin(index), componentEnd(index));
+        }
+        
+        StringList Path::components() const {
+            StringList result;
+            result.reserve(length());
+            for (size_t i = 0; i < length(); ++i)
+                result.push_back(component(i));
+            return result;
+        }
+        
+        Path Path::slice(const bool absolute, const size_t index, const size_t count) const {
+            assert(index + count <= length());
+            if (count == 0)
+                return Path(absolute, String(), OffsetList());
+            
+            const size_t begin = m_offsets[index];
+            const size_t end = static_cast<size_t>(componentEnd(index + count - 1) - m_path.data());
+            
+            OffsetList offsets;
+            offsets.reserve(count);
+            for (size_t i = index; i < index + count; ++i)
+                offsets.push_back(m_offsets[i] - begin);
+            return Path(absolute, m_path.substr(begin, end - begin), offsets);
+        }
+        
+        void Path::appendComponent(const char* begin, const char* end) {
+            if (!m_offsets.empty())
+                m_path.push_back(InternalSeparator);
+            m_offsets.push_back(m_path.size());
+            m_path.append(begin, end);
+        }
+        
+        void Path::updateHash() {
+            // only ASCII letters are folded, just like CaseInsensitiveCharCompare does in the classic locale
+            size_t hash = m_absolute ? 1 : 0;
+            for (const char c : m_path) {
+                const char folded = (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+                hash = hash * 31 + static_cast<unsigned char>(folded);
+            }
+            
+            // distinguishes a path with a single empty component from a path without any components
+            m_hash = hash * 31 + m_offsets.size();
+        }
+
+        bool Path::hasDriveSpec() const {
 #ifdef _WIN32
-            if (components.empty())
+            if (m_offsets.empty())
                 return false;
-            return hasDriveSpec(components[0]);
+            return componentEnd(0) - componentBegin(0) > 1 && componentBegin(0)[1] == ':';
 #else
             return false;
 #endif
@@ -22,10 +22,18 @@
 
 #include "StringUtils.h"
 
+#include <algorithm>
 #include <vector>
 
 namespace TrenchBroom {
     namespace IO {
+        /**
+         * A path is a sequence of components which may be absolute or relative. To keep paths cheap to create, copy
+         * and compare, the components are not stored as individual strings, but in a single buffer, separated by a
+         * slash, together with the offsets at which each component starts. Additionally, every path keeps a hash of
+         * its case folded components so that paths can be used as keys in hash maps, and so that unequal paths can
+         * usually be told apart without comparing them character by character.
+         */
         class Path {
         public:
             typedef std::vector<Path> List;
@@ -48,17 +56,35 @@ namespace TrenchBroom {
                 StringLess m_less;
             public:
                 bool operator()(const Path& lhs, const Path& rhs) const {
-                    return std::lexicographical_compare(std::begin(lhs.m_components), std::end(lhs.m_components),
-                                                        std::begin(rhs.m_components), std::end(rhs.m_components), m_less);
+                    const size_t count = std::min(lhs.length(), rhs.length());
+                    for (size_t i = 0; i < count; ++i) {
+                        if (m_less(lhs.componentBegin(i), lhs.componentEnd(i), rhs.componentBegin(i), rhs.componentEnd(i)))
+                            return true;
+                        if (m_less(rhs.componentBegin(i), rhs.componentEnd(i), lhs.componentBegin(i), lhs.componentEnd(i)))
+                            return false;
+                    }
+                    return lhs.length() < rhs.length();
+                }
+            };
+            
+            struct Hash {
+                size_t operator()(const Path& path) const {
+                    return path.hash();
                 }
             };
         private:
+            typedef std::vector<size_t> OffsetList;
+            
+            static const char InternalSeparator = '/';
             static const String& separators();
             
-            StringList m_components;
+            String m_path;
+            OffsetList m_offsets;
             bool m_absolute;
+            size_t m_hash;
             
             Path(bool absolute, const StringList& components);
+            Path(bool absolute, const String& path, const OffsetList& offsets);
         public:
             explicit Path(const String& path = "");
             
@@ -69,6 +95,8 @@ namespace TrenchBroom {
             bool operator<(const Path& rhs) const;
             bool operator>(const Path& rhs) const;
             
+            size_t hash() const;
+            
             String asString(const char sep = separator()) const;
             String asString(const String& sep) const;
             static StringList asStrings(const Path::List& paths, const char sep = separator());
@@ -99,7 +127,15 @@ namespace TrenchBroom {
             
             static List makeAbsoluteAndCanonical(const List& paths, const Path& relativePath);
         private:
-            static bool hasDriveSpec(const StringList& components);
+            const char* componentBegin(const size_t index) const;
+            const char* componentEnd(const size_t index) const;
+            String component(const size_t index) const;
+            StringList components() const;
+            Path slice(const bool absolute, const size_t index, const size_t count) const;
+            void appendComponent(const char* begin, const char* end);
+            void updateHash();
+            
+            bool hasDriveSpec() const;
             static bool hasDriveSpec(const String& component);
             StringList resolvePath(const bool absolute, const StringList& components) const;
         };
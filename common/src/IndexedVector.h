@@ -0,0 +1,125 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_IndexedVector_h
+#define TrenchBroom_IndexedVector_h
+
+#include <cassert>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * A vector of unique items that keeps the index of each item in a hash map, so that items can be added, found and
+ * removed in constant time. Removing an item moves the last item into its place, so the order of the items is not
+ * preserved.
+ */
+template <typename T, typename H = std::hash<T> >
+class IndexedVector {
+public:
+    typedef std::vector<T> List;
+    typedef typename List::const_iterator const_iterator;
+private:
+    typedef std::unordered_map<T, size_t, H> IndexMap;
+
+    List m_items;
+    IndexMap m_indices;
+public:
+    IndexedVector() {}
+
+    template <typename I>
+    IndexedVector(I cur, I end) {
+        insert(cur, end);
+    }
+
+    const_iterator begin() const {
+        return std::begin(m_items);
+    }
+
+    const_iterator end() const {
+        return std::end(m_items);
+    }
+
+    bool empty() const {
+        return m_items.empty();
+    }
+
+    size_t size() const {
+        return m_items.size();
+    }
+
+    const List& items() const {
+        return m_items;
+    }
+
+    bool contains(const T& item) const {
+        return m_indices.count(item) > 0;
+    }
+
+    /**
+     * Adds the given item unless it is already contained.
+     *
+     * @param item the item to add
+     * @return true if the item was added and false otherwise
+     */
+    bool insert(const T& item) {
+        if (!m_indices.insert(std::make_pair(item, m_items.size())).second)
+            return false;
+        m_items.push_back(item);
+        return true;
+    }
+
+    template <typename I>
+    void insert(I cur, I end) {
+        while (cur != end) {
+            insert(*cur);
+            ++cur;
+        }
+    }
+
+    /**
+     * Removes the given item by moving the last item into its place.
+     *
+     * @param item the item to remove
+     * @return true if the item was removed and false if it was not contained
+     */
+    bool erase(const T& item) {
+        auto it = m_indices.find(item);
+        if (it == std::end(m_indices))
+            return false;
+
+        const size_t index = it->second;
+        m_indices.erase(it);
+
+        if (index < m_items.size() - 1) {
+            m_items[index] = m_items.back();
+            m_indices[m_items[index]] = index;
+        }
+        m_items.pop_back();
+
+        assert(m_items.size() == m_indices.size());
+        return true;
+    }
+
+    void clear() {
+        m_items.clear();
+        m_indices.clear();
+    }
+};
+
+#endif /* defined(TrenchBroom_IndexedVector_h) */
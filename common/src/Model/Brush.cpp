@@ -759,17 +759,20 @@ namespace TrenchBroom {
             ensure(!vertexPositions.empty(), "no vertex positions");
             assert(canMoveVertices(worldBounds, vertexPositions, delta));
 
-            BrushGeometry newGeometry;
             Vec3::Set vertexSet(std::begin(vertexPositions), std::end(vertexPositions));
+            Vec3::List newPositions;
+            newPositions.reserve(m_geometry->vertexCount());
 
             for (BrushVertex* vertex : m_geometry->vertices()) {
                 const Vec3& position = vertex->position();
                 if (vertexSet.count(position) > 0)
-                    newGeometry.addPoint(position + delta);
+                    newPositions.push_back(position + delta);
                 else
-                    newGeometry.addPoint(position);
+                    newPositions.push_back(position);
             }
 
+            BrushGeometry newGeometry(newPositions);
+
             Vec3::List result;
             Vec3::Map vertexMapping;
             for (BrushVertex* vertex : m_geometry->vertices()) {
@@ -830,42 +833,49 @@ namespace TrenchBroom {
             ensure(!vertexPositions.empty(), "no vertex positions");
             assert(canRemoveVertices(worldBounds, vertexPositions));
 
-            BrushGeometry newGeometry;
             const Vec3::Set vertexSet(std::begin(vertexPositions), std::end(vertexPositions));
+            Vec3::List newPositions;
+            newPositions.reserve(m_geometry->vertexCount());
 
             for (const BrushVertex* vertex : m_geometry->vertices()) {
                 const Vec3& position = vertex->position();
                 if (vertexSet.count(position) == 0)
-                    newGeometry.addPoint(position);
+                    newPositions.push_back(position);
             }
 
+            BrushGeometry newGeometry(newPositions);
+
             const PolyhedronMatcher<BrushGeometry> matcher(*m_geometry, newGeometry);
             doSetNewGeometry(worldBounds, matcher, newGeometry);
         }
 
         bool Brush::canSnapVertices(const BBox3& worldBounds, const FloatType snapToF) {
-            BrushGeometry newGeometry;
+            Vec3::List newPositions;
+            newPositions.reserve(m_geometry->vertexCount());
 
             for (const BrushVertex* vertex : m_geometry->vertices()) {
                 const Vec3& origin = vertex->position();
-                const Vec3 destination = snapToF * (origin / snapToF).rounded();
-                newGeometry.addPoint(destination);
+                newPositions.push_back(snapToF * (origin / snapToF).rounded());
             }
 
+            const BrushGeometry newGeometry(newPositions);
+
             return newGeometry.polyhedron();
         }
 
         void Brush::snapVertices(const BBox3& worldBounds, const FloatType snapToF) {
             ensure(m_geometry != nullptr, "geometry is null");
 
-            BrushGeometry newGeometry;
+            Vec3::List newPositions;
+            newPositions.reserve(m_geometry->vertexCount());
 
             for (const BrushVertex* vertex : m_geometry->vertices()) {
                 const Vec3& origin = vertex->position();
-                const Vec3 destination = snapToF * (origin / snapToF).rounded();
-                newGeometry.addPoint(destination);
+                newPositions.push_back(snapToF * (origin / snapToF).rounded());
             }
 
+            BrushGeometry newGeometry(newPositions);
+
             Vec3::Map vertexMapping;
             for (const BrushVertex* vertex : m_geometry->vertices()) {
                 const Vec3& origin = vertex->position();
@@ -1003,16 +1013,18 @@ namespace TrenchBroom {
             }
 
             BrushGeometry moving(*m_geometry);
-            BrushGeometry result;
+            Vec3::List resultPositions;
+            resultPositions.reserve(m_geometry->vertexCount());
             for (const BrushVertex* vertex : m_geometry->vertices()) {
                 const Vec3& position = vertex->position();
                 if (vertexSet.count(position) == 0) {
                     moving.removeVertexByPosition(position);
-                    result.addPoint(position);
+                    resultPositions.push_back(position);
                 } else {
-                    result.addPoint(position + delta);
+                    resultPositions.push_back(position + delta);
                 }
             }
+            const BrushGeometry result(resultPositions);
 
             assert(remaining.vertexCount() + moving.vertexCount() == vertexCount());
 
@@ -1080,12 +1092,18 @@ namespace TrenchBroom {
         }
 
         BrushList Brush::subtract(const ModelFactory& factory, const BBox3& worldBounds, const String& defaultTextureName, const Brush* subtrahend) const {
-            const BrushGeometry::SubtractResult result = m_geometry->subtract(*subtrahend->m_geometry);
-
+            return createBrushes(factory, worldBounds, defaultTextureName, subtractGeometry(subtrahend), subtrahend);
+        }
+        
+        BrushGeometry::SubtractResult Brush::subtractGeometry(const Brush* subtrahend) const {
+            return m_geometry->subtract(*subtrahend->m_geometry);
+        }
+        
+        BrushList Brush::createBrushes(const ModelFactory& factory, const BBox3& worldBounds, const String& defaultTextureName, const BrushGeometry::SubtractResult& fragments, const Brush* subtrahend) const {
             BrushList brushes(0);
-            brushes.reserve(result.size());
+            brushes.reserve(fragments.size());
 
-            for (const BrushGeometry& geometry : result) {
+            for (const BrushGeometry& geometry : fragments) {
                 Brush* brush = createBrush(factory, worldBounds, defaultTextureName, geometry, subtrahend);
                 brushes.push_back(brush);
             }
@@ -200,6 +200,15 @@ namespace TrenchBroom {
         public:
             // CSG operations
             BrushList subtract(const ModelFactory& factory, const BBox3& worldBounds, const String& defaultTextureName, const Brush* subtrahend) const;
+            
+            /**
+             * Splits subtracting the given brush from this brush into computing the fragment geometries, which only
+             * reads both brushes and may therefore run concurrently for different minuends, and creating the fragment
+             * brushes, which must happen on the thread that owns the textures.
+             */
+            BrushGeometry::SubtractResult subtractGeometry(const Brush* subtrahend) const;
+            BrushList createBrushes(const ModelFactory& factory, const BBox3& worldBounds, const String& defaultTextureName, const BrushGeometry::SubtractResult& fragments, const Brush* subtrahend) const;
+            
             void intersect(const BBox3& worldBounds, const Brush* brush);
         private:
             Brush* createBrush(const ModelFactory& factory, const BBox3& worldBounds, const String& defaultTextureName, const BrushGeometry& geometry, const Brush* subtrahend) const;
@@ -50,5 +50,13 @@ namespace TrenchBroom {
         bool BrushContentType::evaluate(const Brush* brush) const {
             return m_evaluator->evaluate(brush);
         }
+
+        bool BrushContentType::evaluatesFaces() const {
+            return m_evaluator->evaluatesFaces();
+        }
+        
+        bool BrushContentType::evaluate(const BrushFace* face) const {
+            return m_evaluator->evaluate(face);
+        }
     }
 }
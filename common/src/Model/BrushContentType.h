@@ -50,6 +50,8 @@ namespace TrenchBroom {
             FlagType flagValue() const;
             
             bool evaluate(const Brush* brush) const;
+            bool evaluatesFaces() const;
+            bool evaluate(const BrushFace* face) const;
         };
     }
 }
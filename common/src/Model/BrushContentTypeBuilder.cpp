@@ -19,28 +19,77 @@
 
 #include "BrushContentTypeBuilder.h"
 
+#include "Model/Brush.h"
+#include "Model/BrushFace.h"
+
+#include <algorithm>
+
 namespace TrenchBroom {
     namespace Model {
+        const size_t BrushContentTypeBuilder::MaxFaceContentTypes;
+
         BrushContentTypeBuilder::Result::Result(const BrushContentType::FlagType i_contentType, const bool i_transparent) :
         contentType(i_contentType),
         transparent(i_transparent) {}
 
+        size_t BrushContentTypeBuilder::FaceKeyHash::operator()(const FaceKey& key) const {
+            const size_t h1 = std::hash<String>()(key.first);
+            const size_t h2 = std::hash<int>()(key.second);
+            return h1 ^ (h2 + 0x9e3779b9 + (h1 << 6) + (h1 >> 2));
+        }
+
         BrushContentTypeBuilder::BrushContentTypeBuilder(const BrushContentType::List& contentTypes) :
-        m_contentTypes(contentTypes) {}
+        m_contentTypes(contentTypes),
+        m_faceContentTypes(0) {
+            for (size_t i = 0; i < std::min(m_contentTypes.size(), MaxFaceContentTypes); ++i) {
+                if (m_contentTypes[i].evaluatesFaces())
+                    m_faceContentTypes |= (FaceMask(1) << i);
+            }
+        }
         
         BrushContentTypeBuilder::Result BrushContentTypeBuilder::buildContentType(const Brush* brush) const {
+            // a face based content type matches if it matches every face
+            FaceMask faceContentTypes = m_faceContentTypes;
+            const BrushFaceList& faces = brush->faces();
+            for (auto it = std::begin(faces), end = std::end(faces); it != end && faceContentTypes != 0; ++it)
+                faceContentTypes &= faceMask(*it);
+            
             BrushContentType::FlagType flags = 0;
             bool transparent = false;
             
-            BrushContentType::List::const_iterator it, end;
-            for (it = std::begin(m_contentTypes), end = std::end(m_contentTypes); it != end; ++it) {
-                const BrushContentType& contentType = *it;
-                if (contentType.evaluate(brush)) {
+            for (size_t i = 0; i < m_contentTypes.size(); ++i) {
+                const BrushContentType& contentType = m_contentTypes[i];
+                const FaceMask bit = i < MaxFaceContentTypes ? (FaceMask(1) << i) : 0;
+                
+                const bool matches = (m_faceContentTypes & bit) != 0 ? (faceContentTypes & bit) != 0 : contentType.evaluate(brush);
+                if (matches) {
                     flags |= contentType.flagValue();
                     transparent |= contentType.transparent();
                 }
             }
             return Result(flags, transparent);
         }
+
+        BrushContentTypeBuilder::FaceMask BrushContentTypeBuilder::faceMask(const BrushFace* face) const {
+            const FaceKey key(face->textureName(), face->surfaceContents());
+            
+            FaceMaskCache::const_iterator it = m_faceMasks.find(key);
+            if (it != std::end(m_faceMasks))
+                return it->second;
+            
+            const FaceMask mask = evaluateFace(face);
+            m_faceMasks.insert(std::make_pair(key, mask));
+            return mask;
+        }
+        
+        BrushContentTypeBuilder::FaceMask BrushContentTypeBuilder::evaluateFace(const BrushFace* face) const {
+            FaceMask mask = 0;
+            for (size_t i = 0; i < std::min(m_contentTypes.size(), MaxFaceContentTypes); ++i) {
+                const FaceMask bit = FaceMask(1) << i;
+                if ((m_faceContentTypes & bit) != 0 && m_contentTypes[i].evaluate(face))
+                    mask |= bit;
+            }
+            return mask;
+        }
     }
 }
@@ -24,8 +24,21 @@
 #include "Model/BrushContentType.h"
 #include "Model/ModelTypes.h"
 
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+
 namespace TrenchBroom {
     namespace Model {
+        /**
+         * Determines the content types of brushes.
+         *
+         * Most content types match a brush if they match all of its faces, and whether they match a face only
+         * depends on the face's texture name and content flags. For these content types, the results are cached per
+         * distinct combination of texture name and content flags, so that each texture is only matched once against
+         * the patterns of the content types. Content types are only built on the thread that owns the map, so the
+         * cache is not synchronized.
+         */
         class BrushContentTypeBuilder {
         public:
             struct Result {
@@ -34,10 +47,26 @@ namespace TrenchBroom {
                 Result(BrushContentType::FlagType i_contentType, bool i_transparent);
             };
         private:
+            // bit i is set if the face based content type at index i matches
+            typedef uint64_t FaceMask;
+            static const size_t MaxFaceContentTypes = 64;
+            
+            typedef std::pair<String, int> FaceKey;
+            struct FaceKeyHash {
+                size_t operator()(const FaceKey& key) const;
+            };
+            typedef std::unordered_map<FaceKey, FaceMask, FaceKeyHash> FaceMaskCache;
+            
             BrushContentType::List m_contentTypes;
+            FaceMask m_faceContentTypes;
+            
+            mutable FaceMaskCache m_faceMasks;
         public:
             BrushContentTypeBuilder(const BrushContentType::List& contentTypes = BrushContentType::EmptyList);
             Result buildContentType(const Brush* brush) const;
+        private:
+            FaceMask faceMask(const BrushFace* face) const;
+            FaceMask evaluateFace(const BrushFace* face) const;
         };
     }
 }
@@ -41,7 +41,11 @@ namespace TrenchBroom {
                 return true;
             }
             
-            virtual bool doEvaluate(const BrushFace* brush) const = 0;
+            bool doEvaluatesFaces() const override {
+                return true;
+            }
+            
+            bool doEvaluate(const BrushFace* face) const override = 0;
         };
         
         class TextureNameEvaluator : public BrushFaceEvaluator {
@@ -108,5 +112,21 @@ namespace TrenchBroom {
         bool BrushContentTypeEvaluator::evaluate(const Brush* brush) const {
             return doEvaluate(brush);
         }
+
+        bool BrushContentTypeEvaluator::evaluatesFaces() const {
+            return doEvaluatesFaces();
+        }
+        
+        bool BrushContentTypeEvaluator::evaluate(const BrushFace* face) const {
+            return doEvaluate(face);
+        }
+
+        bool BrushContentTypeEvaluator::doEvaluatesFaces() const {
+            return false;
+        }
+        
+        bool BrushContentTypeEvaluator::doEvaluate(const BrushFace* face) const {
+            return false;
+        }
     }
 }
@@ -25,6 +25,7 @@
 namespace TrenchBroom {
     namespace Model {
         class Brush;
+        class BrushFace;
         
         class BrushContentTypeEvaluator {
         public:
@@ -35,8 +36,18 @@ namespace TrenchBroom {
             static BrushContentTypeEvaluator* entityClassnameEvaluator(const String& pattern);
             
             bool evaluate(const Brush* brush) const;
+            
+            /**
+             * Indicates whether this evaluator matches a brush if and only if it matches every face of the brush. The
+             * result of evaluating a face then only depends on the face's texture name and content flags, which
+             * allows callers to cache it.
+             */
+            bool evaluatesFaces() const;
+            bool evaluate(const BrushFace* face) const;
         private:
             virtual bool doEvaluate(const Brush* brush) const = 0;
+            virtual bool doEvaluatesFaces() const;
+            virtual bool doEvaluate(const BrushFace* face) const;
         };
     }
 }
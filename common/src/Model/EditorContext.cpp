@@ -44,6 +44,7 @@ namespace TrenchBroom {
             m_entityLinkMode = EntityLinkMode_Direct;
             m_blockSelection = false;
             m_currentGroup = nullptr;
+            invalidateAllNodes();
         }
 
         bool EditorContext::showPointEntities() const {
@@ -54,6 +55,7 @@ namespace TrenchBroom {
             if (showPointEntities == m_showPointEntities)
                 return;
             m_showPointEntities = showPointEntities;
+            invalidateAllNodes();
             editorContextDidChangeNotifier();
         }
         
@@ -65,6 +67,7 @@ namespace TrenchBroom {
             if (showBrushes == m_showBrushes)
                 return;
             m_showBrushes = showBrushes;
+            invalidateAllNodes();
             editorContextDidChangeNotifier();
         }
         
@@ -76,6 +79,7 @@ namespace TrenchBroom {
             if (brushContentTypes == m_hiddenBrushContentTypes)
                 return;
             m_hiddenBrushContentTypes = brushContentTypes;
+            invalidateAllNodes();
             editorContextDidChangeNotifier();
         }
         
@@ -95,6 +99,7 @@ namespace TrenchBroom {
             if (definition == nullptr || entityDefinitionHidden(definition) == hidden)
                 return;
             m_hiddenEntityDefinitions[definition->index()] = hidden;
+            invalidateAllNodes();
             editorContextDidChangeNotifier();
         }
         
@@ -140,40 +145,115 @@ namespace TrenchBroom {
                 m_currentGroup->open();
         }
 
-        class NodeVisible : public Model::ConstNodeVisitor, public Model::NodeQuery<bool> {
+        void EditorContext::invalidateNodes(const Model::NodeList& nodes) {
+            for (const Model::Node* node : nodes) {
+                invalidateNodeAndDescendants(node);
+                
+                // the visibility of brush entities depends on their children
+                const Model::Node* parent = node->parent();
+                while (parent != nullptr) {
+                    invalidateNode(parent);
+                    parent = parent->parent();
+                }
+            }
+        }
+        
+        void EditorContext::invalidateAllNodes() {
+            m_visibleGenerations.clear();
+            m_editableGenerations.clear();
+        }
+
+        void EditorContext::invalidateNode(const Model::Node* node) {
+            invalidateCache(m_visibleGenerations, node);
+            invalidateCache(m_editableGenerations, node);
+        }
+        
+        void EditorContext::invalidateNodeAndDescendants(const Model::Node* node) {
+            invalidateNode(node);
+            for (const Model::Node* child : node->children())
+                invalidateNodeAndDescendants(child);
+        }
+
+        bool EditorContext::cacheValid(const GenerationList& generations, const Model::Node* node) {
+            const size_t index = node->index();
+            return index < generations.size() && generations[index] == node->generation();
+        }
+        
+        void EditorContext::validateCache(GenerationList& generations, const Model::Node* node) {
+            const size_t index = node->index();
+            if (index >= generations.size())
+                generations.resize(index + 1, 0);
+            generations[index] = node->generation();
+        }
+        
+        void EditorContext::invalidateCache(GenerationList& generations, const Model::Node* node) {
+            const size_t index = node->index();
+            if (index < generations.size())
+                generations[index] = 0;
+        }
+        
+        class EditorContext::NodeVisible : public Model::ConstNodeVisitor, public Model::NodeQuery<bool> {
         private:
             const EditorContext& m_this;
         public:
             NodeVisible(const EditorContext& i_this) : m_this(i_this) {}
         private:
-            void doVisit(const Model::World* world) override   { setResult(m_this.visible(world)); }
-            void doVisit(const Model::Layer* layer) override   { setResult(m_this.visible(layer)); }
-            void doVisit(const Model::Group* group) override   { setResult(m_this.visible(group)); }
-            void doVisit(const Model::Entity* entity) override { setResult(m_this.visible(entity)); }
-            void doVisit(const Model::Brush* brush) override   { setResult(m_this.visible(brush)); }
+            void doVisit(const Model::World* world) override   { setResult(m_this.computeVisible(world)); }
+            void doVisit(const Model::Layer* layer) override   { setResult(m_this.computeVisible(layer)); }
+            void doVisit(const Model::Group* group) override   { setResult(m_this.computeVisible(group)); }
+            void doVisit(const Model::Entity* entity) override { setResult(m_this.computeVisible(entity)); }
+            void doVisit(const Model::Brush* brush) override   { setResult(m_this.computeVisible(brush)); }
         };
         
         bool EditorContext::visible(const Model::Node* node) const {
+            return cachedVisible(node);
+        }
+        
+        bool EditorContext::visible(const Model::World* world) const {
+            return cachedVisible(world);
+        }
+
+        bool EditorContext::visible(const Model::Layer* layer) const {
+            return cachedVisible(layer);
+        }
+        
+        bool EditorContext::visible(const Model::Group* group) const {
+            return cachedVisible(group);
+        }
+        
+        bool EditorContext::visible(const Model::Entity* entity) const {
+            return cachedVisible(entity);
+        }
+        
+        bool EditorContext::visible(const Model::Brush* brush) const {
+            return cachedVisible(brush);
+        }
+        
+        bool EditorContext::visible(const Model::BrushFace* face) const {
+            return visible(face->brush());
+        }
+
+        bool EditorContext::computeVisible(const Model::Node* node) const {
             NodeVisible visitor(*this);
             node->accept(visitor);
             return visitor.result();
         }
         
-        bool EditorContext::visible(const Model::World* world) const {
+        bool EditorContext::computeVisible(const Model::World* world) const {
             return world->visible();
         }
 
-        bool EditorContext::visible(const Model::Layer* layer) const {
+        bool EditorContext::computeVisible(const Model::Layer* layer) const {
             return layer->visible();
         }
         
-        bool EditorContext::visible(const Model::Group* group) const {
+        bool EditorContext::computeVisible(const Model::Group* group) const {
             if (group->selected())
                 return true;
             return group->visible();
         }
         
-        bool EditorContext::visible(const Model::Entity* entity) const {
+        bool EditorContext::computeVisible(const Model::Entity* entity) const {
             if (entity->selected())
                 return true;
             if (entity->brushEntity()) {
@@ -190,7 +270,7 @@ namespace TrenchBroom {
             return true;
         }
         
-        bool EditorContext::visible(const Model::Brush* brush) const {
+        bool EditorContext::computeVisible(const Model::Brush* brush) const {
             if (brush->selected())
                 return true;
             if (!m_showBrushes)
@@ -202,18 +282,19 @@ namespace TrenchBroom {
             return brush->visible();
         }
         
-        bool EditorContext::visible(const Model::BrushFace* face) const {
-            return visible(face->brush());
-        }
-
-        
         bool EditorContext::anyChildVisible(const Model::Node* node) const {
             const Model::NodeList& children = node->children();
             return std::any_of(std::begin(children), std::end(children), [this](const Node* child) { return visible(child); });
         }
         
         bool EditorContext::editable(const Model::Node* node) const {
-            return node->editable();
+            if (cacheValid(m_editableGenerations, node))
+                return static_cast<const Bitset&>(m_editable)[node->index()];
+            
+            const bool result = node->editable();
+            validateCache(m_editableGenerations, node);
+            m_editable[node->index()] = result;
+            return result;
         }
         
         bool EditorContext::editable(const Model::BrushFace* face) const {
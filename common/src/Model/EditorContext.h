@@ -24,6 +24,8 @@
 #include "Model/BrushContentType.h"
 #include "Model/ModelTypes.h"
 
+#include <vector>
+
 namespace TrenchBroom {
     namespace Assets {
         class EntityDefinition;
@@ -48,6 +50,17 @@ namespace TrenchBroom {
             bool m_blockSelection;
             
             Model::Group* m_currentGroup;
+            
+            /*
+             * Caches the visibility and editability of nodes, indexed by Node::index(). Since the indices of destroyed
+             * nodes are reused, a node's cached value is only valid if the corresponding generation list stores the
+             * node's generation at its index.
+             */
+            typedef std::vector<size_t> GenerationList;
+            mutable GenerationList m_visibleGenerations;
+            mutable Bitset m_visible;
+            mutable GenerationList m_editableGenerations;
+            mutable Bitset m_editable;
         public:
             Notifier0 editorContextDidChangeNotifier;
         public:
@@ -77,6 +90,36 @@ namespace TrenchBroom {
             Model::Group* currentGroup() const;
             void pushGroup(Model::Group* group);
             void popGroup();
+        public:
+            /**
+             * Invalidates the cached visibility and editability of the given nodes, their ancestors and their
+             * descendants. Must be called whenever the state of the given nodes changes in a way that may affect
+             * their visibility or editability, e.g., if they are selected or hidden.
+             */
+            void invalidateNodes(const Model::NodeList& nodes);
+            
+            /**
+             * Invalidates the cached visibility and editability of all nodes.
+             */
+            void invalidateAllNodes();
+        private:
+            void invalidateNode(const Model::Node* node);
+            void invalidateNodeAndDescendants(const Model::Node* node);
+            
+            static bool cacheValid(const GenerationList& generations, const Model::Node* node);
+            static void validateCache(GenerationList& generations, const Model::Node* node);
+            static void invalidateCache(GenerationList& generations, const Model::Node* node);
+            
+            template <typename T>
+            bool cachedVisible(const T* node) const {
+                if (cacheValid(m_visibleGenerations, node))
+                    return static_cast<const Bitset&>(m_visible)[node->index()];
+                
+                const bool result = computeVisible(node);
+                validateCache(m_visibleGenerations, node);
+                m_visible[node->index()] = result;
+                return result;
+            }
         public:
             bool visible(const Model::Node* node) const;
             bool visible(const Model::World* world) const;
@@ -86,6 +129,13 @@ namespace TrenchBroom {
             bool visible(const Model::Brush* brush) const;
             bool visible(const Model::BrushFace* face) const;
         private:
+            class NodeVisible;
+            bool computeVisible(const Model::Node* node) const;
+            bool computeVisible(const Model::World* world) const;
+            bool computeVisible(const Model::Layer* layer) const;
+            bool computeVisible(const Model::Group* group) const;
+            bool computeVisible(const Model::Entity* entity) const;
+            bool computeVisible(const Model::Brush* brush) const;
             bool anyChildVisible(const Model::Node* node) const;
 
         public:
@@ -19,6 +19,7 @@
 
 #include "Entity.h"
 
+#include "Assets/EntityModelBVH.h"
 #include "Model/BoundsContainsNodeVisitor.h"
 #include "Model/BoundsIntersectsNodeVisitor.h"
 #include "Model/Brush.h"
@@ -40,7 +41,8 @@ namespace TrenchBroom {
         Entity::Entity() :
         AttributableNode(),
         Object(),
-        m_boundsValid(false) {}
+        m_boundsValid(false),
+        m_modelBVH(nullptr) {}
 
         bool Entity::brushEntity() const {
             return !pointEntity();
@@ -103,6 +105,10 @@ namespace TrenchBroom {
             return pointDefinition->model(m_attributes);
         }
 
+        void Entity::setModelBVH(const Assets::EntityModelBVH* modelBVH) {
+            m_modelBVH = modelBVH;
+        }
+
         const BBox3& Entity::doGetBounds() const {
             if (!m_boundsValid)
                 validateBounds();
@@ -175,12 +181,16 @@ namespace TrenchBroom {
                     child->pick(ray, pickResult);
             } else {
                 const BBox3& myBounds = bounds();
-                if (!myBounds.contains(ray.origin)) {
-                    const FloatType distance = myBounds.intersectWithRay(ray);
-                    if (!Math::isnan(distance)) {
-                        const Vec3 hitPoint = ray.pointAtDistance(distance);
-                        pickResult.addHit(Hit(EntityHit, distance, hitPoint, this));
-                    }
+                const bool containsOrigin = myBounds.contains(ray.origin);
+                FloatType distance = containsOrigin ? Math::nan<FloatType>() : myBounds.intersectWithRay(ray);
+                
+                // a hit on the bounds is refined against the model's triangles, which may also be hit from inside
+                if (m_modelBVH != nullptr && m_modelBVH->triangleCount() > 0 && (containsOrigin || !Math::isnan(distance)))
+                    distance = intersectWithModel(ray);
+                
+                if (!Math::isnan(distance)) {
+                    const Vec3 hitPoint = ray.pointAtDistance(distance);
+                    pickResult.addHit(Hit(EntityHit, distance, hitPoint, this));
                 }
             }
         }
@@ -326,6 +336,26 @@ namespace TrenchBroom {
             return intersects.result();
         }
 
+        FloatType Entity::intersectWithModel(const Ray3& ray) const {
+            assert(m_modelBVH != nullptr);
+            
+            bool invertible = true;
+            const Mat4x4 transformation = translationMatrix(origin()) * rotation();
+            const Mat4x4 inverse = invertedMatrix(transformation, invertible);
+            if (!invertible)
+                return Math::nan<FloatType>();
+            
+            // The direction is not normalized so that distances along the transformed ray are world distances.
+            const Vec3 modelOrigin = inverse * ray.origin;
+            const Vec3 modelDirection = inverse * (ray.origin + ray.direction) - modelOrigin;
+            const Ray3f modelRay(Ray3(modelOrigin, modelDirection));
+            
+            const float distance = m_modelBVH->intersectWithRay(modelRay);
+            if (Math::isnan(distance))
+                return Math::nan<FloatType>();
+            return static_cast<FloatType>(distance);
+        }
+
         void Entity::invalidateBounds() {
             m_boundsValid = false;
         }
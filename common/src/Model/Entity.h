@@ -29,6 +29,10 @@
 #include "Model/Object.h"
 
 namespace TrenchBroom {
+    namespace Assets {
+        class EntityModelBVH;
+    }
+    
     namespace Model {
         class PickResult;
         
@@ -39,6 +43,7 @@ namespace TrenchBroom {
             static const BBox3 DefaultBounds;
             mutable BBox3 m_bounds;
             mutable bool m_boundsValid;
+            const Assets::EntityModelBVH* m_modelBVH;
         public:
             Entity();
             
@@ -56,6 +61,12 @@ namespace TrenchBroom {
             void applyRotation(const Mat4x4& transformation);
         public: // entity model
             Assets::ModelSpecification modelSpecification() const;
+            
+            /**
+             * Sets the bounding volume hierarchy of this entity's model frame, which is used to refine hits against
+             * this entity's bounds when picking. Pass null if the model is not (or no longer) available.
+             */
+            void setModelBVH(const Assets::EntityModelBVH* modelBVH);
         private: // implement Node interface
             const BBox3& doGetBounds() const override;
 
@@ -100,6 +111,8 @@ namespace TrenchBroom {
         private:
             void invalidateBounds();
             void validateBounds() const;
+            
+            FloatType intersectWithModel(const Ray3& ray) const;
         private:
             Entity(const Entity&);
             Entity& operator=(const Entity&);
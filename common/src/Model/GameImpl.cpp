@@ -25,6 +25,8 @@
 #include "IO/Bsp29Parser.h"
 #include "IO/DefParser.h"
 #include "IO/DiskFileSystem.h"
+#include "IO/DkPakFileSystem.h"
+#include "IO/EntityDefinitionCache.h"
 #include "IO/FgdParser.h"
 #include "IO/FileMatcher.h"
 #include "IO/FileSystem.h"
@@ -97,6 +99,8 @@ namespace TrenchBroom {
 
                     if (StringUtils::caseInsensitiveEqual(packageFormat, "idpak"))
                         m_gameFS.addFileSystem(new IO::IdPakFileSystem(packagePath, packageFile));
+                    else if (StringUtils::caseInsensitiveEqual(packageFormat, "dkpak"))
+                        m_gameFS.addFileSystem(new IO::DkPakFileSystem(packagePath, packageFile));
                 }
             }
         }
@@ -280,19 +284,26 @@ namespace TrenchBroom {
         Assets::EntityDefinitionList GameImpl::doLoadEntityDefinitions(IO::ParserStatus& status, const IO::Path& path) const {
             const String extension = path.extension();
             const Color& defaultColor = m_config.entityConfig().defaultColor;
-
-            Assets::EntityDefinitionList definitions;
-            if (StringUtils::caseInsensitiveEqual("fgd", extension)) {
-                const IO::MappedFile::Ptr file = IO::Disk::openFile(IO::Disk::fixPath(path));
-                IO::FgdParser parser(file->begin(), file->end(), defaultColor);
-                definitions = parser.parseDefinitions(status);
-            } else if (StringUtils::caseInsensitiveEqual("def", extension)) {
-                const IO::MappedFile::Ptr file = IO::Disk::openFile(IO::Disk::fixPath(path));
-                IO::DefParser parser(file->begin(), file->end(), defaultColor);
-                definitions = parser.parseDefinitions(status);
-            } else {
+            
+            const bool fgd = StringUtils::caseInsensitiveEqual("fgd", extension);
+            const bool def = StringUtils::caseInsensitiveEqual("def", extension);
+            if (!fgd && !def)
                 throw GameException("Unknown entity definition format: '" + path.asString() + "'");
-            }
+            
+            const IO::Path fixedPath = IO::Disk::fixPath(path);
+            const time_t modificationTime = IO::Disk::fileModificationTime(fixedPath);
+            
+            // the file is only parsed if it was not parsed already, e.g. when another map of this game was opened
+            Assets::EntityDefinitionList definitions = IO::EntityDefinitionCache::instance().definitions(fixedPath, modificationTime, defaultColor, status, [fixedPath, fgd, &defaultColor](IO::ParserStatus& parserStatus) {
+                const IO::MappedFile::Ptr file = IO::Disk::openFile(fixedPath);
+                if (fgd) {
+                    IO::FgdParser parser(file->begin(), file->end(), defaultColor);
+                    return parser.parseDefinitions(parserStatus);
+                } else {
+                    IO::DefParser parser(file->begin(), file->end(), defaultColor);
+                    return parser.parseDefinitions(parserStatus);
+                }
+            });
 
             definitions.push_back(Tutorial::createTutorialEntityDefinition());
             return definitions;
@@ -370,14 +381,14 @@ namespace TrenchBroom {
         Assets::EntityModel* GameImpl::loadMdlModel(const String& name, const IO::MappedFile::Ptr& file) const {
             const Assets::Palette palette = loadTexturePalette();
 
-            IO::MdlParser parser(name, file->begin(), file->end(), palette);
+            IO::MdlParser parser(name, file, palette);
             return parser.parseModel();
         }
 
         Assets::EntityModel* GameImpl::loadMd2Model(const String& name, const IO::MappedFile::Ptr& file) const {
             const Assets::Palette palette = loadTexturePalette();
 
-            IO::Md2Parser parser(name, file->begin(), file->end(), palette, m_gameFS);
+            IO::Md2Parser parser(name, file, palette, m_gameFS);
             return parser.parseModel();
         }
 
@@ -27,9 +27,13 @@
 
 namespace TrenchBroom {
     namespace Model {
+        const FloatType Layer::PickCacheRadius = 16.0;
+        const FloatType Layer::PickCacheSpread = 0.02;
+        
         Layer::Layer(const String& name, const BBox3& worldBounds) :
         m_name(name),
-        m_octree(worldBounds, static_cast<FloatType>(64.0f)) {}
+        m_octree(worldBounds, static_cast<FloatType>(64.0f)),
+        m_pickCacheValid(false) {}
         
         void Layer::setName(const String& name) {
             m_name = name;
@@ -118,16 +122,19 @@ namespace TrenchBroom {
         void Layer::doChildWasAdded(Node* node) {
             AddNodeToOctree visitor(m_octree);
             node->accept(visitor);
+            invalidatePickCache();
         }
         
         void Layer::doChildWillBeRemoved(Node* node) {
             RemoveNodeFromOctree visitor(m_octree);
             node->accept(visitor);
+            invalidatePickCache();
         }
         
         void Layer::doChildBoundsDidChange(Node* node) {
             UpdateNodeInOctree visitor(m_octree);
             node->accept(visitor);
+            invalidatePickCache();
         }
 
         bool Layer::doSelectable() const {
@@ -147,7 +154,7 @@ namespace TrenchBroom {
         }
 
         void Layer::doPick(const Ray3& ray, PickResult& pickResult) const {
-            for (const Node* node : m_octree.findObjects(ray))
+            for (const Node* node : findPickCandidates(ray))
                 node->pick(ray, pickResult);
         }
         
@@ -159,5 +166,23 @@ namespace TrenchBroom {
         FloatType Layer::doIntersectWithRay(const Ray3& ray) const {
             return Math::nan<FloatType>();
         }
+
+        const Layer::NodeTree::List& Layer::findPickCandidates(const Ray3& ray) const {
+            // The cached candidates were found for every ray whose origin and direction deviate from the cached ray
+            // by at most the cache radius and spread, respectively.
+            if (!m_pickCacheValid ||
+                ray.origin.squaredDistanceTo(m_pickCacheRay.origin) > PickCacheRadius * PickCacheRadius ||
+                ray.direction.squaredDistanceTo(m_pickCacheRay.direction) > PickCacheSpread * PickCacheSpread) {
+                m_pickCandidates = m_octree.findObjects(ray, PickCacheRadius, PickCacheSpread);
+                m_pickCacheRay = ray;
+                m_pickCacheValid = true;
+            }
+            return m_pickCandidates;
+        }
+        
+        void Layer::invalidatePickCache() {
+            m_pickCacheValid = false;
+            m_pickCandidates.clear();
+        }
     }
 }
@@ -33,6 +33,17 @@ namespace TrenchBroom {
             
             typedef Octree<FloatType, Node*> NodeTree;
             NodeTree m_octree;
+            
+            /**
+             * Consecutive pick rays usually differ only slightly, so the candidates found for a widened pick ray are
+             * reused until a pick ray leaves the widened region or the octree changes.
+             */
+            static const FloatType PickCacheRadius;
+            static const FloatType PickCacheSpread;
+            
+            mutable bool m_pickCacheValid;
+            mutable Ray3 m_pickCacheRay;
+            mutable NodeTree::List m_pickCandidates;
         public:
             Layer(const String& name, const BBox3& worldBounds);
             
@@ -63,6 +74,9 @@ namespace TrenchBroom {
             void doPick(const Ray3& ray, PickResult& pickResult) const override;
             void doFindNodesContaining(const Vec3& point, NodeList& result) override;
             FloatType doIntersectWithRay(const Ray3& ray) const override;
+            
+            const NodeTree::List& findPickCandidates(const Ray3& ray) const;
+            void invalidatePickCache();
         private:
             Layer(const Layer&);
             Layer& operator=(const Layer&);
@@ -23,7 +23,9 @@
 #include "Model/Issue.h"
 #include "Model/IssueGenerator.h"
 
+#include <atomic>
 #include <cassert>
+#include <mutex>
 
 namespace TrenchBroom {
     namespace Model {
@@ -38,11 +40,14 @@ namespace TrenchBroom {
         m_lineNumber(0),
         m_lineCount(0),
         m_issuesValid(false),
-        m_hiddenIssues(0) {}
+        m_hiddenIssues(0),
+        m_index(acquireIndex()),
+        m_generation(nextGeneration()) {}
         
         Node::~Node() {
             clearChildren();
             clearIssues();
+            releaseIndex(m_index);
         }
         
         const String& Node::name() const {
@@ -52,6 +57,40 @@ namespace TrenchBroom {
         const BBox3& Node::bounds() const {
             return doGetBounds();
         }
+        
+        size_t Node::index() const {
+            return m_index;
+        }
+
+        size_t Node::generation() const {
+            return m_generation;
+        }
+        
+        namespace {
+            std::mutex s_indexMutex;
+            size_t s_nextIndex = 0;
+            std::vector<size_t> s_freeIndices;
+            std::atomic<size_t> s_nextGeneration(1);
+        }
+        
+        size_t Node::acquireIndex() {
+            std::lock_guard<std::mutex> lock(s_indexMutex);
+            if (s_freeIndices.empty())
+                return s_nextIndex++;
+            
+            const size_t index = s_freeIndices.back();
+            s_freeIndices.pop_back();
+            return index;
+        }
+        
+        void Node::releaseIndex(const size_t index) {
+            std::lock_guard<std::mutex> lock(s_indexMutex);
+            s_freeIndices.push_back(index);
+        }
+        
+        size_t Node::nextGeneration() {
+            return s_nextGeneration++;
+        }
 
         Node* Node::clone(const BBox3& worldBounds) const {
             return doClone(worldBounds);
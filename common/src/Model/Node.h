@@ -46,6 +46,9 @@ namespace TrenchBroom {
             mutable IssueList m_issues;
             mutable bool m_issuesValid;
             IssueType m_hiddenIssues;
+            
+            size_t m_index;
+            size_t m_generation;
         protected:
             Node();
         private:
@@ -56,6 +59,24 @@ namespace TrenchBroom {
         public: // getters
             const String& name() const;
             const BBox3& bounds() const;
+            
+            /**
+             * Returns an index that identifies this node among all currently existing nodes. The indices of destroyed
+             * nodes are reused, so the indices are dense and can be used to store per node information in vectors or
+             * bitsets.
+             */
+            size_t index() const;
+            
+            /**
+             * Returns a number that distinguishes this node from the destroyed nodes whose index it reuses. It is never
+             * zero, and no two nodes ever have the same generation, so caches indexed by index() can store it with each
+             * entry to detect entries which belong to a destroyed node.
+             */
+            size_t generation() const;
+        private:
+            static size_t acquireIndex();
+            static void releaseIndex(size_t index);
+            static size_t nextGeneration();
         public: // cloning and snapshots
             Node* clone(const BBox3& worldBounds) const;
             Node* cloneRecursively(const BBox3& worldBounds) const;
@@ -27,6 +27,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <unordered_set>
 
 namespace TrenchBroom {
     namespace Model {
@@ -44,42 +45,10 @@ namespace TrenchBroom {
             void doVisit(Brush* brush) override   { m_collection.m_nodes.push_back(brush);  m_collection.m_brushes.push_back(brush); }
         };
 
-        class NodeCollection::RemoveNode : public NodeVisitor {
-        private:
-            NodeCollection& m_collection;
-            NodeList::iterator m_nodeRem;
-            LayerList::iterator m_layerRem;
-            GroupList::iterator m_groupRem;
-            EntityList::iterator m_entityRem;
-            BrushList::iterator m_brushRem;
-        public:
-            RemoveNode(NodeCollection& collection) :
-            m_collection(collection),
-            m_nodeRem(std::end(m_collection.m_nodes)),
-            m_layerRem(std::end(m_collection.m_layers)),
-            m_groupRem(std::end(m_collection.m_groups)),
-            m_entityRem(std::end(m_collection.m_entities)),
-            m_brushRem(std::end(m_collection.m_brushes)) {}
-            
-            ~RemoveNode() override {
-                m_collection.m_nodes.erase(m_nodeRem, std::end(m_collection.m_nodes));
-                m_collection.m_layers.erase(m_layerRem, std::end(m_collection.m_layers));
-                m_collection.m_groups.erase(m_groupRem, std::end(m_collection.m_groups));
-                m_collection.m_entities.erase(m_entityRem, std::end(m_collection.m_entities));
-                m_collection.m_brushes.erase(m_brushRem, std::end(m_collection.m_brushes));
-            }
-        private:
-            void doVisit(World* world) override   {}
-            void doVisit(Layer* layer) override   { remove(m_collection.m_nodes, m_nodeRem, layer);  remove(m_collection.m_layers, m_layerRem, layer); }
-            void doVisit(Group* group) override   { remove(m_collection.m_nodes, m_nodeRem, group);  remove(m_collection.m_groups, m_groupRem, group); }
-            void doVisit(Entity* entity) override { remove(m_collection.m_nodes, m_nodeRem, entity); remove(m_collection.m_entities, m_entityRem, entity); }
-            void doVisit(Brush* brush) override   { remove(m_collection.m_nodes, m_nodeRem, brush);  remove(m_collection.m_brushes, m_brushRem, brush); }
-            
-            template <typename V, typename E>
-            void remove(V& collection, typename V::iterator& rem, E& elem) {
-                rem = std::remove(std::begin(collection), rem, elem);
-            }
-        };
+        template <typename L, typename S>
+        void NodeCollection::removeAll(L& list, const S& nodes) {
+            list.erase(std::remove_if(std::begin(list), std::end(list), [&nodes](const Node* node) { return nodes.count(node) > 0; }), std::end(list));
+        }
 
         bool NodeCollection::empty() const {
             return m_nodes.empty();
@@ -185,14 +154,18 @@ namespace TrenchBroom {
         }
         
         void NodeCollection::removeNodes(const NodeList& nodes) {
-            RemoveNode visitor(*this);
-            Node::accept(std::begin(nodes), std::end(nodes), visitor);
+            // a single pass over each list keeps removing many nodes linear and preserves the order of the rest
+            const std::unordered_set<const Node*> nodeSet(std::begin(nodes), std::end(nodes));
+            removeAll(m_nodes, nodeSet);
+            removeAll(m_layers, nodeSet);
+            removeAll(m_groups, nodeSet);
+            removeAll(m_entities, nodeSet);
+            removeAll(m_brushes, nodeSet);
         }
         
         void NodeCollection::removeNode(Node* node) {
             ensure(node != nullptr, "node is null");
-            RemoveNode visitor(*this);
-            node->accept(visitor);
+            removeNodes(NodeList(1, node));
         }
 
         void NodeCollection::clear() {
@@ -28,13 +28,15 @@ namespace TrenchBroom {
         class NodeCollection {
         private:
             class AddNode;
-            class RemoveNode;
         private:
             NodeList m_nodes;
             LayerList m_layers;
             GroupList m_groups;
             EntityList m_entities;
             BrushList m_brushes;
+        private:
+            template <typename L, typename S>
+            static void removeAll(L& list, const S& nodes);
         public:
             bool empty() const;
             size_t nodeCount() const;
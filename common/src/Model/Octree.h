@@ -132,6 +132,21 @@ namespace TrenchBroom {
                 result.insert(std::end(result), std::begin(m_objects), std::end(m_objects));
             }
             
+            void findObjects(const Ray<F,3>& ray, const F radius, const F spread, List& result) const {
+                // The rays to consider deviate from the given ray by at most radius + spread * t at distance t, so
+                // the bounds are expanded by that deviation at the farthest point they contain.
+                const F maxDistance = m_bounds.center().distanceTo(ray.origin) + m_bounds.size().length() / static_cast<F>(2.0) + radius;
+                const BBox<F,3> bounds = m_bounds.expanded(radius + spread * maxDistance);
+                const F distance = bounds.intersectWithRay(ray);
+                if (Math::isnan(distance))
+                    return;
+                
+                for (size_t i = 0; i < 8; ++i)
+                    if (m_children[i] != nullptr)
+                        m_children[i]->findObjects(ray, radius, spread, result);
+                result.insert(std::end(result), std::begin(m_objects), std::end(m_objects));
+            }
+            
             void findObjects(const Vec<F,3>& point, List& result) const {
                 if (!m_bounds.contains(point))
                     return;
@@ -250,6 +265,17 @@ namespace TrenchBroom {
                 return result;
             }
             
+            /**
+             * Finds the objects which may be hit by any ray whose origin lies within the given radius of the given
+             * ray's origin and whose normalized direction differs from the given ray's direction by at most the given
+             * spread.
+             */
+            List findObjects(const Ray<F,3>& ray, const F radius, const F spread) const {
+                List result;
+                m_root->findObjects(ray, radius, spread, result);
+                return result;
+            }
+            
             List findObjects(const Vec<F,3>& point) const {
                 List result;
                 m_root->findObjects(point, result);
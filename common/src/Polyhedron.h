@@ -205,6 +205,9 @@ public:
         HalfEdgeList m_boundary;
         typename FP::Type m_payload;
         FaceLink m_link;
+        
+        // Identifies this face while further points are added to the polyhedron.
+        size_t m_id;
     private:
         Face(HalfEdgeList& boundary);
     public:
@@ -416,6 +419,12 @@ public:
     void merge(const Polyhedron& other);
     void merge(const Polyhedron& other, Callback& callback);
 private:
+    class ConflictFaceTracker;
+    
+    static typename V::List findInitialSimplex(const typename V::List& points);
+    void addFurtherPointsToPolyhedron(typename V::List points, Callback& callback);
+    const Face* findConflictFace(const V& position, T& distance, const Callback& callback) const;
+    
     Vertex* addFirstPoint(const V& position, Callback& callback);
     Vertex* addSecondPoint(const V& position, Callback& callback);
     
@@ -20,6 +20,8 @@
 #ifndef TrenchBroom_Polyhedron_ConvexHull_h
 #define TrenchBroom_Polyhedron_ConvexHull_h
 
+#include <algorithm>
+#include <limits>
 #include <list>
 
 template <typename T, typename FP, typename VP>
@@ -168,14 +170,224 @@ void Polyhedron<T,FP,VP>::addPoints(const typename V::List& points, Callback& ca
 template <typename T, typename FP, typename VP> template <typename I>
 void Polyhedron<T,FP,VP>::addPoints(I cur, I end) {
     Callback c;
-    while (cur != end)
-        addPoint(*cur++, c);
+    addPoints(cur, end, c);
 }
 
+/*
+ Adds the given points in the order of the QuickHull algorithm instead of the given order. The hull is seeded with a
+ simplex of extreme points. Afterwards, the point that is furthest above any face of the hull is added until no point
+ is left above the hull. Points which are added this way are almost always vertices of the final hull, so topology is
+ rarely created only to be removed again, and points which end up inside the hull are dropped without modifying the
+ topology at all.
+ */
 template <typename T, typename FP, typename VP> template <typename I>
 void Polyhedron<T,FP,VP>::addPoints(I cur, I end, Callback& callback) {
-    while (cur != end)
-        addPoint(*cur++, callback);
+    typename V::List points(cur, end);
+    if (points.empty())
+        return;
+    
+    if (!polyhedron()) {
+        for (const V& point : findInitialSimplex(points))
+            addPoint(point, callback);
+    }
+    
+    if (polyhedron()) {
+        addFurtherPointsToPolyhedron(points, callback);
+    } else {
+        // All points are colinear or coplanar.
+        for (const V& point : points)
+            addPoint(point, callback);
+    }
+}
+
+// Finds up to four points which span a simplex of maximal extent: the two points which are furthest apart among
+// the points that are extreme along the coordinate axes, the point furthest from the line through them, and the point
+// furthest from the plane through those three points.
+template <typename T, typename FP, typename VP>
+typename Polyhedron<T,FP,VP>::V::List Polyhedron<T,FP,VP>::findInitialSimplex(const typename V::List& points) {
+    assert(!points.empty());
+    typename V::List result;
+    
+    typename V::List extremes;
+    for (size_t i = 0; i < 3; ++i) {
+        const auto minMax = std::minmax_element(std::begin(points), std::end(points),
+                                                [i](const V& lhs, const V& rhs) { return lhs[i] < rhs[i]; });
+        extremes.push_back(*minMax.first);
+        extremes.push_back(*minMax.second);
+    }
+    
+    T bestDistance = 0.0;
+    V p1 = points.front();
+    V p2 = points.front();
+    for (size_t i = 0; i < extremes.size(); ++i) {
+        for (size_t j = i + 1; j < extremes.size(); ++j) {
+            const T distance = extremes[i].squaredDistanceTo(extremes[j]);
+            if (distance > bestDistance) {
+                bestDistance = distance;
+                p1 = extremes[i];
+                p2 = extremes[j];
+            }
+        }
+    }
+    
+    result.push_back(p1);
+    if (Math::zero(bestDistance))
+        return result;
+    result.push_back(p2);
+    
+    const V direction = (p2 - p1).normalized();
+    const auto p3 = std::max_element(std::begin(points), std::end(points), [&](const V& lhs, const V& rhs) {
+        return crossed(lhs - p1, direction).squaredLength() < crossed(rhs - p1, direction).squaredLength();
+    });
+    if (Math::zero(crossed(*p3 - p1, direction).length()))
+        return result;
+    result.push_back(*p3);
+    
+    const V normal = crossed(p2 - p1, *p3 - p1).normalized();
+    const auto p4 = std::max_element(std::begin(points), std::end(points), [&](const V& lhs, const V& rhs) {
+        return Math::abs((lhs - p1).dot(normal)) < Math::abs((rhs - p1).dot(normal));
+    });
+    if (Math::zero((*p4 - p1).dot(normal)))
+        return result;
+    result.push_back(*p4);
+    
+    return result;
+}
+
+// Forwards all notifications to the given callback and keeps track of which faces are still part of the
+// polyhedron. Every face is given an ID which indexes its liveness flag, so that a removed face can be detected
+// without touching it. IDs are never reused, unlike the addresses of deleted faces.
+template <typename T, typename FP, typename VP>
+class Polyhedron<T,FP,VP>::ConflictFaceTracker : public Callback {
+private:
+    Callback& m_callback;
+    std::vector<bool> m_alive;
+public:
+    ConflictFaceTracker(FaceList& faces, Callback& callback) :
+    m_callback(callback) {
+        Face* firstFace = faces.front();
+        Face* currentFace = firstFace;
+        do {
+            track(currentFace);
+            currentFace = currentFace->next();
+        } while (currentFace != firstFace);
+    }
+    
+    bool alive(const size_t id) const {
+        return id < m_alive.size() && m_alive[id];
+    }
+    
+    void vertexWasCreated(Vertex* vertex) override { m_callback.vertexWasCreated(vertex); }
+    void vertexWillBeDeleted(Vertex* vertex) override { m_callback.vertexWillBeDeleted(vertex); }
+    void vertexWasAdded(Vertex* vertex) override { m_callback.vertexWasAdded(vertex); }
+    void vertexWillBeRemoved(Vertex* vertex) override { m_callback.vertexWillBeRemoved(vertex); }
+    Plane<T,3> plane(const Face* face) const override { return m_callback.plane(face); }
+    void faceDidChange(Face* face) override { m_callback.faceDidChange(face); }
+    void faceWasFlipped(Face* face) override { m_callback.faceWasFlipped(face); }
+    
+    void faceWasCreated(Face* face) override {
+        track(face);
+        m_callback.faceWasCreated(face);
+    }
+    
+    void faceWillBeDeleted(Face* face) override {
+        m_alive[face->m_id] = false;
+        m_callback.faceWillBeDeleted(face);
+    }
+    
+    void faceWasSplit(Face* original, Face* clone) override {
+        track(clone);
+        m_callback.faceWasSplit(original, clone);
+    }
+    
+    void facesWillBeMerged(Face* remaining, Face* toDelete) override {
+        m_alive[toDelete->m_id] = false;
+        m_callback.facesWillBeMerged(remaining, toDelete);
+    }
+private:
+    void track(Face* face) {
+        face->m_id = m_alive.size();
+        m_alive.push_back(true);
+    }
+};
+
+// Adds the given points to this polyhedron, furthest point first. Every pending point is assigned a conflict face
+// that it is above of. A point only needs to be matched against all faces again once its conflict face has been
+// removed from the hull, and a point for which no conflict face can be found is inside the hull and is dropped.
+template <typename T, typename FP, typename VP>
+void Polyhedron<T,FP,VP>::addFurtherPointsToPolyhedron(typename V::List points, Callback& callback) {
+    assert(polyhedron());
+    
+    static const size_t NoConflictFace = std::numeric_limits<size_t>::max();
+    
+    ConflictFaceTracker tracker(m_faces, callback);
+    std::vector<size_t> conflictFaces(points.size(), NoConflictFace);
+    std::vector<T> conflictDistances(points.size(), 0.0);
+    
+    while (!points.empty()) {
+        // every point with a conflict face is above it, so its distance is positive
+        size_t furthest = 0;
+        T furthestDistance = 0.0;
+        size_t i = 0;
+        while (i < points.size()) {
+            if (!tracker.alive(conflictFaces[i])) {
+                const Face* face = findConflictFace(points[i], conflictDistances[i], tracker);
+                conflictFaces[i] = face != nullptr ? face->m_id : NoConflictFace;
+            }
+            
+            if (conflictFaces[i] == NoConflictFace) {
+                points[i] = points.back();
+                conflictFaces[i] = conflictFaces.back();
+                conflictDistances[i] = conflictDistances.back();
+                
+                points.pop_back();
+                conflictFaces.pop_back();
+                conflictDistances.pop_back();
+            } else {
+                if (conflictDistances[i] > furthestDistance) {
+                    furthest = i;
+                    furthestDistance = conflictDistances[i];
+                }
+                ++i;
+            }
+        }
+        
+        if (points.empty())
+            break;
+        
+        addPoint(points[furthest], tracker);
+        
+        points[furthest] = points.back();
+        conflictFaces[furthest] = conflictFaces.back();
+        conflictDistances[furthest] = conflictDistances.back();
+        
+        points.pop_back();
+        conflictFaces.pop_back();
+        conflictDistances.pop_back();
+    }
+}
+
+// Returns the face which the given point is furthest above of, or null if the point is not above any face.
+template <typename T, typename FP, typename VP>
+const typename Polyhedron<T,FP,VP>::Face* Polyhedron<T,FP,VP>::findConflictFace(const V& position, T& distance, const Callback& callback) const {
+    const Face* result = nullptr;
+    distance = 0.0;
+    
+    const Face* firstFace = m_faces.front();
+    const Face* currentFace = firstFace;
+    do {
+        const Plane<T,3> plane = callback.plane(currentFace);
+        if (plane.pointStatus(position) == Math::PointStatus::PSAbove) {
+            const T currentDistance = plane.pointDistance(position);
+            if (currentDistance > distance) {
+                result = currentFace;
+                distance = currentDistance;
+            }
+        }
+        currentFace = currentFace->next();
+    } while (currentFace != firstFace);
+    
+    return result;
 }
 
 template <typename T, typename FP, typename VP>
@@ -46,7 +46,8 @@ m_link(this)
 #else
 m_link(this)
 #endif
-{
+,
+m_id(0) {
     using std::swap;
     swap(m_boundary, boundary);
     
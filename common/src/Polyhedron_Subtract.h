@@ -83,7 +83,7 @@ private:
         const PlaneList planes = sortPlanes(findSubtrahendPlanes());
         
         assert(m_fragments.empty());
-        doSubtract(List{m_minuend}, std::begin(planes), std::end(planes));
+        doSubtract(std::begin(planes), std::end(planes));
     }
     
     auto findSubtrahendPlanes() const {
@@ -201,37 +201,37 @@ private:
         return bestIt;
     }
     
-    void doSubtract(const List& fragments, PlaneIt curPlaneIt, PlaneIt endPlaneIt) {
-        if (fragments.empty() || curPlaneIt == endPlaneIt) {
-            // no more fragments to process or all of `minutendFragments`
-            // are now behind all of subtrahendPlanes so they can be discarded.
-            return;
-        }
-        
-        const Plane<T,3> curPlane = *curPlaneIt;
-        const Plane<T,3> curPlaneInv = curPlane.flipped();
-        
-        // clip the list of minutendFragments into a list of those in front of the
-        // currentPlane, and those behind
-        List backFragments;
+    /**
+     * Clips the minuend successively by the given planes. The part of the remainder that is in front of the
+     * current plane becomes a fragment, and the part behind it is clipped in place by the remaining planes, so
+     * that only a single copy of the minuend is needed to carry the topology from one step to the next.
+     * Whatever remains once all planes have been processed is inside the subtrahend and is discarded.
+     */
+    void doSubtract(PlaneIt curPlaneIt, PlaneIt endPlaneIt) {
+        Polyhedron remainder = m_minuend;
         
-        for (const Polyhedron& fragment : fragments) {
-            // the front fragments go directly into the result set.
-            Polyhedron<T,FP,VP> fragmentInFront = fragment;
-            const auto frontClipResult = fragmentInFront.clip(curPlaneInv);
+        for (; curPlaneIt != endPlaneIt; ++curPlaneIt) {
+            const Plane<T,3>& curPlane = *curPlaneIt;
+            
+            // Classify the vertices first so that we only copy the remainder if the plane really splits it.
+            const ClipResult status = remainder.checkIntersects(curPlane);
+            if (status.unchanged()) {
+                // the remainder is entirely behind the current plane
+                continue;
+            } else if (status.empty()) {
+                // the remainder is entirely in front of the current plane
+                m_fragments.push_back(std::move(remainder));
+                return;
+            }
             
-            if (!frontClipResult.empty()) // Polyhedron::clip() keeps the part behind the plane.
-                m_fragments.push_back(fragmentInFront);
+            // Polyhedron::clip() keeps the part behind the plane.
+            Polyhedron fragment = remainder;
+            if (!fragment.clip(curPlane.flipped()).empty())
+                m_fragments.push_back(std::move(fragment));
             
-            // back fragments need to be clipped by the rest of the subtrahend planes
-            Polyhedron<T,FP,VP> fragmentBehind = fragment;
-            const auto backClipResult = fragmentBehind.clip(curPlane);
-            if (!backClipResult.empty())
-                backFragments.push_back(fragmentBehind);
+            if (remainder.clip(curPlane).empty())
+                return;
         }
-        
-        // recursively process the back fragments.
-        doSubtract(backFragments, std::next(curPlaneIt), endPlaneIt);
     }
 };
 
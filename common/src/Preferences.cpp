@@ -28,6 +28,7 @@ namespace TrenchBroom {
         Preference<int> MapViewLayout(IO::Path("Views/Map view layout"), View::MapViewLayout_1Pane);
         
         Preference<bool>  ShowAxes(IO::Path("Renderer/Show axes"), true);
+        Preference<bool>  ShowRenderStatistics(IO::Path("Renderer/Show render statistics"), false);
         Preference<Color> BackgroundColor(IO::Path("Renderer/Colors/Background"), Color(38, 38, 38));
         Preference<float> AxisLength(IO::Path("Renderer/Axis length"), 128.0f);
         Preference<Color> XAxisColor(IO::Path("Renderer/Colors/X axis"), Color(0xFF, 0x3D, 0x00, 0.7f));
@@ -26,12 +26,16 @@
 #include "Model/BrushGeometry.h"
 #include "Model/EditorContext.h"
 #include "Model/NodeVisitor.h"
+#include "Renderer/Camera.h"
+#include "Renderer/FaceDrawList.h"
 #include "Renderer/IndexArrayMapBuilder.h"
 #include "Renderer/RenderContext.h"
 #include "Renderer/RenderUtils.h"
 #include "Renderer/TexturedIndexArrayBuilder.h"
 #include "Renderer/VertexSpec.h"
 
+#include <algorithm>
+
 namespace TrenchBroom {
     namespace Renderer {
         BrushRenderer::FaceAcceptor::~FaceAcceptor() {}
@@ -121,9 +125,48 @@ namespace TrenchBroom {
             return m_transparent;
         }
 
+        BrushRenderer::EdgeRanges::EdgeRanges(const size_t i_detailBrushCount, const size_t i_edgeIndexCount, const size_t i_pointIndexOffset, const size_t i_pointIndexCount) :
+        detailBrushCount(i_detailBrushCount),
+        edgeIndexCount(i_edgeIndexCount),
+        pointIndexOffset(i_pointIndexOffset),
+        pointIndexCount(i_pointIndexCount) {}
+        
+        void BrushRenderer::sortBrushes(Model::BrushList& brushes, std::vector<FloatType>& brushSizes) {
+            typedef std::pair<FloatType, Model::Brush*> SizedBrush;
+            std::vector<SizedBrush> sizedBrushes;
+            sizedBrushes.reserve(brushes.size());
+            
+            for (Model::Brush* brush : brushes) {
+                const Vec3 size = brush->bounds().size();
+                sizedBrushes.push_back(std::make_pair(std::max(std::max(size.x(), size.y()), size.z()), brush));
+            }
+            
+            std::sort(std::begin(sizedBrushes), std::end(sizedBrushes), [](const SizedBrush& lhs, const SizedBrush& rhs) { return lhs.first > rhs.first; });
+            
+            brushSizes.clear();
+            brushSizes.reserve(sizedBrushes.size());
+            for (size_t i = 0; i < sizedBrushes.size(); ++i) {
+                brushSizes.push_back(sizedBrushes[i].first);
+                brushes[i] = sizedBrushes[i].second;
+            }
+        }
+        
+        BrushRenderer::EdgeRanges BrushRenderer::edgeRanges(const std::vector<FloatType>& brushSizes, const std::vector<size_t>& edgeIndexCounts, const std::vector<size_t>& pointIndexCounts, const FloatType minDetailSize) {
+            assert(edgeIndexCounts.size() == brushSizes.size() + 1);
+            assert(pointIndexCounts.size() == brushSizes.size() + 1);
+            
+            const size_t detailCount = static_cast<size_t>(std::distance(std::begin(brushSizes), std::partition_point(std::begin(brushSizes), std::end(brushSizes), [minDetailSize](const FloatType size) { return size >= minDetailSize; })));
+            const size_t pointIndexOffset = pointIndexCounts[detailCount];
+            return EdgeRanges(detailCount, edgeIndexCounts[detailCount], pointIndexOffset, pointIndexCounts.back() - pointIndexOffset);
+        }
+
+        BrushRenderer::Chunk::Chunk() :
+        valid(false) {}
+        
+        const float BrushRenderer::MinDetailSize = 2.0f;
+
         BrushRenderer::BrushRenderer(const bool transparent) :
         m_filter(new NoFilter(transparent)),
-        m_valid(true),
         m_showEdges(false),
         m_grayscale(false),
         m_tint(false),
@@ -132,31 +175,56 @@ namespace TrenchBroom {
         m_showHiddenBrushes(false) {}
         
         BrushRenderer::~BrushRenderer() {
+            VectorUtils::clearAndDelete(m_chunks);
             delete m_filter;
             m_filter = nullptr;
         }
 
         void BrushRenderer::addBrushes(const Model::BrushList& brushes) {
-            VectorUtils::append(m_brushes, brushes);
-            invalidate();
+            for (Model::Brush* brush : brushes)
+                addBrush(brush);
+        }
+        
+        void BrushRenderer::removeBrushes(const Model::BrushList& brushes) {
+            for (const Model::Brush* brush : brushes) {
+                ChunkMap::iterator it = m_brushChunks.find(brush);
+                if (it != std::end(m_brushChunks)) {
+                    Chunk* chunk = it->second;
+                    m_brushChunks.erase(it);
+                    
+                    // the brushes of a chunk are sorted when it is validated, so their order does not matter here
+                    Model::BrushList& chunkBrushes = chunk->brushes;
+                    Model::BrushList::iterator brushIt = std::find(std::begin(chunkBrushes), std::end(chunkBrushes), brush);
+                    assert(brushIt != std::end(chunkBrushes));
+                    *brushIt = chunkBrushes.back();
+                    chunkBrushes.pop_back();
+                    
+                    chunk->vertexArray = VertexArray();
+                    chunk->valid = false;
+                }
+            }
+            releaseEmptyChunks();
         }
 
         void BrushRenderer::setBrushes(const Model::BrushList& brushes) {
-            m_brushes = brushes;
-            invalidate();
+            clear();
+            addBrushes(brushes);
+        }
+
+        size_t BrushRenderer::chunkCount() const {
+            return m_chunks.size();
         }
 
         void BrushRenderer::invalidate() {
-            m_vertexArray = VertexArray();
-            m_valid = false;
+            for (Chunk* chunk : m_chunks) {
+                chunk->vertexArray = VertexArray();
+                chunk->valid = false;
+            }
         }
         
         void BrushRenderer::clear() {
-            m_brushes.clear();
-            m_transparentFaceRenderer = FaceRenderer();
-            m_opaqueFaceRenderer = FaceRenderer();
-            m_vertexArray = VertexArray();
-            m_valid = true;
+            VectorUtils::clearAndDelete(m_chunks);
+            m_brushChunks.clear();
         }
 
         void BrushRenderer::setFaceColor(const Color& faceColor) {
@@ -208,46 +276,135 @@ namespace TrenchBroom {
         }
         
         void BrushRenderer::renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch) {
-            if (!m_brushes.empty()) {
-                if (!m_valid)
-                    validate();
-                if (renderContext.showFaces())
-                    renderOpaqueFaces(renderBatch);
-                if (renderContext.showEdges() || m_showEdges)
-                    renderEdges(renderBatch);
-            }
+            FaceDrawList* faceDrawList = new FaceDrawList();
+            renderBatch.addOneShot(faceDrawList);
+            renderOpaque(renderContext, renderBatch, *faceDrawList);
         }
         
         void BrushRenderer::renderTransparent(RenderContext& renderContext, RenderBatch& renderBatch) {
-            if (!m_brushes.empty()) {
-                if (!m_valid)
-                    validate();
-                if (renderContext.showFaces())
-                    renderTransparentFaces(renderBatch);
+            FaceDrawList* faceDrawList = new FaceDrawList();
+            renderBatch.addOneShot(faceDrawList);
+            renderTransparent(renderContext, *faceDrawList);
+        }
+        
+        void BrushRenderer::renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch, FaceDrawList& faceDrawList) {
+            if (!m_brushChunks.empty()) {
+                validate();
+                
+                const FloatType detailSize = minDetailSize(renderContext);
+                for (Chunk* chunk : m_chunks) {
+                    if (!chunk->brushes.empty()) {
+                        if (renderContext.showFaces())
+                            renderOpaqueFaces(*chunk, faceDrawList);
+                        if (renderContext.showEdges() || m_showEdges)
+                            renderEdges(*chunk, detailSize, renderBatch);
+                    }
+                }
+            }
+        }
+        
+        void BrushRenderer::renderTransparent(RenderContext& renderContext, FaceDrawList& faceDrawList) {
+            if (!m_brushChunks.empty()) {
+                validate();
+                if (renderContext.showFaces()) {
+                    for (Chunk* chunk : m_chunks) {
+                        if (!chunk->brushes.empty())
+                            renderTransparentFaces(*chunk, faceDrawList);
+                    }
+                }
             }
         }
 
-        void BrushRenderer::renderOpaqueFaces(RenderBatch& renderBatch) {
-            m_opaqueFaceRenderer.setGrayscale(m_grayscale);
-            m_opaqueFaceRenderer.setTint(m_tint);
-            m_opaqueFaceRenderer.setTintColor(m_tintColor);
-            m_opaqueFaceRenderer.render(renderBatch);
+        void BrushRenderer::renderOpaqueFaces(Chunk& chunk, FaceDrawList& faceDrawList) {
+            chunk.opaqueFaceRenderer.setGrayscale(m_grayscale);
+            chunk.opaqueFaceRenderer.setTint(m_tint);
+            chunk.opaqueFaceRenderer.setTintColor(m_tintColor);
+            faceDrawList.add(&chunk.opaqueFaceRenderer);
+        }
+        
+        void BrushRenderer::renderTransparentFaces(Chunk& chunk, FaceDrawList& faceDrawList) {
+            chunk.transparentFaceRenderer.setGrayscale(m_grayscale);
+            chunk.transparentFaceRenderer.setTint(m_tint);
+            chunk.transparentFaceRenderer.setTintColor(m_tintColor);
+            chunk.transparentFaceRenderer.setAlpha(m_transparencyAlpha);
+            faceDrawList.add(&chunk.transparentFaceRenderer);
+        }
+        
+        void BrushRenderer::renderEdges(Chunk& chunk, const FloatType minDetailSize, RenderBatch& renderBatch) {
+            const EdgeRanges edges = edgeRanges(chunk.brushSizes, chunk.edgeIndexCounts, chunk.pointIndexCounts, minDetailSize);
+            if (edges.detailBrushCount == chunk.brushSizes.size()) {
+                renderEdges(chunk.edgeRenderer, renderBatch);
+                return;
+            }
+            
+            if (edges.edgeIndexCount > 0) {
+                IndexArrayMap::Size size;
+                size.inc(GL_LINES, edges.edgeIndexCount);
+                IndexArrayMap ranges(size);
+                ranges.add(GL_LINES, edges.edgeIndexCount);
+                
+                IndexedEdgeRenderer edgeRenderer(chunk.vertexArray, chunk.edgeIndices, ranges);
+                renderEdges(edgeRenderer, renderBatch);
+            }
+            
+            if (edges.pointIndexCount > 0) {
+                IndexArrayMap::Size size;
+                size.inc(GL_POINTS, edges.pointIndexCount);
+                IndexArrayMap ranges(size, edges.pointIndexOffset);
+                ranges.add(GL_POINTS, edges.pointIndexCount);
+                
+                IndexedEdgeRenderer pointRenderer(chunk.vertexArray, chunk.pointIndices, ranges);
+                renderEdges(pointRenderer, renderBatch);
+            }
         }
         
-        void BrushRenderer::renderTransparentFaces(RenderBatch& renderBatch) {
-            m_transparentFaceRenderer.setGrayscale(m_grayscale);
-            m_transparentFaceRenderer.setTint(m_tint);
-            m_transparentFaceRenderer.setTintColor(m_tintColor);
-            m_transparentFaceRenderer.setAlpha(m_transparencyAlpha);
-            m_transparentFaceRenderer.render(renderBatch);
+        void BrushRenderer::renderEdges(IndexedEdgeRenderer& edgeRenderer, RenderBatch& renderBatch) {
+            if (m_showOccludedEdges)
+                edgeRenderer.renderOnTop(renderBatch, m_occludedEdgeColor);
+            edgeRenderer.render(renderBatch, m_edgeColor);
         }
         
-        void BrushRenderer::renderEdges(RenderBatch& renderBatch) {
-            if (m_showOccludedEdges)
-                m_edgeRenderer.renderOnTop(renderBatch, m_occludedEdgeColor);
-            m_edgeRenderer.render(renderBatch, m_edgeColor);
+        FloatType BrushRenderer::minDetailSize(const RenderContext& renderContext) const {
+            // in an orthographic view, one pixel covers 1 / zoom world units
+            if (!renderContext.render2D())
+                return 0.0;
+            return static_cast<FloatType>(MinDetailSize / renderContext.camera().zoom());
+        }
+        
+        void BrushRenderer::addBrush(Model::Brush* brush) {
+            if (m_brushChunks.count(brush) > 0)
+                return;
+            
+            Chunk* chunk = findChunkWithSpace();
+            chunk->brushes.push_back(brush);
+            chunk->vertexArray = VertexArray();
+            chunk->valid = false;
+            m_brushChunks.insert(std::make_pair(brush, chunk));
+        }
+        
+        BrushRenderer::Chunk* BrushRenderer::findChunkWithSpace() {
+            for (Chunk* chunk : m_chunks) {
+                if (chunk->brushes.size() < MaxChunkSize)
+                    return chunk;
+            }
+            
+            m_chunks.push_back(new Chunk());
+            return m_chunks.back();
         }
 
+        void BrushRenderer::releaseEmptyChunks() {
+            size_t i = 0;
+            while (i < m_chunks.size()) {
+                if (m_chunks[i]->brushes.empty()) {
+                    delete m_chunks[i];
+                    m_chunks[i] = m_chunks.back();
+                    m_chunks.pop_back();
+                } else {
+                    ++i;
+                }
+            }
+        }
+        
         class BrushRenderer::FilterWrapper : public BrushRenderer::Filter {
         private:
             const Filter& m_filter;
@@ -397,12 +554,21 @@ namespace TrenchBroom {
             TexturedIndexArrayBuilder m_opaqueFaceIndexBuilder;
             TexturedIndexArrayBuilder m_transparentFaceIndexBuilder;
             IndexArrayMapBuilder m_edgeIndexBuilder;
+            size_t m_edgeIndexCount;
+            IndexArrayMapBuilder::IndexList m_pointIndices;
+            std::vector<size_t> m_edgeIndexCounts;
+            std::vector<size_t> m_pointIndexCounts;
+            size_t m_brushPointCount;
         public:
             CollectIndices(const FilterWrapper& filter, const CountIndices& indexSize) :
             m_filter(filter),
             m_opaqueFaceIndexBuilder(indexSize.opaqueIndexSize()),
             m_transparentFaceIndexBuilder(indexSize.transparentIndexSize()),
-            m_edgeIndexBuilder(indexSize.edgeIndexSize()) {}
+            m_edgeIndexBuilder(indexSize.edgeIndexSize()),
+            m_edgeIndexCount(0),
+            m_edgeIndexCounts(1, 0),
+            m_pointIndexCounts(1, 0),
+            m_brushPointCount(0) {}
             
             TexturedIndexArrayBuilder& opaqueFaceIndices() {
                 return m_opaqueFaceIndexBuilder;
@@ -415,6 +581,18 @@ namespace TrenchBroom {
             IndexArrayMapBuilder& edgeIndices() {
                 return m_edgeIndexBuilder;
             }
+            
+            IndexArrayMapBuilder::IndexList& pointIndices() {
+                return m_pointIndices;
+            }
+            
+            std::vector<size_t>& edgeIndexCounts() {
+                return m_edgeIndexCounts;
+            }
+            
+            std::vector<size_t>& pointIndexCounts() {
+                return m_pointIndexCounts;
+            }
         private:
             void doVisit(const Model::World* world) override {}
             void doVisit(const Model::Layer* layer) override {}
@@ -423,6 +601,9 @@ namespace TrenchBroom {
             void doVisit(const Model::Brush* brush) override {
                 collectFaceIndices(brush);
                 collectEdgeIndices(brush);
+                
+                m_edgeIndexCounts.push_back(m_edgeIndexCount);
+                m_pointIndexCounts.push_back(m_pointIndices.size());
             }
             
             void collectFaceIndices(const Model::Brush* brush) {
@@ -440,6 +621,7 @@ namespace TrenchBroom {
             }
             
             void collectEdgeIndices(const Model::Brush* brush) {
+                m_brushPointCount = 0;
                 m_filter.provideEdges(brush, *this);
             }
             
@@ -447,34 +629,45 @@ namespace TrenchBroom {
                 const Model::BrushVertex* v1 = edge->firstVertex();
                 const Model::BrushVertex* v2 = edge->secondVertex();
                 m_edgeIndexBuilder.addLine(v1->payload(), v2->payload());
+                m_edgeIndexCount += 2;
+                
+                // the first vertex of a brush stands in for the entire brush when it is too small to be discerned
+                if (m_brushPointCount++ == 0)
+                    m_pointIndices.push_back(static_cast<IndexArrayMapBuilder::Index>(v1->payload()));
             }
         };
         
         void BrushRenderer::validate() {
-            assert(!m_valid);
-            validateVertices();
-            validateIndices();
-            m_valid = true;
+            for (Chunk* chunk : m_chunks) {
+                if (!chunk->valid) {
+                    // vertex indices are stored in the brush vertex payloads, so the indices of a chunk must be
+                    // collected right after its vertices
+                    sortBrushes(chunk->brushes, chunk->brushSizes);
+                    validateVertices(*chunk);
+                    validateIndices(*chunk);
+                    chunk->valid = true;
+                }
+            }
         }
         
-        void BrushRenderer::validateVertices() {
+        void BrushRenderer::validateVertices(Chunk& chunk) {
             const FilterWrapper wrapper(*m_filter, m_showHiddenBrushes);
             CountVertices countVertices(wrapper);
-            Model::Node::accept(std::begin(m_brushes), std::end(m_brushes), countVertices);
+            Model::Node::accept(std::begin(chunk.brushes), std::end(chunk.brushes), countVertices);
             
             CollectVertices collectVertices(wrapper, countVertices.vertexCount());
-            Model::Node::accept(std::begin(m_brushes), std::end(m_brushes), collectVertices);
+            Model::Node::accept(std::begin(chunk.brushes), std::end(chunk.brushes), collectVertices);
             
-            m_vertexArray = collectVertices.vertexArray();
+            chunk.vertexArray = collectVertices.vertexArray();
         }
         
-        void BrushRenderer::validateIndices() {
+        void BrushRenderer::validateIndices(Chunk& chunk) {
             const FilterWrapper wrapper(*m_filter, m_showHiddenBrushes);
             CountIndices countIndices(wrapper);
-            Model::Node::accept(std::begin(m_brushes), std::end(m_brushes), countIndices);
+            Model::Node::accept(std::begin(chunk.brushes), std::end(chunk.brushes), countIndices);
             
             CollectIndices collectIndices(wrapper, countIndices);
-            Model::Node::accept(std::begin(m_brushes), std::end(m_brushes), collectIndices);
+            Model::Node::accept(std::begin(chunk.brushes), std::end(chunk.brushes), collectIndices);
             
             const IndexArray opaqueIndices = IndexArray::swap(collectIndices.opaqueFaceIndices().indices());
             const TexturedIndexArrayMap& opaqueRanges = collectIndices.opaqueFaceIndices().ranges();
@@ -482,12 +675,16 @@ namespace TrenchBroom {
             const IndexArray transparentIndices = IndexArray::swap(collectIndices.transparentFaceIndices().indices());
             const TexturedIndexArrayMap& transparentRanges = collectIndices.transparentFaceIndices().ranges();
             
-            m_opaqueFaceRenderer = FaceRenderer(m_vertexArray, opaqueIndices, opaqueRanges, m_faceColor);
-            m_transparentFaceRenderer = FaceRenderer(m_vertexArray, transparentIndices, transparentRanges, m_faceColor);
+            chunk.opaqueFaceRenderer = FaceRenderer(chunk.vertexArray, opaqueIndices, opaqueRanges, m_faceColor);
+            chunk.transparentFaceRenderer = FaceRenderer(chunk.vertexArray, transparentIndices, transparentRanges, m_faceColor);
             
-            const IndexArray edgeIndices = IndexArray::swap(collectIndices.edgeIndices().indices());
+            chunk.edgeIndices = IndexArray::swap(collectIndices.edgeIndices().indices());
             const IndexArrayMap& edgeRanges = collectIndices.edgeIndices().ranges();
-            m_edgeRenderer = IndexedEdgeRenderer(m_vertexArray, edgeIndices, edgeRanges);
+            chunk.edgeRenderer = IndexedEdgeRenderer(chunk.vertexArray, chunk.edgeIndices, edgeRanges);
+            
+            chunk.pointIndices = IndexArray::swap(collectIndices.pointIndices());
+            chunk.edgeIndexCounts.swap(collectIndices.edgeIndexCounts());
+            chunk.pointIndexCounts.swap(collectIndices.pointIndexCounts());
         }
     }
 }
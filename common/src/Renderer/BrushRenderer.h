@@ -25,12 +25,16 @@
 #include "Renderer/EdgeRenderer.h"
 #include "Renderer/FaceRenderer.h"
 
+#include <unordered_map>
+#include <vector>
+
 namespace TrenchBroom {
     namespace Model {
         class EditorContext;
     }
     
     namespace Renderer {
+        class FaceDrawList;
         class RenderBatch;
         class RenderContext;
         class Vbo;
@@ -104,20 +108,71 @@ namespace TrenchBroom {
                 NoFilter(const NoFilter& other);
                 NoFilter& operator=(const NoFilter& other);
             };
+            
+            /**
+             * The edge and point indices of a chunk which are rendered for a given minimum detail size. The edges of
+             * the first detailBrushCount brushes are rendered as lines, and the remaining brushes are rendered as
+             * points.
+             */
+            struct EdgeRanges {
+                size_t detailBrushCount;
+                size_t edgeIndexCount;
+                size_t pointIndexOffset;
+                size_t pointIndexCount;
+                
+                EdgeRanges(size_t i_detailBrushCount, size_t i_edgeIndexCount, size_t i_pointIndexOffset, size_t i_pointIndexCount);
+            };
+            
+            static void sortBrushes(Model::BrushList& brushes, std::vector<FloatType>& brushSizes);
+            static EdgeRanges edgeRanges(const std::vector<FloatType>& brushSizes, const std::vector<size_t>& edgeIndexCounts, const std::vector<size_t>& pointIndexCounts, FloatType minDetailSize);
         private:
             class FilterWrapper;
             class CountVertices;
             class CollectVertices;
             class CountIndices;
             class CollectIndices;
+            
+            /**
+             * The brushes are partitioned into chunks which are validated separately, so that adding or removing a
+             * few brushes only rebuilds the vertex and index arrays of the chunks that contain them.
+             */
+            struct Chunk {
+                Model::BrushList brushes;
+                VertexArray vertexArray;
+                FaceRenderer opaqueFaceRenderer;
+                FaceRenderer transparentFaceRenderer;
+                IndexedEdgeRenderer edgeRenderer;
+                bool valid;
+                
+                /*
+                 * The brushes are sorted by decreasing size so that the edges of all brushes above a given size form
+                 * a prefix of the edge indices. In orthographic views, brushes which are too small to be discerned
+                 * are rendered as a single point each instead, using the point indices which are stored in the same
+                 * order. The counts are cumulative, i.e. the i-th count is the number of indices of the first i
+                 * brushes.
+                 */
+                IndexArray edgeIndices;
+                IndexArray pointIndices;
+                std::vector<FloatType> brushSizes;
+                std::vector<size_t> edgeIndexCounts;
+                std::vector<size_t> pointIndexCounts;
+                
+                Chunk();
+            };
+            
+            typedef std::vector<Chunk*> ChunkList;
+            typedef std::unordered_map<const Model::Brush*, Chunk*> ChunkMap;
+            
+            static const size_t MaxChunkSize = 4096;
+            
+            /**
+             * In orthographic views, brushes whose size in pixels is below this value are rendered as points.
+             */
+            static const float MinDetailSize;
         private:
             Filter* m_filter;
-            Model::BrushList m_brushes;
-            VertexArray m_vertexArray;
-            FaceRenderer m_opaqueFaceRenderer;
-            FaceRenderer m_transparentFaceRenderer;
-            IndexedEdgeRenderer m_edgeRenderer;
-            bool m_valid;
+            ChunkList m_chunks;
+            ChunkMap m_brushChunks;
             
             Color m_faceColor;
             bool m_showEdges;
@@ -134,7 +189,6 @@ namespace TrenchBroom {
             template <typename FilterT>
             BrushRenderer(const FilterT& filter) :
             m_filter(new FilterT(filter)),
-            m_valid(true),
             m_showEdges(false),
             m_grayscale(false),
             m_tint(false),
@@ -147,9 +201,12 @@ namespace TrenchBroom {
             ~BrushRenderer();
 
             void addBrushes(const Model::BrushList& brushes);
+            void removeBrushes(const Model::BrushList& brushes);
             void setBrushes(const Model::BrushList& brushes);
             void clear();
             
+            size_t chunkCount() const;
+            
             void invalidate();
             
             void setFaceColor(const Color& faceColor);
@@ -166,14 +223,27 @@ namespace TrenchBroom {
             void render(RenderContext& renderContext, RenderBatch& renderBatch);
             void renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch);
             void renderTransparent(RenderContext& renderContext, RenderBatch& renderBatch);
+            
+            /**
+             * Adds the opaque faces to the given draw list instead of the render batch so that they can be rendered
+             * together with the faces of other renderers. The edges are still added to the render batch.
+             */
+            void renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch, FaceDrawList& faceDrawList);
+            void renderTransparent(RenderContext& renderContext, FaceDrawList& faceDrawList);
         private:
-            void renderOpaqueFaces(RenderBatch& renderBatch);
-            void renderTransparentFaces(RenderBatch& renderBatch);
-            void renderEdges(RenderBatch& renderBatch);
+            void renderOpaqueFaces(Chunk& chunk, FaceDrawList& faceDrawList);
+            void renderTransparentFaces(Chunk& chunk, FaceDrawList& faceDrawList);
+            void renderEdges(Chunk& chunk, FloatType minDetailSize, RenderBatch& renderBatch);
+            void renderEdges(IndexedEdgeRenderer& edgeRenderer, RenderBatch& renderBatch);
+            FloatType minDetailSize(const RenderContext& renderContext) const;
+            
+            void addBrush(Model::Brush* brush);
+            Chunk* findChunkWithSpace();
+            void releaseEmptyChunks();
             
             void validate();
-            void validateVertices();
-            void validateIndices();
+            void validateVertices(Chunk& chunk);
+            void validateIndices(Chunk& chunk);
         private:
             BrushRenderer(const BrushRenderer& other);
             BrushRenderer& operator=(const BrushRenderer& other);
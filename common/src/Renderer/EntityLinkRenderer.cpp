@@ -41,7 +41,8 @@ namespace TrenchBroom {
         m_document(document),
         m_defaultColor(0.5f, 1.0f, 0.5f, 1.0f),
         m_selectedColor(1.0f, 0.0f, 0.0f, 1.0f),
-        m_valid(false) {}
+        m_valid(false),
+        m_allLinksValid(false) {}
         
         void EntityLinkRenderer::setDefaultColor(const Color& color) {
             if (color == m_defaultColor)
@@ -63,8 +64,11 @@ namespace TrenchBroom {
 
         void EntityLinkRenderer::invalidate() {
             m_valid = false;
+            m_allLinksValid = false;
+            m_allLinks.clear();
+            m_invalidLinkSources.clear();
         }
-
+        
         void EntityLinkRenderer::doPrepareVertices(Vbo& vertexVbo) {
             if (!m_valid) {
                 validate();
@@ -226,7 +230,60 @@ namespace TrenchBroom {
             }
         };
         
-        void EntityLinkRenderer::getLinks(Vertex::List& links) const {
+        void EntityLinkRenderer::invalidateSelection(const Model::NodeSet& nodes) {
+            m_valid = false;
+            if (!m_allLinksValid)
+                return;
+            
+            // the color of a link depends on the selection state of both of its ends
+            CollectEntitiesVisitor collectEntities;
+            Model::Node::accept(std::begin(nodes), std::end(nodes), collectEntities);
+            
+            for (Model::Node* node : collectEntities.nodes())
+                invalidateLinks(static_cast<Model::Entity*>(node));
+        }
+        
+        void EntityLinkRenderer::invalidateNodes(const Model::NodeList& nodes) {
+            m_valid = false;
+            if (!m_allLinksValid)
+                return;
+            
+            // A change to a brush or group can move the anchors of its containing or contained entities. This is
+            // called both before and after the change so that the links of the previous and the current sources and
+            // targets are regenerated.
+            CollectEntitiesVisitor collectEntities;
+            Model::Node::acceptAndRecurse(std::begin(nodes), std::end(nodes), collectEntities);
+            Model::Node::acceptAndEscalate(std::begin(nodes), std::end(nodes), collectEntities);
+            
+            for (Model::Node* node : collectEntities.nodes())
+                invalidateLinks(static_cast<Model::Entity*>(node));
+        }
+        
+        void EntityLinkRenderer::removeNodes(const Model::NodeList& nodes) {
+            m_valid = false;
+            if (!m_allLinksValid)
+                return;
+            
+            CollectEntitiesVisitor collectEntities;
+            Model::Node::acceptAndRecurse(std::begin(nodes), std::end(nodes), collectEntities);
+            
+            for (Model::Node* node : collectEntities.nodes()) {
+                Model::Entity* entity = static_cast<Model::Entity*>(node);
+                m_allLinks.erase(entity);
+                m_invalidLinkSources.erase(entity);
+            }
+        }
+        
+        void EntityLinkRenderer::invalidateLinks(Model::Entity* entity) {
+            // links are cached by source, so a link must be regenerated if either of its ends has changed
+            m_invalidLinkSources.insert(entity);
+            m_invalidLinkSources.insert(std::begin(entity->linkSources()), std::end(entity->linkSources()));
+            m_invalidLinkSources.insert(std::begin(entity->killSources()), std::end(entity->killSources()));
+            m_invalidLinkSources.insert(std::begin(entity->linkTargets()), std::end(entity->linkTargets()));
+            m_invalidLinkSources.insert(std::begin(entity->killTargets()), std::end(entity->killTargets()));
+        }
+
+        void EntityLinkRenderer::getLinks(Vertex::List& links) {
             View::MapDocumentSPtr document = lock(m_document);
             const Model::EditorContext& editorContext = document->editorContext();
             switch (editorContext.entityLinkMode()) {
@@ -245,15 +302,51 @@ namespace TrenchBroom {
             }
         }
         
-        void EntityLinkRenderer::getAllLinks(Vertex::List& links) const {
+        void EntityLinkRenderer::getAllLinks(Vertex::List& links) {
+            if (!m_allLinksValid) {
+                validateAllLinks();
+            } else {
+                for (Model::AttributableNode* source : m_invalidLinkSources)
+                    validateLinks(source);
+            }
+            m_invalidLinkSources.clear();
+            
+            size_t vertexCount = 0;
+            for (const auto& entry : m_allLinks)
+                vertexCount += entry.second.size();
+            
+            links.reserve(vertexCount);
+            for (const auto& entry : m_allLinks)
+                VectorUtils::append(links, entry.second);
+        }
+        
+        void EntityLinkRenderer::validateAllLinks() {
+            m_allLinks.clear();
+            
+            View::MapDocumentSPtr document = lock(m_document);
+            Model::World* world = document->world();
+            if (world != nullptr) {
+                CollectEntitiesVisitor collectEntities;
+                world->acceptAndRecurse(collectEntities);
+                
+                for (Model::Node* node : collectEntities.nodes())
+                    validateLinks(static_cast<Model::Entity*>(node));
+            }
+            m_allLinksValid = true;
+        }
+        
+        void EntityLinkRenderer::validateLinks(Model::AttributableNode* source) {
             View::MapDocumentSPtr document = lock(m_document);
             const Model::EditorContext& editorContext = document->editorContext();
             
+            Vertex::List links;
             CollectAllLinksVisitor collectLinks(editorContext, m_defaultColor, m_selectedColor, links);
+            source->accept(collectLinks);
             
-            Model::World* world = document->world();
-            if (world != nullptr)
-                world->acceptAndRecurse(collectLinks);
+            if (links.empty())
+                m_allLinks.erase(source);
+            else
+                m_allLinks[source] = links;
         }
         
         void EntityLinkRenderer::getTransitiveSelectedLinks(Vertex::List& links) const {
@@ -27,6 +27,8 @@
 #include "Renderer/VertexArray.h"
 #include "View/ViewTypes.h"
 
+#include <map>
+
 namespace TrenchBroom {
     namespace Model {
         class EditorContext;
@@ -39,6 +41,7 @@ namespace TrenchBroom {
         class EntityLinkRenderer : public DirectRenderable {
         private:
             typedef VertexSpecs::P3C4::Vertex Vertex;
+            typedef std::map<Model::AttributableNode*, Vertex::List> LinkCache;
             
             View::MapDocumentWPtr m_document;
             
@@ -47,6 +50,14 @@ namespace TrenchBroom {
             
             VertexArray m_entityLinks;
             bool m_valid;
+            
+            /**
+             * When all links are shown, the links are cached per source entity so that a selection change only
+             * regenerates the vertices of the links that touch an entity whose selection state has changed.
+             */
+            LinkCache m_allLinks;
+            bool m_allLinksValid;
+            Model::AttributableNodeSet m_invalidLinkSources;
         public:
             EntityLinkRenderer(View::MapDocumentWPtr document);
             
@@ -55,6 +66,9 @@ namespace TrenchBroom {
             
             void render(RenderContext& renderContext, RenderBatch& renderBatch);
             void invalidate();
+            void invalidateSelection(const Model::NodeSet& nodes);
+            void invalidateNodes(const Model::NodeList& nodes);
+            void removeNodes(const Model::NodeList& nodes);
         private:
             void doPrepareVertices(Vbo& vertexVbo) override;
             void doRender(RenderContext& renderContext) override;
@@ -69,8 +83,12 @@ namespace TrenchBroom {
             class CollectTransitiveSelectedLinksVisitor;
             class CollectDirectSelectedLinksVisitor;
 
-            void getLinks(Vertex::List& links) const;
-            void getAllLinks(Vertex::List& links) const;
+            void invalidateLinks(Model::Entity* entity);
+            
+            void getLinks(Vertex::List& links);
+            void getAllLinks(Vertex::List& links);
+            void validateAllLinks();
+            void validateLinks(Model::AttributableNode* source);
             void getTransitiveSelectedLinks(Vertex::List& links) const;
             void getDirectSelectedLinks(Vertex::List& links) const;
             void collectSelectedLinks(CollectLinksVisitor& collectLinks) const;
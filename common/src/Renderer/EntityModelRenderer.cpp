@@ -33,12 +33,21 @@
 #include "Renderer/ShaderManager.h"
 #include "Renderer/TexturedIndexRangeRenderer.h"
 #include "Renderer/Transformation.h"
+#include "Renderer/Vbo.h"
+#include "Renderer/VboBlock.h"
 
 namespace TrenchBroom {
     namespace Renderer {
+        EntityModelRenderer::InstanceGroup::InstanceGroup(TexturedIndexRangeRenderer* i_renderer, const size_t i_offset, const size_t i_count) :
+        renderer(i_renderer),
+        offset(i_offset),
+        count(i_count) {}
+
         EntityModelRenderer::EntityModelRenderer(Assets::EntityModelManager& entityModelManager, const Model::EditorContext& editorContext) :
         m_entityModelManager(entityModelManager),
         m_editorContext(editorContext),
+        m_instanceBlock(nullptr),
+        m_instancesValid(false),
         m_applyTinting(false),
         m_showHiddenEntities(false) {}
 
@@ -48,14 +57,21 @@ namespace TrenchBroom {
         
         void EntityModelRenderer::addEntity(Model::Entity* entity) {
             const Assets::ModelSpecification& modelSpec = entity->modelSpecification();
-            TexturedIndexRangeRenderer* renderer = m_entityModelManager.renderer(modelSpec);
-            if (renderer != nullptr)
+            m_entityModelManager.requestModel(modelSpec.path);
+            TexturedIndexRangeRenderer* renderer = m_entityModelManager.rendererIfLoaded(modelSpec);
+            if (renderer != nullptr) {
                 m_entities.insert(std::make_pair(entity, renderer));
+                invalidateInstances();
+            }
         }
         
         void EntityModelRenderer::updateEntity(Model::Entity* entity) {
+            // the entity's transformation or visibility may have changed even if its model did not
+            invalidateInstances();
+            
             const Assets::ModelSpecification& modelSpec = entity->modelSpecification();
-            TexturedIndexRangeRenderer* renderer = m_entityModelManager.renderer(modelSpec);
+            m_entityModelManager.requestModel(modelSpec.path);
+            TexturedIndexRangeRenderer* renderer = m_entityModelManager.rendererIfLoaded(modelSpec);
             EntityMap::iterator it = m_entities.find(entity);
             
             if (renderer == nullptr && it == std::end(m_entities))
@@ -71,8 +87,17 @@ namespace TrenchBroom {
             }
         }
 
+        void EntityModelRenderer::removeEntity(Model::Entity* entity) {
+            if (m_entities.erase(entity) > 0)
+                invalidateInstances();
+        }
+
         void EntityModelRenderer::clear() {
             m_entities.clear();
+            m_instanceTransforms.clear();
+            m_instanceGroups.clear();
+            freeInstanceBlock();
+            invalidateInstances();
         }
 
         bool EntityModelRenderer::applyTinting() const {
@@ -96,7 +121,10 @@ namespace TrenchBroom {
         }
         
         void EntityModelRenderer::setShowHiddenEntities(const bool showHiddenEntities) {
-            m_showHiddenEntities = showHiddenEntities;
+            if (showHiddenEntities != m_showHiddenEntities) {
+                m_showHiddenEntities = showHiddenEntities;
+                invalidateInstances();
+            }
         }
 
         void EntityModelRenderer::render(RenderBatch& renderBatch) {
@@ -105,9 +133,55 @@ namespace TrenchBroom {
 
         void EntityModelRenderer::doPrepareVertices(Vbo& vertexVbo) {
             m_entityModelManager.prepare(vertexVbo);
+            validateInstances(vertexVbo);
         }
         
         void EntityModelRenderer::doRender(RenderContext& renderContext) {
+            if (m_instanceGroups.empty())
+                return;
+            
+            glAssert(glEnable(GL_TEXTURE_2D));
+            glAssert(glActiveTexture(GL_TEXTURE0));
+            
+            if (m_instanceBlock != nullptr)
+                renderInstanced(renderContext);
+            else
+                renderIndividually(renderContext);
+        }
+        
+        void EntityModelRenderer::renderInstanced(RenderContext& renderContext) {
+            PreferenceManager& prefs = PreferenceManager::instance();
+            
+            ActiveShader shader(renderContext.shaderManager(), Shaders::EntityModelInstancedShader);
+            shader.set("Brightness", prefs.get(Preferences::Brightness));
+            shader.set("ApplyTinting", m_applyTinting);
+            shader.set("TintColor", m_tintColor);
+            shader.set("GrayScale", false);
+            shader.set("Texture", 0);
+            
+            // a mat4 attribute occupies four consecutive locations, one per column
+            const GLuint location = static_cast<GLuint>(shader.attributeLocation("InstanceMatrix"));
+            for (GLuint i = 0; i < 4; ++i) {
+                glAssert(glEnableVertexAttribArray(location + i));
+                glAssert(glVertexAttribDivisor(location + i, 1));
+            }
+            
+            for (const InstanceGroup& group : m_instanceGroups) {
+                const size_t offset = m_instanceBlock->offset() + group.offset * sizeof(Mat4x4f);
+                for (GLuint i = 0; i < 4; ++i) {
+                    const size_t columnOffset = offset + i * sizeof(Vec4f);
+                    glAssert(glVertexAttribPointer(location + i, 4, GL_FLOAT, GL_FALSE, sizeof(Mat4x4f), reinterpret_cast<const GLvoid*>(columnOffset)));
+                }
+                group.renderer->renderInstanced(group.count);
+            }
+            
+            for (GLuint i = 0; i < 4; ++i) {
+                glAssert(glVertexAttribDivisor(location + i, 0));
+                glAssert(glDisableVertexAttribArray(location + i));
+            }
+        }
+        
+        void EntityModelRenderer::renderIndividually(RenderContext& renderContext) {
             PreferenceManager& prefs = PreferenceManager::instance();
             
             ActiveShader shader(renderContext.shaderManager(), Shaders::EntityModelShader);
@@ -117,22 +191,86 @@ namespace TrenchBroom {
             shader.set("GrayScale", false);
             shader.set("Texture", 0);
             
-            glAssert(glEnable(GL_TEXTURE_2D));
-            glAssert(glActiveTexture(GL_TEXTURE0));
+            for (const InstanceGroup& group : m_instanceGroups) {
+                for (size_t i = 0; i < group.count; ++i) {
+                    MultiplyModelMatrix multMatrix(renderContext.transformation(), m_instanceTransforms[group.offset + i]);
+                    group.renderer->render();
+                }
+            }
+        }
+        
+        bool EntityModelRenderer::instancingSupported() {
+            static const bool supported = glewIsSupported("GL_ARB_draw_instanced GL_ARB_instanced_arrays") == GL_TRUE;
+            return supported;
+        }
+        
+        void EntityModelRenderer::invalidateInstances() {
+            m_instancesValid = false;
+        }
+        
+        void EntityModelRenderer::validateInstances(Vbo& vertexVbo) {
+            if (m_instanceBlock != nullptr && &m_instanceBlock->vbo() != &vertexVbo)
+                invalidateInstances();
+            
+            if (!m_instancesValid) {
+                buildInstanceGroups();
+                freeInstanceBlock();
+                if (!m_instanceTransforms.empty() && instancingSupported())
+                    uploadInstances(vertexVbo);
+                m_instancesValid = true;
+            }
+        }
+        
+        void EntityModelRenderer::buildInstanceGroups() {
+            InstanceList instances;
+            instances.reserve(m_entities.size());
             
             for (const auto& entry : m_entities) {
                 Model::Entity* entity = entry.first;
                 if (!m_showHiddenEntities && !m_editorContext.visible(entity))
                     continue;
                 
-                TexturedIndexRangeRenderer* renderer = entry.second;
-                
                 const Mat4x4f translation(translationMatrix(entity->origin()));
                 const Mat4x4f rotation(entity->rotation());
-                const Mat4x4f matrix = translation * rotation;
-                MultiplyModelMatrix multMatrix(renderContext.transformation(), matrix);
-                
-                renderer->render();
+                instances.push_back(Instance(entry.second, translation * rotation));
+            }
+            
+            buildInstanceGroups(instances, m_instanceTransforms, m_instanceGroups);
+        }
+        
+        void EntityModelRenderer::buildInstanceGroups(const InstanceList& instances, TransformList& transforms, InstanceGroupList& groups) {
+            typedef std::map<TexturedIndexRangeRenderer*, TransformList> RendererTransformMap;
+            RendererTransformMap rendererTransforms;
+            
+            for (const Instance& instance : instances)
+                rendererTransforms[instance.first].push_back(instance.second);
+            
+            transforms.clear();
+            transforms.reserve(instances.size());
+            groups.clear();
+            groups.reserve(rendererTransforms.size());
+            
+            for (const auto& entry : rendererTransforms) {
+                const TransformList& groupTransforms = entry.second;
+                groups.push_back(InstanceGroup(entry.first, transforms.size(), groupTransforms.size()));
+                VectorUtils::append(transforms, groupTransforms);
+            }
+        }
+        
+        void EntityModelRenderer::uploadInstances(Vbo& vertexVbo) {
+            assert(m_instanceBlock == nullptr);
+            
+            ActivateVbo activate(vertexVbo);
+            m_instanceBlock = vertexVbo.allocateBlock(m_instanceTransforms.size() * sizeof(Mat4x4f));
+            
+            MapVboBlock map(m_instanceBlock);
+            m_instanceBlock->writeBuffer(0, m_instanceTransforms);
+        }
+        
+        void EntityModelRenderer::freeInstanceBlock() {
+            if (m_instanceBlock != nullptr) {
+                m_instanceBlock->free();
+                m_instanceBlock = nullptr;
             }
         }
     }
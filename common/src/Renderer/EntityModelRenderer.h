@@ -21,12 +21,15 @@
 #define TrenchBroom_EntityModelRenderer
 
 #include "Color.h"
+#include "Mat.h"
 #include "Assets/ModelDefinition.h"
 #include "Model/ModelTypes.h"
 #include "Renderer/Renderable.h"
 
 #include <map>
 #include <set>
+#include <utility>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Assets {
@@ -43,8 +46,26 @@ namespace TrenchBroom {
         class RenderBatch;
         class RenderContext;
         class TexturedIndexRangeRenderer;
+        class VboBlock;
         
         class EntityModelRenderer : public DirectRenderable {
+        public:
+            typedef std::vector<Mat4x4f> TransformList;
+            typedef std::pair<TexturedIndexRangeRenderer*, Mat4x4f> Instance;
+            typedef std::vector<Instance> InstanceList;
+            
+            /**
+             A run of consecutive instance transforms that are all rendered with the same model renderer, i.e.,
+             the same model, skin and frame.
+             */
+            struct InstanceGroup {
+                TexturedIndexRangeRenderer* renderer;
+                size_t offset;
+                size_t count;
+                
+                InstanceGroup(TexturedIndexRangeRenderer* i_renderer, size_t i_offset, size_t i_count);
+            };
+            typedef std::vector<InstanceGroup> InstanceGroupList;
         private:
             typedef std::map<Model::Entity*, TexturedIndexRangeRenderer*> EntityMap;
             
@@ -53,6 +74,11 @@ namespace TrenchBroom {
             
             EntityMap m_entities;
             
+            TransformList m_instanceTransforms;
+            InstanceGroupList m_instanceGroups;
+            VboBlock* m_instanceBlock;
+            bool m_instancesValid;
+            
             bool m_applyTinting;
             Color m_tintColor;
             
@@ -82,9 +108,18 @@ namespace TrenchBroom {
                     ++cur;
                 }
             }
+            
+            template <typename I>
+            void removeEntities(I cur, I end) {
+                while (cur != end) {
+                    removeEntity(*cur);
+                    ++cur;
+                }
+            }
 
             void addEntity(Model::Entity* entity);
             void updateEntity(Model::Entity* entity);
+            void removeEntity(Model::Entity* entity);
             void clear();
             
             bool applyTinting() const;
@@ -96,9 +131,26 @@ namespace TrenchBroom {
             void setShowHiddenEntities(bool showHiddenEntities);
             
             void render(RenderBatch& renderBatch);
+            
+            /**
+             * Groups the given instances by their renderers. The transforms of each group are stored consecutively
+             * in the given transform list, in the order in which the instances were given.
+             */
+            static void buildInstanceGroups(const InstanceList& instances, TransformList& transforms, InstanceGroupList& groups);
         private:
             void doPrepareVertices(Vbo& vertexVbo) override;
             void doRender(RenderContext& renderContext) override;
+            
+            void renderInstanced(RenderContext& renderContext);
+            void renderIndividually(RenderContext& renderContext);
+            
+            static bool instancingSupported();
+            
+            void invalidateInstances();
+            void validateInstances(Vbo& vertexVbo);
+            void buildInstanceGroups();
+            void uploadInstances(Vbo& vertexVbo);
+            void freeInstanceBlock();
         };
     }
 }
@@ -76,11 +76,36 @@ namespace TrenchBroom {
         m_showHiddenEntities(false) {}
         
         void EntityRenderer::setEntities(const Model::EntityList& entities) {
-            m_entities = entities;
+            m_entities.clear();
+            m_entities.insert(std::begin(entities), std::end(entities));
             m_modelRenderer.setEntities(std::begin(m_entities), std::end(m_entities));
             invalidate();
         }
 
+        void EntityRenderer::addEntities(const Model::EntityList& entities) {
+            bool added = false;
+            for (Model::Entity* entity : entities) {
+                if (m_entities.insert(entity)) {
+                    m_modelRenderer.addEntity(entity);
+                    added = true;
+                }
+            }
+            if (added)
+                invalidateBounds();
+        }
+        
+        void EntityRenderer::removeEntities(const Model::EntityList& entities) {
+            bool removed = false;
+            for (Model::Entity* entity : entities) {
+                if (m_entities.erase(entity)) {
+                    m_modelRenderer.removeEntity(entity);
+                    removed = true;
+                }
+            }
+            if (removed)
+                invalidateBounds();
+        }
+
         void EntityRenderer::invalidate() {
             invalidateBounds();
             reloadModels();
@@ -95,6 +120,9 @@ namespace TrenchBroom {
 
         void EntityRenderer::reloadModels() {
             m_modelRenderer.updateEntities(std::begin(m_entities), std::end(m_entities));
+            
+            // entities whose models have become available are no longer rendered as solid boxes
+            invalidateBounds();
         }
 
         void EntityRenderer::setShowOverlays(const bool showOverlays) {
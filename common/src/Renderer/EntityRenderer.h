@@ -22,6 +22,7 @@
 
 #include "AttrString.h"
 #include "Color.h"
+#include "IndexedVector.h"
 #include "Model/ModelTypes.h"
 #include "Renderer/EdgeRenderer.h"
 #include "Renderer/EntityModelRenderer.h"
@@ -51,7 +52,7 @@ namespace TrenchBroom {
 
             Assets::EntityModelManager& m_entityModelManager;
             const Model::EditorContext& m_editorContext;
-            Model::EntityList m_entities;
+            IndexedVector<Model::Entity*> m_entities;
             
             DirectEdgeRenderer m_wireframeBoundsRenderer;
             TriangleRenderer m_solidBoundsRenderer;
@@ -75,6 +76,8 @@ namespace TrenchBroom {
             EntityRenderer(Assets::EntityModelManager& entityModelManager, const Model::EditorContext& editorContext);
 
             void setEntities(const Model::EntityList& entities);
+            void addEntities(const Model::EntityList& entities);
+            void removeEntities(const Model::EntityList& entities);
             void invalidate();
             void clear();
             void reloadModels();
@@ -0,0 +1,135 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FaceDrawList.h"
+
+#include "Renderer/FaceRenderer.h"
+#include "Renderer/GL.h"
+#include "Renderer/RenderContext.h"
+#include "Renderer/ShaderManager.h"
+#include "Renderer/ShaderProgram.h"
+#include "Renderer/Shaders.h"
+
+#include <algorithm>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        FaceDrawList::Stats::Stats() {
+            reset();
+        }
+        
+        void FaceDrawList::Stats::reset() {
+            stateChanges = 0;
+            textureBinds = 0;
+            drawCalls = 0;
+        }
+        
+        FaceDrawList::FaceDrawList() {}
+        
+        bool FaceDrawList::empty() const {
+            return m_renderers.empty();
+        }
+        
+        void FaceDrawList::add(FaceRenderer* renderer) {
+            ensure(renderer != nullptr, "renderer is null");
+            if (!renderer->m_meshRenderer.empty())
+                m_renderers.push_back(renderer);
+        }
+        
+        void FaceDrawList::doPrepareVertices(Vbo& vertexVbo) {
+            for (FaceRenderer* renderer : m_renderers)
+                renderer->prepareVertices(vertexVbo);
+        }
+        
+        void FaceDrawList::doPrepareIndices(Vbo& indexVbo) {
+            for (FaceRenderer* renderer : m_renderers)
+                renderer->prepareIndices(indexVbo);
+        }
+        
+        void FaceDrawList::doRender(RenderContext& context) {
+            Stats localStats;
+            Stats& stats = context.faceDrawStats() != nullptr ? *context.faceDrawStats() : localStats;
+            
+            // group the renderers by render state, keeping the groups in the order in which they were first seen
+            std::vector<FaceRendererList> groups;
+            for (FaceRenderer* renderer : m_renderers) {
+                auto it = std::find_if(std::begin(groups), std::end(groups), [renderer](const FaceRendererList& group) {
+                    return group.front()->hasSameState(*renderer);
+                });
+                if (it == std::end(groups))
+                    groups.push_back(FaceRendererList(1, renderer));
+                else
+                    it->push_back(renderer);
+            }
+            
+            for (const FaceRendererList& group : groups)
+                render(context, group, stats);
+        }
+        
+        void FaceDrawList::render(RenderContext& context, const FaceRendererList& renderers, Stats& stats) {
+            FaceRenderer& first = *renderers.front();
+            
+            ActiveShader shader(context.shaderManager(), Shaders::FaceShader);
+            first.applyState(shader, context);
+            ++stats.stateChanges;
+            
+            FaceRenderer::RenderFunc func(shader, context.showTextures(), first.m_faceColor);
+            if (first.m_alpha < 1.0f)
+                glAssert(glDepthMask(GL_FALSE));
+            
+            bool bound = false;
+            const Assets::Texture* boundTexture = nullptr;
+            
+            for (FaceRenderer* renderer : renderers) {
+                if (!renderer->m_vertexArray.setup())
+                    continue;
+                
+                TexturedIndexArrayMap::TextureList textures = renderer->m_meshRenderer.textures();
+                if (bound) {
+                    auto it = std::find(std::begin(textures), std::end(textures), boundTexture);
+                    if (it != std::end(textures))
+                        std::iter_swap(std::begin(textures), it);
+                }
+                
+                for (const Assets::Texture* texture : textures) {
+                    if (!bound || texture != boundTexture) {
+                        if (bound)
+                            func.after(boundTexture);
+                        func.before(texture);
+                        ++stats.textureBinds;
+                        
+                        bound = true;
+                        boundTexture = texture;
+                    }
+                    
+                    renderer->m_meshRenderer.render(texture);
+                    ++stats.drawCalls;
+                }
+                
+                renderer->m_vertexArray.cleanup();
+            }
+            
+            if (bound)
+                func.after(boundTexture);
+            
+            if (first.m_alpha < 1.0f)
+                glAssert(glDepthMask(GL_TRUE));
+        }
+    }
+}
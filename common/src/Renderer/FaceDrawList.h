@@ -0,0 +1,73 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_FaceDrawList
+#define TrenchBroom_FaceDrawList
+
+#include "Renderer/Renderable.h"
+
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        class FaceRenderer;
+        class RenderContext;
+        class Vbo;
+        
+        /**
+         * Renders the faces of several face renderers together. Renderers with the same render state share a single
+         * shader setup, and the vertex array of every renderer is set up only once. A texture which is still bound
+         * when the next renderer starts is rendered first and not bound again.
+         *
+         * The faces are not rendered in the order in which their renderers were added, so only renderers whose
+         * faces may be rendered in any order should be added to the same list.
+         */
+        class FaceDrawList : public IndexedRenderable {
+        public:
+            struct Stats {
+                size_t stateChanges;
+                size_t textureBinds;
+                size_t drawCalls;
+                
+                Stats();
+                void reset();
+            };
+        private:
+            typedef std::vector<FaceRenderer*> FaceRendererList;
+            
+            FaceRendererList m_renderers;
+        public:
+            FaceDrawList();
+            
+            bool empty() const;
+            void add(FaceRenderer* renderer);
+        private:
+            void doPrepareVertices(Vbo& vertexVbo) override;
+            void doPrepareIndices(Vbo& indexVbo) override;
+            void doRender(RenderContext& context) override;
+            
+            void render(RenderContext& context, const FaceRendererList& renderers, Stats& stats);
+            
+            FaceDrawList(const FaceDrawList& other);
+            FaceDrawList& operator=(const FaceDrawList& other);
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_FaceDrawList) */
@@ -32,32 +32,26 @@
 
 namespace TrenchBroom {
     namespace Renderer {
-        struct FaceRenderer::RenderFunc : public TextureRenderFunc {
-            ActiveShader& shader;
-            bool applyTexture;
-            const Color& defaultColor;
-            
-            RenderFunc(ActiveShader& i_shader, const bool i_applyTexture, const Color& i_defaultColor) :
-            shader(i_shader),
-            applyTexture(i_applyTexture),
-            defaultColor(i_defaultColor) {}
-            
-            void before(const Assets::Texture* texture) override {
-                if (texture != nullptr) {
-                    texture->activate();
-                    shader.set("ApplyTexture", applyTexture);
-                    shader.set("Color", texture->averageColor());
-                } else {
-                    shader.set("ApplyTexture", false);
-                    shader.set("Color", defaultColor);
-                }
-            }
-            
-            void after(const Assets::Texture* texture) override {
-                if (texture != nullptr)
-                    texture->deactivate();
+        FaceRenderer::RenderFunc::RenderFunc(ActiveShader& i_shader, const bool i_applyTexture, const Color& i_defaultColor) :
+        shader(i_shader),
+        applyTexture(i_applyTexture),
+        defaultColor(i_defaultColor) {}
+        
+        void FaceRenderer::RenderFunc::before(const Assets::Texture* texture) {
+            if (texture != nullptr) {
+                texture->activate();
+                shader.set("ApplyTexture", applyTexture);
+                shader.set("Color", texture->averageColor());
+            } else {
+                shader.set("ApplyTexture", false);
+                shader.set("Color", defaultColor);
             }
-        };
+        }
+        
+        void FaceRenderer::RenderFunc::after(const Assets::Texture* texture) {
+            if (texture != nullptr)
+                texture->deactivate();
+        }
         
         FaceRenderer::FaceRenderer() :
         m_grayscale(false),
@@ -118,6 +112,35 @@ namespace TrenchBroom {
             renderBatch.add(this);
         }
 
+        bool FaceRenderer::hasSameState(const FaceRenderer& other) const {
+            return (m_faceColor == other.m_faceColor &&
+                    m_grayscale == other.m_grayscale &&
+                    m_tint == other.m_tint &&
+                    (!m_tint || m_tintColor == other.m_tintColor) &&
+                    m_alpha == other.m_alpha);
+        }
+        
+        void FaceRenderer::applyState(ActiveShader& shader, RenderContext& context) const {
+            PreferenceManager& prefs = PreferenceManager::instance();
+            
+            glAssert(glEnable(GL_TEXTURE_2D));
+            glAssert(glActiveTexture(GL_TEXTURE0));
+            shader.set("Brightness", prefs.get(Preferences::Brightness));
+            shader.set("RenderGrid", context.showGrid());
+            shader.set("GridSize", static_cast<float>(context.gridSize()));
+            shader.set("GridAlpha", prefs.get(Preferences::GridAlpha));
+            shader.set("ApplyTexture", context.showTextures());
+            shader.set("Texture", 0);
+            shader.set("ApplyTinting", m_tint);
+            if (m_tint)
+                shader.set("TintColor", m_tintColor);
+            shader.set("GrayScale", m_grayscale);
+            shader.set("CameraPosition", context.camera().position());
+            shader.set("ShadeFaces", context.shadeFaces());
+            shader.set("ShowFog", context.showFog());
+            shader.set("Alpha", m_alpha);
+        }
+        
         void FaceRenderer::doPrepareVertices(Vbo& vertexVbo) {
             m_vertexArray.prepare(vertexVbo);
         }
@@ -133,30 +156,9 @@ namespace TrenchBroom {
             if (m_vertexArray.setup()) {
                 ShaderManager& shaderManager = context.shaderManager();
                 ActiveShader shader(shaderManager, Shaders::FaceShader);
-                PreferenceManager& prefs = PreferenceManager::instance();
-                
-                const bool applyTexture = context.showTextures();
-                const bool shadeFaces = context.shadeFaces();
-                const bool showFog = context.showFog();
-                
-                glAssert(glEnable(GL_TEXTURE_2D));
-                glAssert(glActiveTexture(GL_TEXTURE0));
-                shader.set("Brightness", prefs.get(Preferences::Brightness));
-                shader.set("RenderGrid", context.showGrid());
-                shader.set("GridSize", static_cast<float>(context.gridSize()));
-                shader.set("GridAlpha", prefs.get(Preferences::GridAlpha));
-                shader.set("ApplyTexture", applyTexture);
-                shader.set("Texture", 0);
-                shader.set("ApplyTinting", m_tint);
-                if (m_tint)
-                    shader.set("TintColor", m_tintColor);
-                shader.set("GrayScale", m_grayscale);
-                shader.set("CameraPosition", context.camera().position());
-                shader.set("ShadeFaces", shadeFaces);
-                shader.set("ShowFog", showFog);
-                shader.set("Alpha", m_alpha);
+                applyState(shader, context);
                 
-                RenderFunc func(shader, applyTexture, m_faceColor);
+                RenderFunc func(shader, context.showTextures(), m_faceColor);
                 if (m_alpha < 1.0f) {
                     glAssert(glDepthMask(GL_FALSE));
                     m_meshRenderer.render(func);
@@ -24,6 +24,7 @@
 #include "Assets/AssetTypes.h"
 #include "Model/BrushFace.h"
 #include "Renderer/Renderable.h"
+#include "Renderer/RenderUtils.h"
 #include "Renderer/TexturedIndexArrayRenderer.h"
 #include "Renderer/VertexArray.h"
 
@@ -39,7 +40,17 @@ namespace TrenchBroom {
         
         class FaceRenderer : public IndexedRenderable {
         private:
-            struct RenderFunc;
+            friend class FaceDrawList;
+            
+            struct RenderFunc : public TextureRenderFunc {
+                ActiveShader& shader;
+                bool applyTexture;
+                const Color& defaultColor;
+                
+                RenderFunc(ActiveShader& i_shader, bool i_applyTexture, const Color& i_defaultColor);
+                void before(const Assets::Texture* texture) override;
+                void after(const Assets::Texture* texture) override;
+            };
             
             VertexArray m_vertexArray;
             TexturedIndexArrayRenderer m_meshRenderer;
@@ -63,6 +74,9 @@ namespace TrenchBroom {
             
             void render(RenderBatch& renderBatch);
         private:
+            bool hasSameState(const FaceRenderer& other) const;
+            void applyState(ActiveShader& shader, RenderContext& context) const;
+            
             void doPrepareVertices(Vbo& vertexVbo) override;
             void doPrepareIndices(Vbo& indexVbo) override;
             void doRender(RenderContext& context) override;
@@ -53,6 +53,7 @@ namespace TrenchBroom {
     }
 
     Func0<void> glewInitialize;
+    Func1<GLboolean, const char*> glewIsSupported;
     
     Func0<GLenum> glGetError;
     Func1<const GLubyte*, GLenum> glGetString;
@@ -104,6 +105,13 @@ namespace TrenchBroom {
     Func4<void, GLenum, GLintptr, GLsizeiptr, const GLvoid*> glBufferSubData;
     Func2<GLvoid*, GLenum, GLenum> glMapBuffer;
     Func1<GLboolean, GLenum> glUnmapBuffer;
+    Func4<void, GLenum, GLsizeiptr, const GLvoid*, GLbitfield> glBufferStorage;
+    Func4<GLvoid*, GLenum, GLintptr, GLsizeiptr, GLbitfield> glMapBufferRange;
+    
+    Func2<GLsync, GLenum, GLbitfield> glFenceSync;
+    Func3<GLenum, GLsync, GLbitfield, GLuint64> glClientWaitSync;
+    Func1<void, GLsync> glDeleteSync;
+    Func0<void> glFinish;
     
     Func1<void, GLuint> glEnableVertexAttribArray;
     Func1<void, GLuint> glDisableVertexAttribArray;
@@ -112,6 +120,7 @@ namespace TrenchBroom {
     Func1<void, GLenum> glClientActiveTexture;
     
     Func6<void, GLuint, GLint, GLenum, GLboolean, GLsizei, const GLvoid*> glVertexAttribPointer;
+    Func2<void, GLuint, GLuint> glVertexAttribDivisor;
     Func4<void, GLint, GLenum, GLsizei, const GLvoid*> glVertexPointer;
     Func3<void, GLenum, GLsizei, const GLvoid*> glNormalPointer;
     Func4<void, GLint, GLenum, GLsizei, const GLvoid*> glColorPointer;
@@ -119,6 +128,7 @@ namespace TrenchBroom {
     
     Func3<void, GLenum, GLint, GLsizei> glDrawArrays;
     Func4<void, GLenum, const GLint*, const GLsizei*, GLsizei> glMultiDrawArrays;
+    Func4<void, GLenum, GLint, GLsizei, GLsizei> glDrawArraysInstanced;
     Func4<void, GLenum, GLsizei, GLenum, const GLvoid*> glDrawElements;
     Func6<void, GLenum, GLuint, GLuint, GLsizei, GLenum, const GLvoid*> glDrawRangeElements;
     Func5<void, GLenum, const GLsizei*, GLenum, const GLvoid**, GLsizei> glMultiDrawElements;
@@ -176,6 +186,7 @@ namespace TrenchBroom {
     Func4<void, GLint, GLsizei, GLboolean, const GLfloat*> glUniformMatrix4x3fv;
     
     Func2<GLint, GLuint, const GLchar*> glGetUniformLocation;
+    Func2<GLint, GLuint, const GLchar*> glGetAttribLocation;
     
 #ifdef __APPLE__
     Func2<void, GLenum, GLint> glFinishObjectAPPLE;
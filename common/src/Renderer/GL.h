@@ -25,8 +25,12 @@
 #include "StringUtils.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 
+// must match the declaration of GLsync in glew.h
+struct __GLsync;
+
 namespace TrenchBroom {
 #define GL_FALSE 0
 #define GL_TRUE 1
@@ -166,6 +170,18 @@ namespace TrenchBroom {
 #define GL_DYNAMIC_READ 0x88E9
 #define GL_DYNAMIC_COPY 0x88EA
 
+#define GL_MAP_READ_BIT 0x0001
+#define GL_MAP_WRITE_BIT 0x0002
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#define GL_MAP_COHERENT_BIT 0x0080
+
+#define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#define GL_ALREADY_SIGNALED 0x911A
+#define GL_TIMEOUT_EXPIRED 0x911B
+#define GL_CONDITION_SATISFIED 0x911C
+#define GL_WAIT_FAILED 0x911D
+
 #define GL_FRAGMENT_SHADER 0x8B30
 #define GL_VERTEX_SHADER 0x8B31
 #define GL_COMPILE_STATUS 0x8B81
@@ -197,6 +213,9 @@ namespace TrenchBroom {
     typedef ptrdiff_t GLintptr;
     typedef ptrdiff_t GLsizeiptr;
     
+    typedef uint64_t GLuint64;
+    typedef struct ::__GLsync* GLsync;
+    
     typedef char GLchar;
     typedef GLenum PrimType;
     
@@ -242,6 +261,7 @@ namespace TrenchBroom {
     template <typename T> GLenum glType() { return GLEnum<T>::Value; }
     
     extern Func0<void> glewInitialize;
+    extern Func1<GLboolean, const char*> glewIsSupported;
     
     extern Func0<GLenum> glGetError;
     extern Func1<const GLubyte*, GLenum> glGetString;
@@ -293,6 +313,13 @@ namespace TrenchBroom {
     extern Func4<void, GLenum, GLintptr, GLsizeiptr, const GLvoid*> glBufferSubData;
     extern Func2<GLvoid*, GLenum, GLenum> glMapBuffer;
     extern Func1<GLboolean, GLenum> glUnmapBuffer;
+    extern Func4<void, GLenum, GLsizeiptr, const GLvoid*, GLbitfield> glBufferStorage;
+    extern Func4<GLvoid*, GLenum, GLintptr, GLsizeiptr, GLbitfield> glMapBufferRange;
+    
+    extern Func2<GLsync, GLenum, GLbitfield> glFenceSync;
+    extern Func3<GLenum, GLsync, GLbitfield, GLuint64> glClientWaitSync;
+    extern Func1<void, GLsync> glDeleteSync;
+    extern Func0<void> glFinish;
     
     extern Func1<void, GLuint> glEnableVertexAttribArray;
     extern Func1<void, GLuint> glDisableVertexAttribArray;
@@ -301,6 +328,7 @@ namespace TrenchBroom {
     extern Func1<void, GLenum> glClientActiveTexture;
     
     extern Func6<void, GLuint, GLint, GLenum, GLboolean, GLsizei, const GLvoid*> glVertexAttribPointer;
+    extern Func2<void, GLuint, GLuint> glVertexAttribDivisor;
     extern Func4<void, GLint, GLenum, GLsizei, const GLvoid*> glVertexPointer;
     extern Func3<void, GLenum, GLsizei, const GLvoid*> glNormalPointer;
     extern Func4<void, GLint, GLenum, GLsizei, const GLvoid*> glColorPointer;
@@ -308,6 +336,7 @@ namespace TrenchBroom {
     
     extern Func3<void, GLenum, GLint, GLsizei> glDrawArrays;
     extern Func4<void, GLenum, const GLint*, const GLsizei*, GLsizei> glMultiDrawArrays;
+    extern Func4<void, GLenum, GLint, GLsizei, GLsizei> glDrawArraysInstanced;
     extern Func4<void, GLenum, GLsizei, GLenum, const GLvoid*> glDrawElements;
     extern Func6<void, GLenum, GLuint, GLuint, GLsizei, GLenum, const GLvoid*> glDrawRangeElements;
     extern Func5<void, GLenum, const GLsizei*, GLenum, const GLvoid**, GLsizei> glMultiDrawElements;
@@ -365,6 +394,7 @@ namespace TrenchBroom {
     extern Func4<void, GLint, GLsizei, GLboolean, const GLfloat*> glUniformMatrix4x3fv;
     
     extern Func2<GLint, GLuint, const GLchar*> glGetUniformLocation;
+    extern Func2<GLint, GLuint, const GLchar*> glGetAttribLocation;
 
 #ifdef __APPLE__
     extern Func2<void, GLenum, GLint> glFinishObjectAPPLE;
@@ -19,6 +19,7 @@
 
 #include "GroupRenderer.h"
 
+#include "CollectionUtils.h"
 #include "PreferenceManager.h"
 #include "Preferences.h"
 #include "Model/EditorContext.h"
@@ -58,7 +59,8 @@ namespace TrenchBroom {
         m_showOccludedBounds(false) {}
         
         void GroupRenderer::setGroups(const Model::GroupList& groups) {
-            m_groups = groups;
+            m_groups.clear();
+            m_groups.insert(std::begin(groups), std::end(groups));
             invalidate();
         }
 
@@ -71,6 +73,21 @@ namespace TrenchBroom {
             m_boundsRenderer = DirectEdgeRenderer();
         }
         
+        void GroupRenderer::addGroup(Model::Group* group) {
+            if (m_groups.insert(group)) {
+                invalidateBounds();
+            }
+        }
+        
+        void GroupRenderer::updateGroup(Model::Group* group) {
+            invalidateBounds();
+        }
+        
+        void GroupRenderer::removeGroup(Model::Group* group) {
+            if (m_groups.erase(group))
+                invalidateBounds();
+        }
+        
         void GroupRenderer::setShowOverlays(const bool showOverlays) {
             m_showOverlays = showOverlays;
         }
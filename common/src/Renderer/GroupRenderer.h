@@ -22,6 +22,7 @@
 
 #include "AttrString.h"
 #include "Color.h"
+#include "IndexedVector.h"
 #include "Model/ModelTypes.h"
 #include "Renderer/EdgeRenderer.h"
 
@@ -39,7 +40,7 @@ namespace TrenchBroom {
             class GroupNameAnchor;
             
             const Model::EditorContext& m_editorContext;
-            Model::GroupList m_groups;
+            IndexedVector<Model::Group*> m_groups;
             
             DirectEdgeRenderer m_boundsRenderer;
             bool m_boundsValid;
@@ -82,6 +83,10 @@ namespace TrenchBroom {
                 }
             }
             
+            void addGroup(Model::Group* group);
+            void updateGroup(Model::Group* group);
+            void removeGroup(Model::Group* group);
+            
             void setShowOverlays(bool showOverlays);
             void setOverlayTextColor(const Color& overlayTextColor);
             void setOverlayBackgroundColor(const Color& overlayBackgroundColor);
@@ -118,5 +118,14 @@ namespace TrenchBroom {
                 vertexArray.render(primType, indicesAndCounts.indices, indicesAndCounts.counts, primCount);
             }
         }
+
+        void IndexRangeMap::renderInstanced(VertexArray& vertexArray, const size_t instanceCount) const {
+            for (const auto& entry : *m_data) {
+                const PrimType primType = entry.first;
+                const IndicesAndCounts& indicesAndCounts = entry.second;
+                const GLsizei primCount = static_cast<GLsizei>(indicesAndCounts.size());
+                vertexArray.renderInstanced(primType, indicesAndCounts.indices, indicesAndCounts.counts, primCount, static_cast<GLsizei>(instanceCount));
+            }
+        }
     }
 }
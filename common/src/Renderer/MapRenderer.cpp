@@ -24,6 +24,7 @@
 #include "PreferenceManager.h"
 #include "Preferences.h"
 #include "Assets/EntityDefinitionManager.h"
+#include "Assets/EntityModelManager.h"
 #include "Model/Brush.h"
 #include "Model/CollectMatchingNodesVisitor.h"
 #include "Model/EditorContext.h"
@@ -37,6 +38,7 @@
 #include "Renderer/BrushRenderer.h"
 #include "Renderer/Camera.h"
 #include "Renderer/EntityLinkRenderer.h"
+#include "Renderer/FaceDrawList.h"
 #include "Renderer/ObjectRenderer.h"
 #include "Renderer/RenderBatch.h"
 #include "Renderer/RenderContext.h"
@@ -207,16 +209,29 @@ namespace TrenchBroom {
         void MapRenderer::render(RenderContext& renderContext, RenderBatch& renderBatch) {
             commitPendingChanges();
             setupGL(renderBatch);
-            renderDefaultOpaque(renderContext, renderBatch);
-            renderLockedOpaque(renderContext, renderBatch);
-            renderSelectionOpaque(renderContext, renderBatch);
             
-            renderDefaultTransparent(renderContext, renderBatch);
-            renderLockedTransparent(renderContext, renderBatch);
-            renderSelectionTransparent(renderContext, renderBatch);
+            // the faces of all renderers are drawn together before any of their edges
+            FaceDrawList* opaqueFaces = new FaceDrawList();
+            renderBatch.addOneShot(opaqueFaces);
+            
+            renderDefaultOpaque(renderContext, renderBatch, *opaqueFaces);
+            renderLockedOpaque(renderContext, renderBatch, *opaqueFaces);
+            renderSelectionOpaque(renderContext, renderBatch, *opaqueFaces);
+            
+            FaceDrawList* transparentFaces = new FaceDrawList();
+            renderBatch.addOneShot(transparentFaces);
+            
+            renderDefaultTransparent(renderContext, *transparentFaces);
+            renderLockedTransparent(renderContext, *transparentFaces);
+            renderSelectionTransparent(renderContext, *transparentFaces);
             
             renderEntityLinks(renderContext, renderBatch);
             renderTutorialMessages(renderContext, renderBatch);
+            
+            // the draw lists are only rendered with the batch, so the statistics are those of the previous frame
+            renderStatistics(renderContext, renderBatch);
+            if (renderContext.faceDrawStats() != nullptr)
+                renderContext.faceDrawStats()->reset();
         }
         
         void MapRenderer::commitPendingChanges() {
@@ -239,42 +254,55 @@ namespace TrenchBroom {
             renderBatch.addOneShot(new SetupGL());
         }
         
-        void MapRenderer::renderDefaultOpaque(RenderContext& renderContext, RenderBatch& renderBatch) {
+        void MapRenderer::renderDefaultOpaque(RenderContext& renderContext, RenderBatch& renderBatch, FaceDrawList& faceDrawList) {
             m_defaultRenderer->setShowOverlays(renderContext.render3D());
-            m_defaultRenderer->renderOpaque(renderContext, renderBatch);
+            m_defaultRenderer->renderOpaque(renderContext, renderBatch, faceDrawList);
         }
         
-        void MapRenderer::renderDefaultTransparent(RenderContext& renderContext, RenderBatch& renderBatch) {
+        void MapRenderer::renderDefaultTransparent(RenderContext& renderContext, FaceDrawList& faceDrawList) {
             m_defaultRenderer->setShowOverlays(renderContext.render3D());
-            m_defaultRenderer->renderTransparent(renderContext, renderBatch);
+            m_defaultRenderer->renderTransparent(renderContext, faceDrawList);
         }
         
-        void MapRenderer::renderSelectionOpaque(RenderContext& renderContext, RenderBatch& renderBatch) {
+        void MapRenderer::renderSelectionOpaque(RenderContext& renderContext, RenderBatch& renderBatch, FaceDrawList& faceDrawList) {
             if (!renderContext.hideSelection()) {
-                m_selectionRenderer->renderOpaque(renderContext, renderBatch);
+                m_selectionRenderer->renderOpaque(renderContext, renderBatch, faceDrawList);
             }
         }
         
-        void MapRenderer::renderSelectionTransparent(RenderContext& renderContext, RenderBatch& renderBatch) {
+        void MapRenderer::renderSelectionTransparent(RenderContext& renderContext, FaceDrawList& faceDrawList) {
             if (!renderContext.hideSelection()) {
-                m_selectionRenderer->renderTransparent(renderContext, renderBatch);
+                m_selectionRenderer->renderTransparent(renderContext, faceDrawList);
             }
         }
         
-        void MapRenderer::renderLockedOpaque(RenderContext& renderContext, RenderBatch& renderBatch) {
+        void MapRenderer::renderLockedOpaque(RenderContext& renderContext, RenderBatch& renderBatch, FaceDrawList& faceDrawList) {
             m_lockedRenderer->setShowOverlays(renderContext.render3D());
-            m_lockedRenderer->renderOpaque(renderContext, renderBatch);
+            m_lockedRenderer->renderOpaque(renderContext, renderBatch, faceDrawList);
         }
         
-        void MapRenderer::renderLockedTransparent(RenderContext& renderContext, RenderBatch& renderBatch) {
+        void MapRenderer::renderLockedTransparent(RenderContext& renderContext, FaceDrawList& faceDrawList) {
             m_lockedRenderer->setShowOverlays(renderContext.render3D());
-            m_lockedRenderer->renderTransparent(renderContext, renderBatch);
+            m_lockedRenderer->renderTransparent(renderContext, faceDrawList);
         }
         
         void MapRenderer::renderEntityLinks(RenderContext& renderContext, RenderBatch& renderBatch) {
             m_entityLinkRenderer->render(renderContext, renderBatch);
         }
         
+        void MapRenderer::renderStatistics(RenderContext& renderContext, RenderBatch& renderBatch) {
+            const FaceDrawList::Stats* stats = renderContext.faceDrawStats();
+            if (stats != nullptr && pref(Preferences::ShowRenderStatistics)) {
+                StringStream str;
+                str << "Faces: " << stats->stateChanges << " state changes, " << stats->textureBinds << " texture binds, " << stats->drawCalls << " draw calls";
+                
+                RenderService renderService(renderContext, renderBatch);
+                renderService.setForegroundColor(pref(Preferences::InfoOverlayTextColor));
+                renderService.setBackgroundColor(pref(Preferences::InfoOverlayBackgroundColor));
+                renderService.renderHeadsUp(str.str());
+            }
+        }
+        
         class MapRenderer::MatchTutorialEntities {
         private:
             const Assets::EntityDefinition* m_definition;
@@ -467,7 +495,29 @@ namespace TrenchBroom {
                                              collect.lockedNodes().entities(),
                                              collect.lockedNodes().brushes());
             }
-            invalidateEntityLinkRenderer();
+        }
+        
+        void MapRenderer::updateRenderers(const Model::NodeSet& nodes) {
+            CollectRenderableNodes collect(Renderer_All);
+            Model::Node::accept(std::begin(nodes), std::end(nodes), collect);
+            
+            Model::NodeCollection removed;
+            removed.addNodes(Model::NodeList(std::begin(nodes), std::end(nodes)));
+            
+            m_defaultRenderer->removeObjects(removed.groups(), removed.entities(), removed.brushes());
+            m_selectionRenderer->removeObjects(removed.groups(), removed.entities(), removed.brushes());
+            m_lockedRenderer->removeObjects(removed.groups(), removed.entities(), removed.brushes());
+            
+            m_defaultRenderer->addObjects(collect.defaultNodes().groups(),
+                                          collect.defaultNodes().entities(),
+                                          collect.defaultNodes().brushes());
+            m_selectionRenderer->addObjects(collect.selectedNodes().groups(),
+                                            collect.selectedNodes().entities(),
+                                            collect.selectedNodes().brushes());
+            m_lockedRenderer->addObjects(collect.lockedNodes().groups(),
+                                         collect.lockedNodes().entities(),
+                                         collect.lockedNodes().brushes());
+            m_entityLinkRenderer->invalidateSelection(nodes);
         }
         
         void MapRenderer::invalidateRenderers(Renderer renderers) {
@@ -496,7 +546,9 @@ namespace TrenchBroom {
             document->documentWasNewedNotifier.addObserver(this, &MapRenderer::documentWasNewedOrLoaded);
             document->documentWasLoadedNotifier.addObserver(this, &MapRenderer::documentWasNewedOrLoaded);
             document->nodesWereAddedNotifier.addObserver(this, &MapRenderer::nodesWereAdded);
+            document->nodesWillBeRemovedNotifier.addObserver(this, &MapRenderer::nodesWillBeRemoved);
             document->nodesWereRemovedNotifier.addObserver(this, &MapRenderer::nodesWereRemoved);
+            document->nodesWillChangeNotifier.addObserver(this, &MapRenderer::nodesWillChange);
             document->nodesDidChangeNotifier.addObserver(this, &MapRenderer::nodesDidChange);
             document->nodeVisibilityDidChangeNotifier.addObserver(this, &MapRenderer::nodeVisibilityDidChange);
             document->nodeLockingDidChangeNotifier.addObserver(this, &MapRenderer::nodeLockingDidChange);
@@ -509,6 +561,7 @@ namespace TrenchBroom {
             document->modsDidChangeNotifier.addObserver(this, &MapRenderer::modsDidChange);
             document->editorContextDidChangeNotifier.addObserver(this, &MapRenderer::editorContextDidChange);
             document->mapViewConfigDidChangeNotifier.addObserver(this, &MapRenderer::mapViewConfigDidChange);
+            document->entityModelManager().modelsWereLoadedNotifier.addObserver(this, &MapRenderer::entityModelsWereLoaded);
             
             PreferenceManager& prefs = PreferenceManager::instance();
             prefs.preferenceDidChangeNotifier.addObserver(this, &MapRenderer::preferenceDidChange);
@@ -521,7 +574,9 @@ namespace TrenchBroom {
                 document->documentWasNewedNotifier.removeObserver(this, &MapRenderer::documentWasNewedOrLoaded);
                 document->documentWasLoadedNotifier.removeObserver(this, &MapRenderer::documentWasNewedOrLoaded);
                 document->nodesWereAddedNotifier.removeObserver(this, &MapRenderer::nodesWereAdded);
+                document->nodesWillBeRemovedNotifier.removeObserver(this, &MapRenderer::nodesWillBeRemoved);
                 document->nodesWereRemovedNotifier.removeObserver(this, &MapRenderer::nodesWereRemoved);
+                document->nodesWillChangeNotifier.removeObserver(this, &MapRenderer::nodesWillChange);
                 document->nodesDidChangeNotifier.removeObserver(this, &MapRenderer::nodesDidChange);
                 document->nodeVisibilityDidChangeNotifier.removeObserver(this, &MapRenderer::nodeVisibilityDidChange);
                 document->nodeLockingDidChangeNotifier.removeObserver(this, &MapRenderer::nodeLockingDidChange);
@@ -534,6 +589,7 @@ namespace TrenchBroom {
                 document->modsDidChangeNotifier.removeObserver(this, &MapRenderer::modsDidChange);
                 document->editorContextDidChangeNotifier.removeObserver(this, &MapRenderer::editorContextDidChange);
                 document->mapViewConfigDidChangeNotifier.removeObserver(this, &MapRenderer::mapViewConfigDidChange);
+                document->entityModelManager().modelsWereLoadedNotifier.removeObserver(this, &MapRenderer::entityModelsWereLoaded);
             }
             
             PreferenceManager& prefs = PreferenceManager::instance();
@@ -549,21 +605,37 @@ namespace TrenchBroom {
             updateRenderers(Renderer_All);
         }
         
+        void MapRenderer::entityModelsWereLoaded() {
+            reloadEntityModels();
+        }
+
         void MapRenderer::nodesWereAdded(const Model::NodeList& nodes) {
             updateRenderers(Renderer_Default);
+            m_entityLinkRenderer->invalidateNodes(nodes);
+        }
+        
+        void MapRenderer::nodesWillBeRemoved(const Model::NodeList& nodes) {
+            // the links of the removed entities are only known before they are removed
+            m_entityLinkRenderer->invalidateNodes(nodes);
         }
         
         void MapRenderer::nodesWereRemoved(const Model::NodeList& nodes) {
             updateRenderers(Renderer_Default);
+            m_entityLinkRenderer->removeNodes(nodes);
+        }
+        
+        void MapRenderer::nodesWillChange(const Model::NodeList& nodes) {
+            m_entityLinkRenderer->invalidateNodes(nodes);
         }
         
         void MapRenderer::nodesDidChange(const Model::NodeList& nodes) {
             invalidateRenderers(Renderer_Selection);
-            invalidateEntityLinkRenderer();
+            m_entityLinkRenderer->invalidateNodes(nodes);
         }
         
         void MapRenderer::nodeVisibilityDidChange(const Model::NodeList& nodes) {
             updateRenderers(Renderer_All);
+            m_entityLinkRenderer->invalidateNodes(nodes);
         }
         
         void MapRenderer::nodeLockingDidChange(const Model::NodeList& nodes) {
@@ -583,7 +655,23 @@ namespace TrenchBroom {
         }
         
         void MapRenderer::selectionDidChange(const View::Selection& selection) {
-            updateRenderers(Renderer_All); // need to update locked objects also because a selected object may have been reparented into a locked layer before deselection
+            // Only the nodes whose selection state changed can move between renderers, so they are removed from all
+            // renderers (a selected object may have been reparented into a locked layer before deselection) and then
+            // classified again.
+            Model::NodeSet nodes;
+            nodes.insert(std::begin(selection.selectedNodes()), std::end(selection.selectedNodes()));
+            nodes.insert(std::begin(selection.deselectedNodes()), std::end(selection.deselectedNodes()));
+            nodes.insert(std::begin(selection.partiallySelectedNodes()), std::end(selection.partiallySelectedNodes()));
+            nodes.insert(std::begin(selection.partiallyDeselectedNodes()), std::end(selection.partiallyDeselectedNodes()));
+            nodes.insert(std::begin(selection.recursivelySelectedNodes()), std::end(selection.recursivelySelectedNodes()));
+            nodes.insert(std::begin(selection.recursivelyDeselectedNodes()), std::end(selection.recursivelyDeselectedNodes()));
+            
+            for (const Model::BrushFace* face : selection.selectedBrushFaces())
+                nodes.insert(face->brush());
+            for (const Model::BrushFace* face : selection.deselectedBrushFaces())
+                nodes.insert(face->brush());
+            
+            updateRenderers(nodes);
         }
         
         Model::BrushSet MapRenderer::collectBrushes(const Model::BrushFaceList& faces) {
@@ -37,6 +37,7 @@ namespace TrenchBroom {
     
     namespace Renderer {
         class EntityLinkRenderer;
+        class FaceDrawList;
         class FontManager;
         class ObjectRenderer;
         class RenderBatch;
@@ -72,13 +73,14 @@ namespace TrenchBroom {
         private:
             void commitPendingChanges();
             void setupGL(RenderBatch& renderBatch);
-            void renderDefaultOpaque(RenderContext& renderContext, RenderBatch& renderBatch);
-            void renderDefaultTransparent(RenderContext& renderContext, RenderBatch& renderBatch);
-            void renderSelectionOpaque(RenderContext& renderContext, RenderBatch& renderBatch);
-            void renderSelectionTransparent(RenderContext& renderContext, RenderBatch& renderBatch);
-            void renderLockedOpaque(RenderContext& renderContext, RenderBatch& renderBatch);
-            void renderLockedTransparent(RenderContext& renderContext, RenderBatch& renderBatch);
+            void renderDefaultOpaque(RenderContext& renderContext, RenderBatch& renderBatch, FaceDrawList& faceDrawList);
+            void renderDefaultTransparent(RenderContext& renderContext, FaceDrawList& faceDrawList);
+            void renderSelectionOpaque(RenderContext& renderContext, RenderBatch& renderBatch, FaceDrawList& faceDrawList);
+            void renderSelectionTransparent(RenderContext& renderContext, FaceDrawList& faceDrawList);
+            void renderLockedOpaque(RenderContext& renderContext, RenderBatch& renderBatch, FaceDrawList& faceDrawList);
+            void renderLockedTransparent(RenderContext& renderContext, FaceDrawList& faceDrawList);
             void renderEntityLinks(RenderContext& renderContext, RenderBatch& renderBatch);
+            void renderStatistics(RenderContext& renderContext, RenderBatch& renderBatch);
             
             class MatchTutorialEntities;
             class FilterTutorialEntities;
@@ -103,6 +105,7 @@ namespace TrenchBroom {
             class CollectRenderableNodes;
             
             void updateRenderers(Renderer renderers);
+            void updateRenderers(const Model::NodeSet& nodes);
             void invalidateRenderers(Renderer renderers);
             void invalidateEntityLinkRenderer();
             void reloadEntityModels();
@@ -112,9 +115,12 @@ namespace TrenchBroom {
             
             void documentWasCleared(View::MapDocument* document);
             void documentWasNewedOrLoaded(View::MapDocument* document);
+            void entityModelsWereLoaded();
             
             void nodesWereAdded(const Model::NodeList& nodes);
+            void nodesWillBeRemoved(const Model::NodeList& nodes);
             void nodesWereRemoved(const Model::NodeList& nodes);
+            void nodesWillChange(const Model::NodeList& nodes);
             void nodesDidChange(const Model::NodeList& nodes);
             
             void nodeVisibilityDidChange(const Model::NodeList& nodes);
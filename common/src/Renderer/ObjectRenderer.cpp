@@ -30,6 +30,18 @@ namespace TrenchBroom {
             m_entityRenderer.setEntities(entities);
             m_brushRenderer.setBrushes(brushes);
         }
+        
+        void ObjectRenderer::addObjects(const Model::GroupList& groups, const Model::EntityList& entities, const Model::BrushList& brushes) {
+            m_groupRenderer.addGroups(std::begin(groups), std::end(groups));
+            m_entityRenderer.addEntities(entities);
+            m_brushRenderer.addBrushes(brushes);
+        }
+        
+        void ObjectRenderer::removeObjects(const Model::GroupList& groups, const Model::EntityList& entities, const Model::BrushList& brushes) {
+            m_groupRenderer.removeGroups(std::begin(groups), std::end(groups));
+            m_entityRenderer.removeEntities(entities);
+            m_brushRenderer.removeBrushes(brushes);
+        }
 
         void ObjectRenderer::invalidate() {
             m_groupRenderer.invalidate();
@@ -143,5 +155,15 @@ namespace TrenchBroom {
         void ObjectRenderer::renderTransparent(RenderContext& renderContext, RenderBatch& renderBatch) {
             m_brushRenderer.renderTransparent(renderContext, renderBatch);
         }
+        
+        void ObjectRenderer::renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch, FaceDrawList& faceDrawList) {
+            m_brushRenderer.renderOpaque(renderContext, renderBatch, faceDrawList);
+            m_entityRenderer.render(renderContext, renderBatch);
+            m_groupRenderer.render(renderContext, renderBatch);
+        }
+        
+        void ObjectRenderer::renderTransparent(RenderContext& renderContext, FaceDrawList& faceDrawList) {
+            m_brushRenderer.renderTransparent(renderContext, faceDrawList);
+        }
     }
 }
@@ -32,6 +32,7 @@ namespace TrenchBroom {
     }
     
     namespace Renderer {
+        class FaceDrawList;
         class FontManager;
         class RenderBatch;
         
@@ -48,6 +49,8 @@ namespace TrenchBroom {
             m_brushRenderer(brushFilter) {}
         public: // object management
             void setObjects(const Model::GroupList& groups, const Model::EntityList& entities, const Model::BrushList& brushes);
+            void addObjects(const Model::GroupList& groups, const Model::EntityList& entities, const Model::BrushList& brushes);
+            void removeObjects(const Model::GroupList& groups, const Model::EntityList& entities, const Model::BrushList& brushes);
             void invalidate();
             void clear();
             void reloadModels();
@@ -82,6 +85,8 @@ namespace TrenchBroom {
         public: // rendering
             void renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch);
             void renderTransparent(RenderContext& renderContext, RenderBatch& renderBatch);
+            void renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch, FaceDrawList& faceDrawList);
+            void renderTransparent(RenderContext& renderContext, FaceDrawList& faceDrawList);
         private:
             ObjectRenderer(const ObjectRenderer&);
             ObjectRenderer& operator=(const ObjectRenderer&);
@@ -50,13 +50,46 @@ namespace TrenchBroom {
             }
         };
         
+        class RenderBatch::TransientRenderableWrapper : public Renderable {
+        private:
+            Vbo& m_vertexVbo;
+            Vbo& m_streamVbo;
+            DirectRenderable* m_wrappee;
+        public:
+            TransientRenderableWrapper(Vbo& vertexVbo, Vbo& streamVbo, DirectRenderable* wrappee) :
+            m_vertexVbo(vertexVbo),
+            m_streamVbo(streamVbo),
+            m_wrappee(wrappee) {
+                ensure(m_wrappee != nullptr, "wrappee is null");
+            }
+        private:
+            void doRender(RenderContext& renderContext) override {
+                // both vbos are array buffers, so only one of them can be bound at a time
+                m_vertexVbo.deactivate();
+                {
+                    ActivateVbo activate(m_streamVbo);
+                    m_wrappee->render(renderContext);
+                }
+                m_vertexVbo.activate();
+            }
+        };
+        
         RenderBatch::RenderBatch(Vbo& vertexVbo, Vbo& indexVbo) :
         m_vertexVbo(vertexVbo),
-        m_indexVbo(indexVbo) {}
+        m_indexVbo(indexVbo),
+        m_streamVbo(nullptr) {}
+        
+        RenderBatch::RenderBatch(Vbo& vertexVbo, Vbo& indexVbo, Vbo& streamVbo) :
+        m_vertexVbo(vertexVbo),
+        m_indexVbo(indexVbo),
+        m_streamVbo(&streamVbo) {
+            assert(m_streamVbo->mode() == Vbo::Mode_Stream);
+        }
         
         RenderBatch::~RenderBatch() {
             ListUtils::clearAndDelete(m_oneshots);
             ListUtils::clearAndDelete(m_indexedRenderables);
+            ListUtils::clearAndDelete(m_transientWrappers);
         }
         
         void RenderBatch::add(Renderable* renderable) {
@@ -93,11 +126,27 @@ namespace TrenchBroom {
             m_oneshots.push_back(renderable);
         }
         
+        void RenderBatch::addTransient(DirectRenderable* renderable) {
+            if (m_streamVbo == nullptr) {
+                addOneShot(renderable);
+            } else {
+                TransientRenderableWrapper* wrapper = new TransientRenderableWrapper(m_vertexVbo, *m_streamVbo, renderable);
+                
+                doAdd(wrapper);
+                m_transientRenderables.push_back(renderable);
+                m_transientWrappers.push_back(wrapper);
+                m_oneshots.push_back(renderable);
+            }
+        }
+        
         void RenderBatch::render(RenderContext& renderContext) {
             ActivateVbo activate(m_vertexVbo);
 
             prepareRenderables();
             renderRenderables(renderContext);
+            
+            if (!m_transientRenderables.empty())
+                m_streamVbo->endFrame();
         }
 
         void RenderBatch::doAdd(Renderable* renderable) {
@@ -108,6 +157,7 @@ namespace TrenchBroom {
         void RenderBatch::prepareRenderables() {
             prepareVertices();
             prepareIndices();
+            prepareTransients();
         }
         
         void RenderBatch::prepareVertices() {
@@ -127,6 +177,23 @@ namespace TrenchBroom {
                 renderable->prepareIndices(m_indexVbo);
         }
 
+        void RenderBatch::prepareTransients() {
+            if (m_transientRenderables.empty())
+                return;
+            
+            m_vertexVbo.deactivate();
+            {
+                ActivateVbo activate(*m_streamVbo);
+                m_streamVbo->beginFrame();
+                
+                for (DirectRenderable* renderable : m_transientRenderables)
+                    renderable->prepareVertices(*m_streamVbo);
+                
+                m_streamVbo->flush();
+            }
+            m_vertexVbo.activate();
+        }
+
         void RenderBatch::renderRenderables(RenderContext& renderContext) {
             for (Renderable* renderable : m_batch)
                 renderable->render(renderContext);
@@ -38,8 +38,10 @@ namespace TrenchBroom {
         private:
             Vbo& m_vertexVbo;
             Vbo& m_indexVbo;
+            Vbo* m_streamVbo;
 
             class IndexedRenderableWrapper;
+            class TransientRenderableWrapper;
             
             typedef std::list<Renderable*> RenderableList;
             typedef std::list<DirectRenderable*> DirectRenderableList;
@@ -47,11 +49,14 @@ namespace TrenchBroom {
             
             DirectRenderableList m_directRenderables;
             IndexedRenderableList m_indexedRenderables;
+            DirectRenderableList m_transientRenderables;
+            RenderableList m_transientWrappers;
             
             RenderableList m_batch;
             RenderableList m_oneshots;
         public:
             RenderBatch(Vbo& vertexVbo, Vbo& indexVbo);
+            RenderBatch(Vbo& vertexVbo, Vbo& indexVbo, Vbo& streamVbo);
             ~RenderBatch();
             
             void add(Renderable* renderable);
@@ -62,6 +67,13 @@ namespace TrenchBroom {
             void addOneShot(DirectRenderable* renderable);
             void addOneShot(IndexedRenderable* renderable);
             
+            /**
+             * Adds a one shot renderable whose vertices are created anew for every frame. If this batch has a
+             * stream vbo, the vertices are written to it instead of to the vertex vbo. The renderable must not
+             * keep its vertex arrays beyond the lifetime of this batch.
+             */
+            void addTransient(DirectRenderable* renderable);
+            
             void render(RenderContext& renderContext);
         private:
             void doAdd(Renderable* renderable);
@@ -69,6 +81,7 @@ namespace TrenchBroom {
             void prepareRenderables();
             void prepareVertices();
             void prepareIndices();
+            void prepareTransients();
             
             void renderRenderables(RenderContext& renderContext);
         };
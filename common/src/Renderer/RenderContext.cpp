@@ -29,6 +29,7 @@ namespace TrenchBroom {
         m_transformation(m_camera.projectionMatrix(), m_camera.viewMatrix()),
         m_fontManager(fontManager),
         m_shaderManager(shaderManager),
+        m_faceDrawStats(nullptr),
         m_showTextures(true),
         m_showFaces(true),
         m_showEdges(true),
@@ -68,6 +69,14 @@ namespace TrenchBroom {
             return m_shaderManager;
         }
 
+        FaceDrawList::Stats* RenderContext::faceDrawStats() {
+            return m_faceDrawStats;
+        }
+        
+        void RenderContext::setFaceDrawStats(FaceDrawList::Stats* faceDrawStats) {
+            m_faceDrawStats = faceDrawStats;
+        }
+
         bool RenderContext::showTextures() const {
             return m_showTextures;
         }
@@ -20,6 +20,7 @@
 #ifndef TrenchBroom_RenderContext
 #define TrenchBroom_RenderContext
 
+#include "Renderer/FaceDrawList.h"
 #include "Renderer/Transformation.h"
 #include "Renderer/RenderBatch.h"
 
@@ -54,6 +55,7 @@ namespace TrenchBroom {
             Transformation m_transformation;
             FontManager& m_fontManager;
             ShaderManager& m_shaderManager;
+            FaceDrawList::Stats* m_faceDrawStats;
 
             // settings for any map rendering view
             bool m_showTextures;
@@ -86,6 +88,14 @@ namespace TrenchBroom {
             FontManager& fontManager();
             ShaderManager& shaderManager();
             
+            /**
+             * Returns the statistics which the face draw lists accumulate while this context renders, or null if they
+             * are not collected. The statistics belong to the view which renders, so that several views which share a
+             * map renderer do not count each other's draws.
+             */
+            FaceDrawList::Stats* faceDrawStats();
+            void setFaceDrawStats(FaceDrawList::Stats* faceDrawStats);
+            
             bool showTextures() const;
             void setShowTextures(bool showTextures);
 
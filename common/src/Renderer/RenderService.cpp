@@ -256,9 +256,9 @@ namespace TrenchBroom {
         }
         
         void RenderService::flush() {
-            m_renderBatch.addOneShot(m_primitiveRenderer);
-            m_renderBatch.addOneShot(m_pointHandleRenderer);
-            m_renderBatch.addOneShot(m_textRenderer);
+            m_renderBatch.addTransient(m_primitiveRenderer);
+            m_renderBatch.addTransient(m_pointHandleRenderer);
+            m_renderBatch.addTransient(m_textRenderer);
         }
     }
 }
@@ -83,5 +83,9 @@ namespace TrenchBroom {
         ActiveShader::~ActiveShader() {
             m_program.deactivate();
         }
+        
+        GLint ActiveShader::attributeLocation(const String& name) const {
+            return m_program.attributeLocation(name);
+        }
     }
 }
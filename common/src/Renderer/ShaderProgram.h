@@ -34,11 +34,13 @@ namespace TrenchBroom {
         class ShaderProgram {
         private:
             typedef std::map<String, GLint> UniformVariableCache;
+            typedef std::map<String, GLint> AttributeVariableCache;
             
             String m_name;
             GLuint m_programId;
             bool m_needsLinking;
             mutable UniformVariableCache m_variableCache;
+            mutable AttributeVariableCache m_attributeCache;
         public:
             ShaderProgram(const String& name);
             ~ShaderProgram();
@@ -60,6 +62,8 @@ namespace TrenchBroom {
             void set(const String& name, const Mat2x2f& value);
             void set(const String& name, const Mat3x3f& value);
             void set(const String& name, const Mat4x4f& value);
+
+            GLint attributeLocation(const String& name) const;
         private:
             void link();
             GLint findUniformLocation(const String& name) const;
@@ -30,6 +30,7 @@ namespace TrenchBroom {
             extern const ShaderConfig VaryingPUniformCShader;
             extern const ShaderConfig MiniMapEdgeShader;
             extern const ShaderConfig EntityModelShader;
+            extern const ShaderConfig EntityModelInstancedShader;
             extern const ShaderConfig FaceShader;
             extern const ShaderConfig ColoredTextShader;
             extern const ShaderConfig TextBackgroundShader;
@@ -38,18 +38,17 @@ namespace TrenchBroom {
         const size_t TextRenderer::RectCornerSegments = 3;
         const float TextRenderer::RectCornerRadius = 3.0f;
         
-        TextRenderer::Entry::Entry(Vec2f::List& i_vertices, const Vec2f& i_size, const Vec3f& i_offset, const Color& i_textColor, const Color& i_backgroundColor) :
-        size(i_size),
+        TextRenderer::Entry::Entry(TextureFont::GlyphRun::Ptr i_glyphRun, const Vec3f& i_offset, const Color& i_textColor, const Color& i_backgroundColor) :
+        glyphRun(i_glyphRun),
         offset(i_offset),
         textColor(i_textColor),
-        backgroundColor(i_backgroundColor) {
-            using std::swap;
-            swap(vertices, i_vertices);
-        }
+        backgroundColor(i_backgroundColor) {}
 
         TextRenderer::EntryCollection::EntryCollection() :
         textVertexCount(0),
-        rectVertexCount(0) {}
+        rectVertexCount(0),
+        textIndex(0),
+        rectIndex(0) {}
         
         TextRenderer::TextRenderer(const FontDescriptor& fontDescriptor, const float maxViewDistance, const float minZoomFactor, const Vec2f& inset) :
         m_fontDescriptor(fontDescriptor),
@@ -72,28 +71,27 @@ namespace TrenchBroom {
             if (distance <= 0.0f)
                 return;
             
-            if (!isVisible(renderContext, string, position, distance, onTop))
-                return;
-            
             FontManager& fontManager = renderContext.fontManager();
             TextureFont& font = fontManager.font(m_fontDescriptor);
+            
+            const TextureFont::GlyphRun::Ptr glyphRun = font.glyphRun(string, true);
+            if (!isVisible(renderContext, glyphRun->size.rounded(), position, distance, onTop))
+                return;
 
-            Vec2f::List vertices = font.quads(string, true);
             const float alphaFactor = computeAlphaFactor(renderContext, distance, onTop);
-            const Vec2f size = font.measure(string);
-            const Vec3f offset = position.offset(camera, size);
+            const Vec3f offset = position.offset(camera, glyphRun->size);
             
             if (onTop)
-                addEntry(m_entriesOnTop, Entry(vertices, size, offset,
+                addEntry(m_entriesOnTop, Entry(glyphRun, offset,
                                                Color(textColor, alphaFactor * textColor.a()),
                                                Color(backgroundColor, alphaFactor * backgroundColor.a())));
             else
-                addEntry(m_entries, Entry(vertices, size, offset,
+                addEntry(m_entries, Entry(glyphRun, offset,
                                           Color(textColor, alphaFactor * textColor.a()),
                                           Color(backgroundColor, alphaFactor * backgroundColor.a())));
         }
 
-        bool TextRenderer::isVisible(RenderContext& renderContext, const AttrString& string, const TextAnchor& position, const float distance, const bool onTop) const {
+        bool TextRenderer::isVisible(RenderContext& renderContext, const Vec2f& size, const TextAnchor& position, const float distance, const bool onTop) const {
             if (!onTop) {
                 if (renderContext.render3D() && distance > m_maxViewDistance)
                     return false;
@@ -104,7 +102,6 @@ namespace TrenchBroom {
             const Camera& camera = renderContext.camera();
             const Camera::Viewport& viewport = camera.unzoomedViewport();
             
-            const Vec2f size = stringSize(renderContext, string);
             const Vec2f offset = Vec2f(position.offset(camera, size)) - m_inset;
             const Vec2f actualSize = size + 2.0f * m_inset;
             
@@ -131,41 +128,39 @@ namespace TrenchBroom {
         
         void TextRenderer::addEntry(EntryCollection& collection, const Entry& entry) {
             collection.entries.push_back(entry);
-            collection.textVertexCount += entry.vertices.size();
+            collection.textVertexCount += entry.glyphRun->vertices.size() / 2;
             collection.rectVertexCount += roundedRect2DVertexCount(RectCornerSegments);
         }
-        
-        Vec2f TextRenderer::stringSize(RenderContext& renderContext, const AttrString& string) const {
-            FontManager& fontManager = renderContext.fontManager();
-            TextureFont& font = fontManager.font(m_fontDescriptor);
-            return font.measure(string).rounded();
-        }
 
         void TextRenderer::doPrepareVertices(Vbo& vertexVbo) {
-            prepare(m_entries, false, vertexVbo);
-            prepare(m_entriesOnTop, true, vertexVbo);
-        }
-        
-        void TextRenderer::prepare(EntryCollection& collection, const bool onTop, Vbo& vbo) {
+            // Both collections share one text and one background array so that all labels are uploaded at once.
             TextVertex::List textVertices;
-            textVertices.reserve(collection.textVertexCount);
+            textVertices.reserve(m_entries.textVertexCount + m_entriesOnTop.textVertexCount);
             
             RectVertex::List rectVertices;
-            rectVertices.reserve(collection.rectVertexCount);
+            rectVertices.reserve(m_entries.rectVertexCount + m_entriesOnTop.rectVertexCount);
             
-            for (const Entry& entry : collection.entries)
-                addEntry(entry, onTop, textVertices, rectVertices);
+            prepare(m_entries, false, textVertices, rectVertices);
+            prepare(m_entriesOnTop, true, textVertices, rectVertices);
             
-            collection.textArray = VertexArray::swap(textVertices);
-            collection.rectArray = VertexArray::swap(rectVertices);
+            m_textArray = VertexArray::swap(textVertices);
+            m_rectArray = VertexArray::swap(rectVertices);
+            
+            m_textArray.prepare(vertexVbo);
+            m_rectArray.prepare(vertexVbo);
+        }
+        
+        void TextRenderer::prepare(EntryCollection& collection, const bool onTop, TextVertex::List& textVertices, RectVertex::List& rectVertices) {
+            collection.textIndex = textVertices.size();
+            collection.rectIndex = rectVertices.size();
             
-            collection.textArray.prepare(vbo);
-            collection.rectArray.prepare(vbo);
+            for (const Entry& entry : collection.entries)
+                addEntry(entry, onTop, textVertices, rectVertices);
         }
 
         void TextRenderer::addEntry(const Entry& entry, const bool onTop, TextVertex::List& textVertices, RectVertex::List& rectVertices) {
-            const Vec2f::List& stringVertices = entry.vertices;
-            const Vec2f& stringSize = entry.size;
+            const Vec2f::List& stringVertices = entry.glyphRun->vertices;
+            const Vec2f& stringSize = entry.glyphRun->size;
             
             const Vec3f& offset = entry.offset;
             
@@ -203,20 +198,23 @@ namespace TrenchBroom {
         }
 
         void TextRenderer::render(EntryCollection& collection, RenderContext& renderContext) {
+            if (collection.entries.empty())
+                return;
+            
             FontManager& fontManager = renderContext.fontManager();
             TextureFont& font = fontManager.font(m_fontDescriptor);
             
             glAssert(glDisable(GL_TEXTURE_2D));
             
             ActiveShader backgroundShader(renderContext.shaderManager(), Shaders::TextBackgroundShader);
-            collection.rectArray.render(GL_TRIANGLES);
+            m_rectArray.render(GL_TRIANGLES, static_cast<GLint>(collection.rectIndex), static_cast<GLsizei>(collection.rectVertexCount));
             
             glAssert(glEnable(GL_TEXTURE_2D));
             
             ActiveShader textShader(renderContext.shaderManager(), Shaders::ColoredTextShader);
             textShader.set("Texture", 0);
             font.activate();
-            collection.textArray.render(GL_QUADS);
+            m_textArray.render(GL_QUADS, static_cast<GLint>(collection.textIndex), static_cast<GLsizei>(collection.textVertexCount));
             font.deactivate();
         }
     }
@@ -24,6 +24,7 @@
 #include "Color.h"
 #include "Renderer/FontDescriptor.h"
 #include "Renderer/Renderable.h"
+#include "Renderer/TextureFont.h"
 #include "Renderer/VertexArray.h"
 #include "Renderer/VertexSpec.h"
 
@@ -46,13 +47,12 @@ namespace TrenchBroom {
             static const float RectCornerRadius;
             
             struct Entry {
-                Vec2f::List vertices;
-                Vec2f size;
+                TextureFont::GlyphRun::Ptr glyphRun;
                 Vec3f offset;
                 Color textColor;
                 Color backgroundColor;
 
-                Entry(Vec2f::List& i_vertices, const Vec2f& i_size, const Vec3f& i_offset, const Color& i_textColor, const Color& i_backgroundColor);
+                Entry(TextureFont::GlyphRun::Ptr i_glyphRun, const Vec3f& i_offset, const Color& i_textColor, const Color& i_backgroundColor);
             };
             
             typedef std::vector<Entry> EntryList;
@@ -62,8 +62,9 @@ namespace TrenchBroom {
                 size_t textVertexCount;
                 size_t rectVertexCount;
                 
-                VertexArray textArray;
-                VertexArray rectArray;
+                // the ranges of this collection in the shared vertex arrays
+                size_t textIndex;
+                size_t rectIndex;
 
                 EntryCollection();
             };
@@ -78,6 +79,9 @@ namespace TrenchBroom {
             
             EntryCollection m_entries;
             EntryCollection m_entriesOnTop;
+            
+            VertexArray m_textArray;
+            VertexArray m_rectArray;
         public:
             TextRenderer(const FontDescriptor& fontDescriptor, float maxViewDistance = DefaultMaxViewDistance, float minZoomFactor = DefaultMinZoomFactor, const Vec2f& inset = DefaultInset);
             
@@ -86,14 +90,12 @@ namespace TrenchBroom {
         private:
             void renderString(RenderContext& renderContext, const Color& textColor, const Color& backgroundColor, const AttrString& string, const TextAnchor& position, bool onTop);
             
-            bool isVisible(RenderContext& renderContext, const AttrString& string, const TextAnchor& position, float distance, bool onTop) const;
+            bool isVisible(RenderContext& renderContext, const Vec2f& size, const TextAnchor& position, float distance, bool onTop) const;
             float computeAlphaFactor(const RenderContext& renderContext, float distance, bool onTop) const;
             void addEntry(EntryCollection& collection, const Entry& entry);
-            
-            Vec2f stringSize(RenderContext& renderContext, const AttrString& string) const;
         private:
             void doPrepareVertices(Vbo& vertexVbo) override;
-            void prepare(EntryCollection& collection, bool onTop, Vbo& vbo);
+            void prepare(EntryCollection& collection, bool onTop, TextVertex::List& textVertices, RectVertex::List& rectVertices);
             
             void addEntry(const Entry& entry, bool onTop, TextVertex::List& textVertices, RectVertex::List& rectVertices);
             
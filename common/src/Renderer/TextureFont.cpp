@@ -23,6 +23,8 @@
 
 namespace TrenchBroom {
     namespace Renderer {
+        const size_t TextureFont::MaxCachedGlyphRuns = 4096;
+        
         TextureFont::TextureFont(FontTexture* texture, const FontGlyph::List& glyphs, const size_t lineHeight, const unsigned char firstChar, const unsigned char charCount) :
         m_texture(texture),
         m_glyphs(glyphs),
@@ -165,6 +167,33 @@ namespace TrenchBroom {
             string.lines(measureString);
             return measureString.size();
         }
+        
+        TextureFont::GlyphRun::Ptr TextureFont::glyphRun(const AttrString& string, const bool clockwise) {
+            const GlyphRunKey key(string, clockwise);
+            GlyphRunCache::iterator it = m_glyphRuns.lower_bound(key);
+            if (it != std::end(m_glyphRuns) && !m_glyphRuns.key_comp()(key, it->first)) {
+                m_glyphRunList.splice(std::begin(m_glyphRunList), m_glyphRunList, it->second);
+                return it->second->second;
+            }
+            
+            std::shared_ptr<GlyphRun> run(new GlyphRun());
+            run->vertices = quads(string, clockwise);
+            run->size = measure(string);
+            
+            m_glyphRunList.push_front(std::make_pair(key, run));
+            m_glyphRuns.insert(it, std::make_pair(key, std::begin(m_glyphRunList)));
+            
+            if (m_glyphRunList.size() > MaxCachedGlyphRuns) {
+                m_glyphRuns.erase(m_glyphRunList.back().first);
+                m_glyphRunList.pop_back();
+            }
+            
+            return run;
+        }
+        
+        size_t TextureFont::cachedGlyphRunCount() const {
+            return m_glyphRuns.size();
+        }
 
         Vec2f::List TextureFont::quads(const String& string, const bool clockwise, const Vec2f& offset) {
             Vec2f::List result;
@@ -26,6 +26,9 @@
 #include "Renderer/FontGlyph.h"
 #include "Renderer/FontGlyphBuilder.h"
 
+#include <list>
+#include <map>
+#include <memory>
 #include <vector>
 
 namespace TrenchBroom {
@@ -34,19 +37,48 @@ namespace TrenchBroom {
         
         class TextureFont {
         public:
+            /**
+             * The laid out glyphs of a string at the origin. The vertices alternate between positions and texture
+             * coordinates, as returned by quads().
+             */
+            struct GlyphRun {
+                typedef std::shared_ptr<const GlyphRun> Ptr;
+                
+                Vec2f::List vertices;
+                Vec2f size;
+            };
+            
+            static const size_t MaxCachedGlyphRuns;
         private:
+            typedef std::pair<AttrString, bool> GlyphRunKey;
+            typedef std::pair<GlyphRunKey, GlyphRun::Ptr> GlyphRunEntry;
+            typedef std::list<GlyphRunEntry> GlyphRunList;
+            typedef std::map<GlyphRunKey, GlyphRunList::iterator> GlyphRunCache;
+            
             FontTexture* m_texture;
             FontGlyph::List m_glyphs;
             size_t m_lineHeight;
             
             unsigned char m_firstChar;
             unsigned char m_charCount;
+            
+            // the cached runs, the most recently used run first
+            GlyphRunList m_glyphRunList;
+            GlyphRunCache m_glyphRuns;
         public:
             TextureFont(FontTexture* texture, const FontGlyph::List& glyphs, size_t lineHeight, unsigned char firstChar, unsigned char charCount);
             ~TextureFont();
             
             Vec2f::List quads(const AttrString& string, bool clockwise, const Vec2f& offset = Vec2f::Null);
             Vec2f measure(const AttrString& string);
+            
+            /**
+             * Returns the glyph run for the given string. Since fonts outlive the renderers that use them, the runs are
+             * cached so that labels which are shown in every frame are only laid out once. Once the cache is full, the
+             * least recently used run is evicted.
+             */
+            GlyphRun::Ptr glyphRun(const AttrString& string, bool clockwise);
+            size_t cachedGlyphRunCount() const;
 
             Vec2f::List quads(const String& string, bool clockwise, const Vec2f& offset = Vec2f::Null);
             Vec2f measure(const String& string);
@@ -24,6 +24,7 @@
 #include "Renderer/IndexArrayMap.h"
 
 #include <map>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Assets {
@@ -37,6 +38,7 @@ namespace TrenchBroom {
         class TexturedIndexArrayMap {
         public:
             typedef Assets::Texture Texture;
+            typedef std::vector<const Texture*> TextureList;
         private:
             typedef std::map<const Texture*, IndexArrayMap> TextureToIndexArrayMap;
             typedef std::shared_ptr<TextureToIndexArrayMap> TextureToIndexArrayMapPtr;
@@ -68,8 +70,11 @@ namespace TrenchBroom {
 
             size_t add(const Texture* texture, PrimType primType, size_t count);
 
+            TextureList textures() const;
+
             void render(IndexArray& vertexArray);
             void render(IndexArray& vertexArray, TextureRenderFunc& func);
+            void render(IndexArray& vertexArray, const Texture* texture) const;
         private:
             IndexArrayMap& findCurrent(const Texture* texture);
             bool isCurrent(const Texture* texture);
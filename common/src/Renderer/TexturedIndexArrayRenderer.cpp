@@ -33,6 +33,10 @@ namespace TrenchBroom {
             return m_indexArray.empty();
         }
         
+        TexturedIndexArrayMap::TextureList TexturedIndexArrayRenderer::textures() const {
+            return m_indexRanges.textures();
+        }
+        
         void TexturedIndexArrayRenderer::prepare(Vbo& indexVbo) {
             m_indexArray.prepare(indexVbo);
         }
@@ -44,5 +48,9 @@ namespace TrenchBroom {
         void TexturedIndexArrayRenderer::render(TextureRenderFunc& func) {
             m_indexRanges.render(m_indexArray, func);
         }
+        
+        void TexturedIndexArrayRenderer::render(const Assets::Texture* texture) {
+            m_indexRanges.render(m_indexArray, texture);
+        }
     }
 }
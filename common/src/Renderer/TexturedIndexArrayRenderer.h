@@ -45,10 +45,12 @@ namespace TrenchBroom {
             TexturedIndexArrayRenderer(const IndexArray& indexArray, const TexturedIndexArrayMap& indexArrayMap);
 
             bool empty() const;
+            TexturedIndexArrayMap::TextureList textures() const;
             
             void prepare(Vbo& indexVbo);
             void render();
             void render(TextureRenderFunc& func);
+            void render(const Assets::Texture* texture);
         };
     }
 }
@@ -70,6 +70,7 @@ namespace TrenchBroom {
             
             void render(VertexArray& vertexArray);
             void render(VertexArray& vertexArray, TextureRenderFunc& func);
+            void renderInstanced(VertexArray& vertexArray, size_t instanceCount);
         private:
             IndexRangeMap& findCurrent(const Texture* texture);
             bool isCurrent(const Texture* texture) const;
@@ -52,5 +52,12 @@ namespace TrenchBroom {
                 m_vertexArray.cleanup();
             }
         }
+
+        void TexturedIndexRangeRenderer::renderInstanced(const size_t instanceCount) {
+            if (m_vertexArray.setup()) {
+                m_indexRange.renderInstanced(m_vertexArray, instanceCount);
+                m_vertexArray.cleanup();
+            }
+        }
     }
 }
@@ -46,6 +46,7 @@ namespace TrenchBroom {
             void prepare(Vbo& vbo);
             void render();
             void render(TextureRenderFunc& func);
+            void renderInstanced(size_t instanceCount);
         };
     }
 }
@@ -19,6 +19,7 @@
 
 #include "Vbo.h"
 
+#include "CollectionUtils.h"
 #include "Exceptions.h"
 #include "Renderer/VboBlock.h"
 
@@ -47,7 +48,8 @@ namespace TrenchBroom {
 
         const float Vbo::GrowthFactor = 1.5f;
 
-        Vbo::Vbo(const size_t initialCapacity, const GLenum type, const GLenum usage) :
+        Vbo::Vbo(const size_t initialCapacity, const GLenum type, const GLenum usage, const Mode mode) :
+        m_mode(mode),
         m_totalCapacity(initialCapacity),
         m_freeCapacity(m_totalCapacity),
         m_firstBlock(nullptr),
@@ -55,17 +57,29 @@ namespace TrenchBroom {
         m_state(State_Inactive),
         m_type(type),
         m_usage(usage),
-        m_vboId(0) {
-            m_lastBlock = m_firstBlock = new VboBlock(*this, 0, m_totalCapacity, nullptr, nullptr);
-            m_freeBlocks.push_back(m_firstBlock);
-            assert(checkBlockChain());
+        m_vboId(0),
+        m_persistent(false),
+        m_persistentBuffer(nullptr),
+        m_segment(0),
+        m_frameSize(0) {
+            for (size_t i = 0; i < StreamSegmentCount; ++i)
+                m_fences[i] = nullptr;
+            
+            if (m_mode == Mode_Block) {
+                m_lastBlock = m_firstBlock = new VboBlock(*this, 0, m_totalCapacity, nullptr, nullptr);
+                m_freeBlocks.push_back(m_firstBlock);
+                assert(checkBlockChain());
+            }
         }
         
         Vbo::~Vbo() {
             if (active())
                 deactivate();
+            deleteFences();
             free();
             
+            VectorUtils::clearAndDelete(m_frameBlocks);
+            
             auto* block = m_firstBlock;
             while (block != nullptr) {
                 auto* next = block->next();
@@ -76,14 +90,21 @@ namespace TrenchBroom {
             m_lastBlock = m_firstBlock = nullptr;
         }
         
-        VboBlock* Vbo::allocateBlock(const size_t capacity) {
-            assert(checkBlockChain());
+        Vbo::Mode Vbo::mode() const {
+            return m_mode;
+        }
 
+        VboBlock* Vbo::allocateBlock(const size_t capacity) {
             if (!active()) {
                 VboException e;
                 e << "Vbo is inactive";
                 throw e;
             }
+            
+            if (m_mode == Mode_Stream)
+                return allocateStreamBlock(capacity);
+
+            assert(checkBlockChain());
 
             auto it = findFreeBlock(capacity);
             if (it == std::end(m_freeBlocks)) {
@@ -117,7 +138,10 @@ namespace TrenchBroom {
             if (m_vboId == 0) {
                 glAssert(glGenBuffers(1, &m_vboId));
                 glAssert(glBindBuffer(m_type, m_vboId));
-                glAssert(glBufferData(m_type, static_cast<GLsizeiptr>(m_totalCapacity), nullptr, m_usage));
+                if (m_mode == Mode_Stream)
+                    createStreamStorage();
+                else
+                    glAssert(glBufferData(m_type, static_cast<GLsizeiptr>(m_totalCapacity), nullptr, m_usage));
             } else {
                 glAssert(glBindBuffer(m_type, m_vboId));
             }
@@ -132,19 +156,67 @@ namespace TrenchBroom {
             m_state = State_Inactive;
         }
         
+        void Vbo::beginFrame() {
+            assert(m_mode == Mode_Stream);
+            
+            if (m_persistent) {
+                m_segment = (m_segment + 1) % StreamSegmentCount;
+                
+                GLsync& fence = m_fences[m_segment];
+                if (fence != nullptr) {
+                    static const GLuint64 Timeout = 1000000; // one millisecond
+                    GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, Timeout);
+                    while (result == GL_TIMEOUT_EXPIRED)
+                        result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, Timeout);
+                    
+                    // if the wait failed, the GPU may still be reading the segment, so wait for all commands instead
+                    if (result == GL_WAIT_FAILED)
+                        glAssert(glFinish());
+                    glAssert(glDeleteSync(fence));
+                    fence = nullptr;
+                }
+            }
+            m_frameSize = 0;
+        }
+        
+        void Vbo::flush() {
+            assert(m_mode == Mode_Stream);
+            assert(active());
+            
+            // re-specifying the buffer's data orphans its previous contents, which may still be in use by the GPU
+            if (!m_persistent && m_frameSize > 0)
+                glAssert(glBufferData(m_type, static_cast<GLsizeiptr>(m_frameSize), &m_clientBuffer[0], m_usage));
+        }
+        
+        void Vbo::endFrame() {
+            assert(m_mode == Mode_Stream);
+            
+            if (m_persistent) {
+                assert(m_fences[m_segment] == nullptr);
+                m_fences[m_segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            }
+        }
+
         GLenum Vbo::type() const {
             return m_type;
         }
 
         void Vbo::free() {
             if (m_vboId > 0) {
+                // deleting a buffer also unmaps it
                 glAssert(glDeleteBuffers(1, &m_vboId));
                 m_vboId = 0;
+                m_persistentBuffer = nullptr;
             }
         }
 
         void Vbo::freeBlock(VboBlock* block) {
             ensure(block != nullptr, "block is null");
+            if (m_mode == Mode_Stream) {
+                freeStreamBlock(block);
+                return;
+            }
+            
             assert(!block->isFree());
             assert(checkBlockChain());
             
@@ -182,6 +254,93 @@ namespace TrenchBroom {
             assert(checkBlockChain());
         }
 
+        VboBlock* Vbo::allocateStreamBlock(const size_t capacity) {
+            const size_t offset = m_frameSize;
+            const size_t alignedCapacity = (capacity + StreamAlignment - 1) / StreamAlignment * StreamAlignment;
+            if (offset + alignedCapacity > m_totalCapacity)
+                increaseStreamCapacity(offset + alignedCapacity);
+            m_frameSize = offset + alignedCapacity;
+            
+            const size_t segmentOffset = m_persistent ? m_segment * m_totalCapacity : 0;
+            auto* block = new VboBlock(*this, segmentOffset + offset, capacity, nullptr, nullptr);
+            block->setFree(false);
+            m_frameBlocks.push_back(block);
+            return block;
+        }
+        
+        void Vbo::freeStreamBlock(VboBlock* block) {
+            auto it = std::find(std::begin(m_frameBlocks), std::end(m_frameBlocks), block);
+            ensure(it != std::end(m_frameBlocks), "block was not allocated by this vbo");
+            
+            std::swap(*it, m_frameBlocks.back());
+            m_frameBlocks.pop_back();
+            delete block;
+        }
+        
+        void Vbo::createStreamStorage() {
+            // glBufferStorage is only bound if GL_ARB_buffer_storage is available
+            m_persistent = glBufferStorage.bound() && glewIsSupported("GL_ARB_sync") == GL_TRUE;
+            if (m_persistent) {
+                // the read bit allows us to copy the current frame's contents when the buffer grows
+                const GLbitfield flags = GL_MAP_READ_BIT | GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+                const GLsizeiptr size = static_cast<GLsizeiptr>(StreamSegmentCount * m_totalCapacity);
+                
+                glAssert(glBufferStorage(m_type, size, nullptr, flags));
+                m_persistentBuffer = reinterpret_cast<unsigned char*>(glMapBufferRange(m_type, 0, size, flags));
+                ensure(m_persistentBuffer != nullptr, "buffer is null");
+            } else {
+                glAssert(glBufferData(m_type, static_cast<GLsizeiptr>(m_totalCapacity), nullptr, m_usage));
+                m_clientBuffer.resize(m_totalCapacity);
+            }
+        }
+        
+        void Vbo::increaseStreamCapacity(const size_t minCapacity) {
+            assert(active());
+            assert(!partiallyMapped());
+            
+            auto newCapacity = m_totalCapacity;
+            while (newCapacity < minCapacity)
+                newCapacity = static_cast<size_t>(static_cast<float>(newCapacity) * GrowthFactor);
+            
+            if (!m_persistent) {
+                m_totalCapacity = newCapacity;
+                m_clientBuffer.resize(m_totalCapacity);
+                return;
+            }
+            
+            // buffer storage is immutable, so we must create a new buffer and move the current frame to its first segment
+            const size_t segmentOffset = m_segment * m_totalCapacity;
+            const std::vector<unsigned char> frame(m_persistentBuffer + segmentOffset, m_persistentBuffer + segmentOffset + m_frameSize);
+            
+            deleteFences();
+            deactivate();
+            free();
+            
+            m_totalCapacity = newCapacity;
+            m_segment = 0;
+            activate();
+            
+            if (!frame.empty())
+                std::memcpy(m_persistentBuffer, &frame[0], frame.size());
+            for (VboBlock* block : m_frameBlocks)
+                block->m_offset -= std::min(block->m_offset, segmentOffset);
+        }
+        
+        unsigned char* Vbo::streamBuffer() {
+            if (m_mode != Mode_Stream)
+                return nullptr;
+            return m_persistent ? m_persistentBuffer : &m_clientBuffer[0];
+        }
+        
+        void Vbo::deleteFences() {
+            for (size_t i = 0; i < StreamSegmentCount; ++i) {
+                if (m_fences[i] != nullptr) {
+                    glAssert(glDeleteSync(m_fences[i]));
+                    m_fences[i] = nullptr;
+                }
+            }
+        }
+
         void Vbo::increaseCapacityToAccomodate(const size_t capacity) {
             auto newMinCapacity = m_totalCapacity + capacity;
             if (m_lastBlock->isFree())
@@ -46,9 +46,28 @@ namespace TrenchBroom {
             ~ActivateVbo();
         };
         
+        /**
+         * A vertex buffer object that hands out blocks of its memory.
+         *
+         * In block mode, blocks are allocated and freed individually and stay valid until they are freed. The buffer
+         * is searched for a free block of sufficient size and grows if no such block exists.
+         *
+         * In stream mode, the buffer is meant for geometry that is only rendered once. Blocks are allocated
+         * sequentially and are only valid until the frame ends, see beginFrame, flush and endFrame. If the
+         * GL_ARB_buffer_storage and GL_ARB_sync extensions are available, the buffer is split into a ring of
+         * segments which are persistently mapped, and the blocks are written directly into mapped memory. A fence
+         * guards each segment against being overwritten while the GPU still reads it. Otherwise, the blocks are
+         * written into client memory and uploaded in one call when the frame is flushed, orphaning the previous
+         * contents of the buffer.
+         */
         class Vbo {
         public:
             typedef std::shared_ptr<Vbo> Ptr;
+            
+            typedef enum {
+                Mode_Block,
+                Mode_Stream
+            } Mode;
         private:
             typedef enum {
                 State_Inactive = 0,
@@ -59,7 +78,10 @@ namespace TrenchBroom {
         private:
             typedef std::vector<VboBlock*> VboBlockList;
             static const float GrowthFactor;
+            static const size_t StreamSegmentCount = 3;
+            static const size_t StreamAlignment = 16;
             
+            Mode m_mode;
             size_t m_totalCapacity;
             size_t m_freeCapacity;
             VboBlockList m_freeBlocks;
@@ -70,15 +92,44 @@ namespace TrenchBroom {
             GLenum m_type;
             GLenum m_usage;
             GLuint m_vboId;
+            
+            // stream mode, the capacity of each segment is m_totalCapacity
+            bool m_persistent;
+            unsigned char* m_persistentBuffer;
+            std::vector<unsigned char> m_clientBuffer;
+            GLsync m_fences[StreamSegmentCount];
+            size_t m_segment;
+            size_t m_frameSize;
+            VboBlockList m_frameBlocks;
         public:
-            Vbo(size_t initialCapacity, GLenum type = GL_ARRAY_BUFFER, GLenum usage = GL_DYNAMIC_DRAW);
+            Vbo(size_t initialCapacity, GLenum type = GL_ARRAY_BUFFER, GLenum usage = GL_DYNAMIC_DRAW, Mode mode = Mode_Block);
             ~Vbo();
             
+            Mode mode() const;
+            
             VboBlock* allocateBlock(size_t capacity);
 
             bool active() const;
             void activate();
             void deactivate();
+            
+            /**
+             * Begins a new frame in stream mode. All blocks allocated in the previous frame become invalid. Waits
+             * until the GPU has finished reading the segment that will be reused if necessary.
+             */
+            void beginFrame();
+            
+            /**
+             * Makes the blocks allocated in the current frame available to the GPU. Must be called after the blocks
+             * have been written and before they are rendered.
+             */
+            void flush();
+            
+            /**
+             * Ends the current frame in stream mode. Must be called after all blocks of the current frame have been
+             * rendered.
+             */
+            void endFrame();
         private:
             friend class ActivateVbo;
             friend class VboBlock;
@@ -87,6 +138,13 @@ namespace TrenchBroom {
             
             void free();
             void freeBlock(VboBlock* block);
+            
+            VboBlock* allocateStreamBlock(size_t capacity);
+            void freeStreamBlock(VboBlock* block);
+            void createStreamStorage();
+            void increaseStreamCapacity(size_t minCapacity);
+            unsigned char* streamBuffer();
+            void deleteFences();
 
             void increaseCapacityToAccomodate(size_t capacity);
             void increaseCapacity(size_t delta);
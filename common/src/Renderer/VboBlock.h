@@ -72,9 +72,16 @@ namespace TrenchBroom {
                 assert(address + size <= m_capacity);
                 
                 const GLvoid* ptr = static_cast<const GLvoid*>(&(buffer[0]));
-                const GLintptr offset = static_cast<GLintptr>(m_offset + address);
-                const GLsizeiptr sizei = static_cast<GLsizeiptr>(size);
-                glAssert(glBufferSubData(m_vbo.type(), offset, sizei, ptr));
+                
+                // in stream mode, the vbo's memory is directly accessible
+                unsigned char* streamBuffer = m_vbo.streamBuffer();
+                if (streamBuffer != nullptr) {
+                    std::memcpy(streamBuffer + m_offset + address, ptr, size);
+                } else {
+                    const GLintptr offset = static_cast<GLintptr>(m_offset + address);
+                    const GLsizeiptr sizei = static_cast<GLsizeiptr>(size);
+                    glAssert(glBufferSubData(m_vbo.type(), offset, sizei, ptr));
+                }
                 
                 return size;
             }
@@ -135,6 +135,21 @@ namespace TrenchBroom {
             }
         }
 
+        void VertexArray::renderInstanced(const PrimType primType, const GLIndices& indices, const GLCounts& counts, const GLint primCount, const GLsizei instanceCount) {
+            assert(prepared());
+            
+            // there is no instanced variant of glMultiDrawArrays, so every range gets its own instanced draw call
+            const bool wasSetup = m_setup;
+            if (wasSetup || setup()) {
+                for (GLint i = 0; i < primCount; ++i) {
+                    const size_t j = static_cast<size_t>(i);
+                    glAssert(glDrawArraysInstanced(primType, indices[j], counts[j], instanceCount));
+                }
+                if (!wasSetup)
+                    cleanup();
+            }
+        }
+
         VertexArray::VertexArray(BaseHolder::Ptr holder) :
         m_holder(holder),
         m_prepared(false),
@@ -267,6 +267,7 @@ namespace TrenchBroom {
             void render(PrimType primType, GLint index, GLsizei count);
             void render(PrimType primType, const GLIndices& indices, const GLCounts& counts, GLint primCount);
             void render(PrimType primType, const GLIndices& indices, GLsizei count);
+            void renderInstanced(PrimType primType, const GLIndices& indices, const GLCounts& counts, GLint primCount, GLsizei instanceCount);
             void cleanup();
         private:
             VertexArray(BaseHolder::Ptr holder);
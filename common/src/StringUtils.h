@@ -95,6 +95,10 @@ namespace StringUtils {
         bool operator()(const String& lhs, const String& rhs) const {
             return std::lexicographical_compare(std::begin(lhs), std::end(lhs), std::begin(rhs), std::end(rhs), CharLess<Cmp>());
         }
+
+        bool operator()(const char* lhsBegin, const char* lhsEnd, const char* rhsBegin, const char* rhsEnd) const {
+            return std::lexicographical_compare(lhsBegin, lhsEnd, rhsBegin, rhsEnd, CharLess<Cmp>());
+        }
     };
     
     typedef StringLess<CaseSensitiveCharCompare> CaseSensitiveStringLess;
@@ -0,0 +1,80 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+namespace TrenchBroom {
+    ThreadPool::ThreadPool(const size_t workerCount) :
+    m_stopped(false) {
+        const size_t count = workerCount > 0 ? workerCount : defaultWorkerCount();
+        m_workers.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+            m_workers.push_back(std::thread(&ThreadPool::run, this));
+    }
+    
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopped = true;
+        }
+        m_condition.notify_all();
+        
+        for (std::thread& worker : m_workers)
+            worker.join();
+    }
+
+    size_t ThreadPool::workerCount() const {
+        return m_workers.size();
+    }
+
+    void ThreadPool::enqueue(Task task) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ensure(!m_stopped, "thread pool is stopped");
+            m_tasks.push(std::move(task));
+        }
+        m_condition.notify_one();
+    }
+    
+    void ThreadPool::run() {
+        while (true) {
+            Task task;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_condition.wait(lock, [this]() { return m_stopped || !m_tasks.empty(); });
+                
+                // Drain the queue before stopping so that no future is left without a result.
+                if (m_tasks.empty())
+                    return;
+                
+                task = std::move(m_tasks.front());
+                m_tasks.pop();
+            }
+            task();
+        }
+    }
+
+    size_t ThreadPool::defaultWorkerCount() {
+        // Leave one hardware thread for the UI.
+        const size_t hardwareThreads = static_cast<size_t>(std::thread::hardware_concurrency());
+        return std::max(static_cast<size_t>(1), hardwareThreads > 1 ? hardwareThreads - 1 : 1);
+    }
+}
@@ -0,0 +1,81 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_ThreadPool
+#define TrenchBroom_ThreadPool
+
+#include "Macros.h"
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace TrenchBroom {
+    /**
+     * A fixed size pool of worker threads that execute submitted tasks in FIFO order.
+     *
+     * Tasks are submitted as callables and the caller receives a future for the result. Exceptions thrown by a task
+     * are stored in the future and rethrown when the future is read.
+     *
+     * Destroying the pool waits until all tasks that were already submitted have finished.
+     */
+    class ThreadPool {
+    private:
+        typedef std::function<void()> Task;
+        typedef std::vector<std::thread> WorkerList;
+        
+        WorkerList m_workers;
+        std::queue<Task> m_tasks;
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        bool m_stopped;
+    public:
+        /**
+         * Creates a pool with the given number of worker threads. If the given number is 0, the number of workers is
+         * derived from the number of available hardware threads.
+         */
+        explicit ThreadPool(size_t workerCount = 0);
+        ~ThreadPool();
+        
+        size_t workerCount() const;
+        
+        template <typename F>
+        auto submit(F&& f) -> std::future<decltype(f())> {
+            typedef decltype(f()) R;
+            auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(f));
+            std::future<R> result = task->get_future();
+            enqueue([task]() { (*task)(); });
+            return result;
+        }
+    private:
+        void enqueue(Task task);
+        void run();
+        
+        static size_t defaultWorkerCount();
+        
+        deleteCopyAndAssignment(ThreadPool)
+    };
+}
+
+#endif /* defined(TrenchBroom_ThreadPool) */
@@ -238,8 +238,11 @@ namespace TrenchBroom {
             Polyhedron3 polyhedron = m_tool->polyhedron();
             const Model::BrushFace* face = Model::hitToFace(hit);
             
+            Vec3::List points;
             for (const Model::BrushVertex* vertex : face->vertices())
-                polyhedron.addPoint(vertex->position());
+                points.push_back(vertex->position());
+            
+            polyhedron.addPoints(points);
             m_tool->update(polyhedron);
             
             return true;
@@ -39,6 +39,7 @@ namespace TrenchBroom {
             
             Renderer::Vbo* m_vertexVbo;
             Renderer::Vbo* m_indexVbo;
+            Renderer::Vbo* m_streamVbo;
             Renderer::FontManager* m_fontManager;
             Renderer::ShaderManager* m_shaderManager;
         public:
@@ -53,6 +54,7 @@ namespace TrenchBroom {
             
             Renderer::Vbo& vertexVbo();
             Renderer::Vbo& indexVbo();
+            Renderer::Vbo& streamVbo();
             Renderer::FontManager& fontManager();
             Renderer::ShaderManager& shaderManager();
         private:
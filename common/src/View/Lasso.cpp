@@ -30,10 +30,36 @@ namespace TrenchBroom {
         m_transform(coordinateSystemMatrix(m_camera.right(), m_camera.up(), -m_camera.direction(),
                                            m_camera.defaultPoint(static_cast<float>(m_distance)))),
         m_start(point),
-        m_cur(m_start) {}
+        m_cur(m_start),
+        m_box(computeBox()) {}
         
         void Lasso::update(const Vec3& point) {
             m_cur = point;
+            m_box = computeBox();
+        }
+        
+        bool Lasso::mayContain(const BBox3& bounds) const {
+            // Since the projection onto the lasso plane maps the box to the convex hull of its projected corners,
+            // it suffices to test the bounds of the projected corners against the lasso box.
+            const Plane3 plane = this->plane();
+            BBox2 projectedBounds;
+            for (size_t i = 0; i < 8; ++i) {
+                const BBox3::Corner x = (i & 1) ? BBox3::Corner_Max : BBox3::Corner_Min;
+                const BBox3::Corner y = (i & 2) ? BBox3::Corner_Max : BBox3::Corner_Min;
+                const BBox3::Corner z = (i & 4) ? BBox3::Corner_Max : BBox3::Corner_Min;
+                const Vec3 projected = project(bounds.vertex(x, y, z), plane);
+                
+                // the corner could not be projected, so we cannot rule out that the bounds contain selected points
+                if (projected.nan())
+                    return true;
+                
+                const Vec2 projected2(projected);
+                if (i == 0)
+                    projectedBounds = BBox2(projected2, projected2);
+                else
+                    projectedBounds.mergeWith(projected2);
+            }
+            return m_box.intersects(projectedBounds);
         }
 
         bool Lasso::selects(const Vec3& point, const Plane3& plane, const BBox2& box) const {
@@ -66,7 +92,7 @@ namespace TrenchBroom {
         }
 
         void Lasso::render(Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch) const {
-            const BBox2 box = this->box();
+            const BBox2& box = m_box;
             const Mat4x4 inverted = invertedMatrix(m_transform);
             
             Vec3f::List polygon(4);
@@ -88,7 +114,7 @@ namespace TrenchBroom {
             return Plane3(m_camera.defaultPoint(static_cast<float>(m_distance)), m_camera.direction());
         }
         
-        BBox2 Lasso::box() const {
+        BBox2 Lasso::computeBox() const {
             const Vec3 start = m_transform * m_start;
             const Vec3 cur   = m_transform * m_cur;
             
@@ -38,6 +38,7 @@ namespace TrenchBroom {
             const Mat4x4 m_transform;
             const Vec3 m_start;
             Vec3 m_cur;
+            BBox2 m_box;
         public:
             Lasso(const Renderer::Camera& camera, FloatType distance, const Vec3& point);
             
@@ -46,9 +47,8 @@ namespace TrenchBroom {
             template <typename I, typename O>
             void selected(I cur, I end, O out) const {
                 const Plane3 plane = this->plane();
-                const BBox2 box = this->box();
                 while (cur != end) {
-                    if (selects(*cur, plane, box))
+                    if (selects(*cur, plane, m_box))
                         out = *cur;
                     ++cur;
                 }
@@ -56,8 +56,14 @@ namespace TrenchBroom {
             
             template <typename H>
             bool selects(const H& h) const {
-                return selects(h, plane(), box());
+                return selects(h, plane(), m_box);
             }
+            
+            /**
+             * Checks whether this lasso may select any point within the given bounds. If this returns false, then no
+             * handle within the given bounds can be selected by this lasso.
+             */
+            bool mayContain(const BBox3& bounds) const;
         private:
             bool selects(const Vec3& point, const Plane3& plane, const BBox2& box) const;
             bool selects(const Edge3& edge, const Plane3& plane, const BBox2& box) const;
@@ -67,7 +73,7 @@ namespace TrenchBroom {
             void render(Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch) const;
         private:
             Plane3 plane() const;
-            BBox2 box() const;
+            BBox2 computeBox() const;
         };
     }
 }
@@ -22,6 +22,7 @@
 #include "PreferenceManager.h"
 #include "Preferences.h"
 #include "Polyhedron.h"
+#include "ThreadPool.h"
 #include "Assets/EntityDefinitionManager.h"
 #include "Assets/EntityModelManager.h"
 #include "Assets/Texture.h"
@@ -100,6 +101,7 @@
 #include "View/ResizeBrushesCommand.h"
 #include "View/CopyTexCoordSystemFromFaceCommand.h"
 #include "View/RotateTexturesCommand.h"
+#include "View/Selection.h"
 #include "View/SelectionCommand.h"
 #include "View/SetLockStateCommand.h"
 #include "View/SetModsCommand.h"
@@ -110,7 +112,10 @@
 #include "View/TransformObjectsCommand.h"
 #include "View/ViewEffectsService.h"
 
+#include <wx/app.h>
+
 #include <cassert>
+#include <future>
 
 namespace TrenchBroom {
     namespace View {
@@ -135,7 +140,10 @@ namespace TrenchBroom {
         m_currentTextureName(Model::BrushFace::NoTextureName),
         m_lastSelectionBounds(0.0, 32.0),
         m_selectionBoundsValid(true),
-        m_viewEffectsService(nullptr) {
+        m_viewEffectsService(nullptr),
+        m_csgPool(nullptr) {
+            // Models are loaded in the background; wake the UI thread so that the views can commit them.
+            m_entityModelManager->setLoadCallback([]() { wxWakeUpIdle(); });
             bindObservers();
         }
         
@@ -947,20 +955,22 @@ namespace TrenchBroom {
             if (!hasSelectedBrushFaces() && !selectedNodes().hasOnlyBrushes())
                 return false;
             
-            Polyhedron3 polyhedron;
+            Vec3::List points;
             
             if (hasSelectedBrushFaces()) {
                 for (const Model::BrushFace* face : selectedBrushFaces()) {
                     for (const Model::BrushVertex* vertex : face->vertices())
-                        polyhedron.addPoint(vertex->position());
+                        points.push_back(vertex->position());
                 }
             } else if (selectedNodes().hasOnlyBrushes()) {
                 for (const Model::Brush* brush : selectedNodes().brushes()) {
                     for (const Model::BrushVertex* vertex : brush->vertices())
-                        polyhedron.addPoint(vertex->position());
+                        points.push_back(vertex->position());
                 }
             }
             
+            const Polyhedron3 polyhedron(points);
+            
             if (!polyhedron.polyhedron() || !polyhedron.closed())
                 return false;
             
@@ -987,6 +997,20 @@ namespace TrenchBroom {
             return true;
         }
         
+        template <typename T>
+        static void waitForAll(const std::vector<std::future<T>>& futures) {
+            for (const std::future<T>& future : futures) {
+                if (future.valid())
+                    future.wait();
+            }
+        }
+        
+        static void deleteChildren(Model::ParentChildrenMap& nodes) {
+            for (auto& entry : nodes)
+                VectorUtils::clearAndDelete(entry.second);
+            nodes.clear();
+        }
+        
         bool MapDocument::csgSubtract() {
             const Model::BrushList brushes = selectedNodes().brushes();
             if (brushes.size() < 2)
@@ -999,12 +1023,28 @@ namespace TrenchBroom {
             Model::NodeList toRemove;
             toRemove.push_back(subtrahend);
             
-            for (Model::Brush* minuend : minuends) {
-                const Model::BrushList result = minuend->subtract(*m_world, m_worldBounds, currentTextureName(), subtrahend);
-                if (!result.empty()) {
-                    VectorUtils::append(toAdd[minuend->parent()], result);
-                    toRemove.push_back(minuend);
+            // The fragments of each minuend are computed concurrently, but the brushes are created in selection order.
+            std::vector<std::future<Model::BrushGeometry::SubtractResult>> fragments;
+            fragments.reserve(minuends.size());
+            
+            try {
+                ThreadPool& pool = csgPool();
+                for (const Model::Brush* minuend : minuends)
+                    fragments.push_back(pool.submit([minuend, subtrahend]() { return minuend->subtractGeometry(subtrahend); }));
+                
+                for (size_t i = 0; i < minuends.size(); ++i) {
+                    Model::Brush* minuend = minuends[i];
+                    const Model::BrushList result = minuend->createBrushes(*m_world, m_worldBounds, currentTextureName(), fragments[i].get(), subtrahend);
+                    if (!result.empty()) {
+                        VectorUtils::append(toAdd[minuend->parent()], result);
+                        toRemove.push_back(minuend);
+                    }
                 }
+            } catch (...) {
+                // the pending tasks still refer to the brushes
+                waitForAll(fragments);
+                deleteChildren(toAdd);
+                throw;
             }
             
             Transaction transaction(this, "CSG Subtract");
@@ -1060,18 +1100,48 @@ namespace TrenchBroom {
             Model::ParentChildrenMap toAdd;
             Model::NodeList toRemove;
             
-            for (Model::Brush* brush : brushes) {
-                // make an shrunken copy of brush
-                Model::Brush* shrunken = brush->clone(m_worldBounds);
-                if (shrunken->expand(m_worldBounds, -1.0 * static_cast<FloatType>(m_grid->actualSize()), true)) {
-                    // shrinking gave us a valid brush, so subtract it from `brush`
-                    const Model::BrushList fragments = brush->subtract(*m_world, m_worldBounds, currentTextureName(), shrunken);
-                    
-                    VectorUtils::append(toAdd[brush->parent()], fragments);
-                    toRemove.push_back(brush);
+            // make shrunken copies of the brushes
+            std::vector<std::unique_ptr<Model::Brush>> shrunkenBrushes;
+            shrunkenBrushes.reserve(brushes.size());
+            for (const Model::Brush* brush : brushes)
+                shrunkenBrushes.push_back(std::unique_ptr<Model::Brush>(brush->clone(m_worldBounds)));
+            
+            // Shrinking and subtracting only modify the copies, so the fragments of each brush are computed
+            // concurrently, but the brushes are created in selection order.
+            const BBox3& worldBounds = m_worldBounds;
+            const FloatType delta = -1.0 * static_cast<FloatType>(m_grid->actualSize());
+            
+            std::vector<Model::BrushGeometry::SubtractResult> fragments(brushes.size());
+            std::vector<std::future<bool>> shrunk;
+            shrunk.reserve(brushes.size());
+            
+            try {
+                ThreadPool& pool = csgPool();
+                for (size_t i = 0; i < brushes.size(); ++i) {
+                    const Model::Brush* brush = brushes[i];
+                    Model::Brush* shrunken = shrunkenBrushes[i].get();
+                    Model::BrushGeometry::SubtractResult& result = fragments[i];
+                    shrunk.push_back(pool.submit([&worldBounds, delta, brush, shrunken, &result]() {
+                        if (!shrunken->expand(worldBounds, delta, true))
+                            return false;
+                        result = brush->subtractGeometry(shrunken);
+                        return true;
+                    }));
                 }
                 
-                delete shrunken;
+                for (size_t i = 0; i < brushes.size(); ++i) {
+                    Model::Brush* brush = brushes[i];
+                    if (shrunk[i].get()) {
+                        // shrinking gave us a valid brush, so the fragments are what remains of `brush`
+                        VectorUtils::append(toAdd[brush->parent()], brush->createBrushes(*m_world, m_worldBounds, currentTextureName(), fragments[i], shrunkenBrushes[i].get()));
+                        toRemove.push_back(brush);
+                    }
+                }
+            } catch (...) {
+                // the pending tasks still refer to the shrunken brushes and the fragments
+                waitForAll(shrunk);
+                deleteChildren(toAdd);
+                throw;
             }
 
             Transaction transaction(this, "CSG Hollow");
@@ -1083,6 +1153,12 @@ namespace TrenchBroom {
             return true;
         }
 
+        ThreadPool& MapDocument::csgPool() {
+            if (m_csgPool == nullptr)
+                m_csgPool = std::make_unique<ThreadPool>();
+            return *m_csgPool;
+        }
+
         bool MapDocument::clipBrushes(const Vec3& p1, const Vec3& p2, const Vec3& p3) {
             const Model::BrushList& brushes = m_selectedNodes.brushes();
             Model::ParentChildrenMap clippedBrushes;
@@ -1321,6 +1397,11 @@ namespace TrenchBroom {
         
         void MapDocument::commitPendingAssets() {
             m_textureManager->commitChanges();
+            
+            const bool modelsWereLoaded = m_entityModelManager->hasLoadedModels();
+            m_entityModelManager->commitLoadedModels();
+            if (modelsWereLoaded && m_world != nullptr)
+                setEntityModels();
         }
         
         void MapDocument::pick(const Ray3& pickRay, Model::PickResult& pickResult) const {
@@ -1402,12 +1483,67 @@ namespace TrenchBroom {
             setTextures();
         }
 
+        /**
+         * Finds and parses the entity definition file of a document in the background. The messages which are logged
+         * while parsing are kept until the definitions are retrieved.
+         */
+        class EntityDefinitionLoad {
+        private:
+            Model::GameSPtr m_game;
+            Assets::EntityDefinitionFileSpec m_spec;
+            IO::Path::List m_searchPaths;
+            IO::Path m_path;
+            CachingLogger m_logger;
+            std::future<Assets::EntityDefinitionList> m_definitions;
+            ThreadPool m_pool;
+        public:
+            EntityDefinitionLoad(Model::GameSPtr game, const Assets::EntityDefinitionFileSpec& spec, const IO::Path::List& searchPaths) :
+            m_game(game),
+            m_spec(spec),
+            m_searchPaths(searchPaths),
+            m_pool(1) {
+                m_definitions = m_pool.submit([this]() {
+                    m_path = m_game->findEntityDefinitionFile(m_spec, m_searchPaths);
+                    IO::SimpleParserStatus status(&m_logger);
+                    return m_game->loadEntityDefinitions(status, m_path);
+                });
+            }
+            
+            ~EntityDefinitionLoad() {
+                // discard the definitions if they were never retrieved
+                if (m_definitions.valid()) {
+                    try {
+                        Assets::EntityDefinitionList definitions = m_definitions.get();
+                        VectorUtils::clearAndDelete(definitions);
+                    } catch (...) {}
+                }
+            }
+            
+            const Assets::EntityDefinitionFileSpec& spec() const {
+                return m_spec;
+            }
+            
+            const IO::Path& path() const {
+                return m_path;
+            }
+            
+            Assets::EntityDefinitionList definitions(Logger* logger) {
+                m_definitions.wait();
+                m_logger.setParentLogger(logger);
+                return m_definitions.get();
+            }
+            
+            deleteCopyAndAssignment(EntityDefinitionLoad)
+        };
+        
         void MapDocument::loadAssets() {
-            loadEntityDefinitions();
-            setEntityDefinitions();
+            // the entity definitions are parsed while the textures are loaded
+            EntityDefinitionLoad entityDefinitions(m_game, entityDefinitionFile(), externalSearchPaths());
             loadEntityModels();
             loadTextures();
             setTextures();
+            loadEntityDefinitions(entityDefinitions);
+            setEntityDefinitions();
         }
         
         void MapDocument::unloadAssets() {
@@ -1424,13 +1560,26 @@ namespace TrenchBroom {
                 m_entityDefinitionManager->loadDefinitions(path, *m_game, status);
                 info("Loaded entity definition file " + path.lastComponent().asString());
             } catch (const Exception& e) {
-                if (spec.builtin())
-                    error("Could not load builtin entity definition file '%s': %s", spec.path().asString().c_str(), e.what());
-                else
-                    error("Could not load external entity definition file '%s': %s", spec.path().asString().c_str(), e.what());
+                entityDefinitionsNotLoaded(spec, e);
+            }
+        }
+        
+        void MapDocument::loadEntityDefinitions(EntityDefinitionLoad& load) {
+            try {
+                m_entityDefinitionManager->setDefinitions(load.definitions(this));
+                info("Loaded entity definition file " + load.path().lastComponent().asString());
+            } catch (const Exception& e) {
+                entityDefinitionsNotLoaded(load.spec(), e);
             }
         }
         
+        void MapDocument::entityDefinitionsNotLoaded(const Assets::EntityDefinitionFileSpec& spec, const Exception& e) {
+            if (spec.builtin())
+                error("Could not load builtin entity definition file '%s': %s", spec.path().asString().c_str(), e.what());
+            else
+                error("Could not load external entity definition file '%s': %s", spec.path().asString().c_str(), e.what());
+        }
+        
         void MapDocument::unloadEntityDefinitions() {
             unsetEntityDefinitions();
             m_entityDefinitionManager->clear();
@@ -1495,11 +1644,13 @@ namespace TrenchBroom {
         void MapDocument::setEntityDefinitions() {
             SetEntityDefinition visitor(*m_entityDefinitionManager);
             m_world->acceptAndRecurse(visitor);
+            setEntityModels();
         }
         
         void MapDocument::setEntityDefinitions(const Model::NodeList& nodes) {
             SetEntityDefinition visitor(*m_entityDefinitionManager);
             Model::Node::acceptAndRecurse(std::begin(nodes), std::end(nodes), visitor);
+            setEntityModels(nodes);
         }
         
         void MapDocument::unsetEntityDefinitions() {
@@ -1519,7 +1670,48 @@ namespace TrenchBroom {
             setEntityDefinitions();
         }
 
+        class SetEntityModel : public Model::NodeVisitor {
+        private:
+            const Assets::EntityModelManager& m_manager;
+        public:
+            SetEntityModel(const Assets::EntityModelManager& manager) :
+            m_manager(manager) {}
+        private:
+            void doVisit(Model::World* world) override   {}
+            void doVisit(Model::Layer* layer) override   {}
+            void doVisit(Model::Group* group) override   {}
+            void doVisit(Model::Entity* entity) override { entity->setModelBVH(m_manager.bvhIfLoaded(entity->modelSpecification())); }
+            void doVisit(Model::Brush* brush) override   {}
+        };
+        
+        class UnsetEntityModel : public Model::NodeVisitor {
+        private:
+            void doVisit(Model::World* world) override   {}
+            void doVisit(Model::Layer* layer) override   {}
+            void doVisit(Model::Group* group) override   {}
+            void doVisit(Model::Entity* entity) override { entity->setModelBVH(nullptr); }
+            void doVisit(Model::Brush* brush) override   {}
+        };
+        
+        void MapDocument::setEntityModels() {
+            SetEntityModel visitor(*m_entityModelManager);
+            m_world->acceptAndRecurse(visitor);
+        }
+        
+        void MapDocument::setEntityModels(const Model::NodeList& nodes) {
+            SetEntityModel visitor(*m_entityModelManager);
+            Model::Node::acceptAndRecurse(std::begin(nodes), std::end(nodes), visitor);
+        }
+        
+        void MapDocument::unsetEntityModels() {
+            UnsetEntityModel visitor;
+            m_world->acceptAndRecurse(visitor);
+        }
+
         void MapDocument::clearEntityModels() {
+            // entities refer to data owned by the model manager
+            if (m_world != nullptr)
+                unsetEntityModels();
             m_entityModelManager->clear();
         }
         
@@ -1678,6 +1870,20 @@ namespace TrenchBroom {
             m_mapViewConfig->mapViewConfigDidChangeNotifier.addObserver(mapViewConfigDidChangeNotifier);
             commandDoneNotifier.addObserver(this, &MapDocument::commandDone);
             commandUndoneNotifier.addObserver(this, &MapDocument::commandUndone);
+            
+            // these observers are registered before any view can register its own, so the editor context's
+            // cached visibility is always up to date by the time the views are notified
+            documentWasClearedNotifier.addObserver(this, &MapDocument::documentWasChanged);
+            documentWasNewedNotifier.addObserver(this, &MapDocument::documentWasChanged);
+            documentWasLoadedNotifier.addObserver(this, &MapDocument::documentWasChanged);
+            selectionDidChangeNotifier.addObserver(this, &MapDocument::selectionDidChange);
+            nodesWereAddedNotifier.addObserver(this, &MapDocument::nodesDidChange);
+            nodesWereRemovedNotifier.addObserver(this, &MapDocument::nodesDidChange);
+            nodesDidChangeNotifier.addObserver(this, &MapDocument::nodesDidChange);
+            nodeVisibilityDidChangeNotifier.addObserver(this, &MapDocument::nodesDidChange);
+            nodeLockingDidChangeNotifier.addObserver(this, &MapDocument::nodesDidChange);
+            brushFacesDidChangeNotifier.addObserver(this, &MapDocument::brushFacesDidChange);
+            entityDefinitionsDidChangeNotifier.addObserver(this, &MapDocument::entityDefinitionsDidChange);
         }
         
         void MapDocument::unbindObservers() {
@@ -1687,15 +1893,28 @@ namespace TrenchBroom {
             m_mapViewConfig->mapViewConfigDidChangeNotifier.removeObserver(mapViewConfigDidChangeNotifier);
             commandDoneNotifier.removeObserver(this, &MapDocument::commandDone);
             commandUndoneNotifier.removeObserver(this, &MapDocument::commandUndone);
+            
+            documentWasClearedNotifier.removeObserver(this, &MapDocument::documentWasChanged);
+            documentWasNewedNotifier.removeObserver(this, &MapDocument::documentWasChanged);
+            documentWasLoadedNotifier.removeObserver(this, &MapDocument::documentWasChanged);
+            selectionDidChangeNotifier.removeObserver(this, &MapDocument::selectionDidChange);
+            nodesWereAddedNotifier.removeObserver(this, &MapDocument::nodesDidChange);
+            nodesWereRemovedNotifier.removeObserver(this, &MapDocument::nodesDidChange);
+            nodesDidChangeNotifier.removeObserver(this, &MapDocument::nodesDidChange);
+            nodeVisibilityDidChangeNotifier.removeObserver(this, &MapDocument::nodesDidChange);
+            nodeLockingDidChangeNotifier.removeObserver(this, &MapDocument::nodesDidChange);
+            brushFacesDidChangeNotifier.removeObserver(this, &MapDocument::brushFacesDidChange);
+            entityDefinitionsDidChangeNotifier.removeObserver(this, &MapDocument::entityDefinitionsDidChange);
         }
         
         void MapDocument::preferenceDidChange(const IO::Path& path) {
             if (isGamePathPreference(path)) {
                 const Model::GameFactory& gameFactory = Model::GameFactory::instance();
                 const IO::Path newGamePath = gameFactory.gamePath(m_game->gameName());
-                m_game->setGamePath(newGamePath, this);
                 
+                // waits for pending model loads, which still read from the current game file system
                 clearEntityModels();
+                m_game->setGamePath(newGamePath, this);
                 
                 unsetTextures();
                 loadTextures();
@@ -1717,6 +1936,33 @@ namespace TrenchBroom {
             debug("Command '%s' undone", command->name().c_str());
         }
 
+        void MapDocument::documentWasChanged(MapDocument* document) {
+            m_editorContext->invalidateAllNodes();
+        }
+        
+        void MapDocument::selectionDidChange(const Selection& selection) {
+            m_editorContext->invalidateNodes(selection.selectedNodes());
+            m_editorContext->invalidateNodes(selection.deselectedNodes());
+        }
+        
+        void MapDocument::nodesDidChange(const Model::NodeList& nodes) {
+            m_editorContext->invalidateNodes(nodes);
+        }
+        
+        void MapDocument::brushFacesDidChange(const Model::BrushFaceList& faces) {
+            // changing a face's texture may change the content type of its brush
+            Model::NodeList brushes;
+            brushes.reserve(faces.size());
+            for (const Model::BrushFace* face : faces)
+                brushes.push_back(face->brush());
+            VectorUtils::sortAndRemoveDuplicates(brushes);
+            m_editorContext->invalidateNodes(brushes);
+        }
+        
+        void MapDocument::entityDefinitionsDidChange() {
+            m_editorContext->invalidateAllNodes();
+        }
+
         Transaction::Transaction(MapDocumentWPtr document, const String& name) :
         m_document(lock(document).get()),
         m_cancelled(false) {
@@ -39,7 +39,10 @@
 #include <memory>
 
 class Color;
+class Exception;
 namespace TrenchBroom {
+    class ThreadPool;
+    
     namespace Assets {
         class EntityDefinitionManager;
         class EntityModelManager;
@@ -58,6 +61,7 @@ namespace TrenchBroom {
     
     namespace View {
         class Command;
+        class EntityDefinitionLoad;
         class Grid;
         class MapViewConfig;
         class Selection;
@@ -98,6 +102,8 @@ namespace TrenchBroom {
             mutable bool m_selectionBoundsValid;
             
             ViewEffectsService* m_viewEffectsService;
+            
+            std::unique_ptr<ThreadPool> m_csgPool;
         public: // notification
             Notifier1<Command::Ptr> commandDoNotifier;
             Notifier1<Command::Ptr> commandDoneNotifier;
@@ -294,6 +300,8 @@ namespace TrenchBroom {
             bool csgSubtract();
             bool csgIntersect();
             bool csgHollow();
+        private:
+            ThreadPool& csgPool();
         public:
             bool clipBrushes(const Vec3& p1, const Vec3& p2, const Vec3& p3);
         public: // modifying entity attributes, declared in MapFacade interface
@@ -391,6 +399,8 @@ namespace TrenchBroom {
             void unloadAssets();
             
             void loadEntityDefinitions();
+            void loadEntityDefinitions(EntityDefinitionLoad& load);
+            void entityDefinitionsNotLoaded(const Assets::EntityDefinitionFileSpec& spec, const Exception& e);
             void unloadEntityDefinitions();
             
             void loadEntityModels();
@@ -406,6 +416,9 @@ namespace TrenchBroom {
             void unsetEntityDefinitions(const Model::NodeList& nodes);
             void reloadEntityDefinitions();
             
+            void setEntityModels();
+            void setEntityModels(const Model::NodeList& nodes);
+            void unsetEntityModels();
             void clearEntityModels();
 
             void setTextures();
@@ -445,6 +458,12 @@ namespace TrenchBroom {
             void preferenceDidChange(const IO::Path& path);
             void commandDone(Command::Ptr command);
             void commandUndone(UndoableCommand::Ptr command);
+            
+            void documentWasChanged(MapDocument* document);
+            void selectionDidChange(const Selection& selection);
+            void nodesDidChange(const Model::NodeList& nodes);
+            void brushFacesDidChange(const Model::BrushFaceList& faces);
+            void entityDefinitionsDidChange();
         };
 
         class Transaction {
@@ -42,6 +42,8 @@
 #include "Model/World.h"
 #include "View/Selection.h"
 
+#include <unordered_set>
+
 namespace TrenchBroom {
     namespace View {
         MapDocumentSPtr MapDocumentCommandFacade::newMapDocument() {
@@ -199,7 +201,8 @@ namespace TrenchBroom {
             
             const Model::NodeList& partiallyDeselected = visitor.nodes();
 
-            VectorUtils::eraseAll(m_selectedBrushFaces, deselected);
+            const std::unordered_set<const Model::BrushFace*> deselectedSet(std::begin(deselected), std::end(deselected));
+            VectorUtils::eraseIf(m_selectedBrushFaces, [&deselectedSet](const Model::BrushFace* face) { return deselectedSet.count(face) > 0; });
             m_selectedNodes.removeNodes(partiallyDeselected);
             
             Selection selection;
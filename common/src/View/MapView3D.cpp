@@ -590,7 +590,7 @@ namespace TrenchBroom {
                 Renderer::BoundsGuideRenderer* guideRenderer = new Renderer::BoundsGuideRenderer(m_document);
                 guideRenderer->setColor(pref(Preferences::SelectionBoundsColor));
                 guideRenderer->setBounds(bounds);
-                renderBatch.addOneShot(guideRenderer);
+                renderBatch.addTransient(guideRenderer);
             }
         }
         
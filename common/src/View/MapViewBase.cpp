@@ -23,6 +23,7 @@
 #include "PreferenceManager.h"
 #include "Preferences.h"
 #include "Assets/EntityDefinitionManager.h"
+#include "Assets/EntityModelManager.h"
 #include "Model/Brush.h"
 #include "Model/BrushFace.h"
 #include "Model/BrushGeometry.h"
@@ -130,6 +131,7 @@ namespace TrenchBroom {
 			document->documentWasNewedNotifier.addObserver(this, &MapViewBase::documentDidChange);
 			document->documentWasClearedNotifier.addObserver(this, &MapViewBase::documentDidChange);
 			document->documentWasLoadedNotifier.addObserver(this, &MapViewBase::documentDidChange);
+            document->entityModelManager().modelsWereLoadedNotifier.addObserver(this, &MapViewBase::entityModelsWereLoaded);
 
             Grid& grid = document->grid();
             grid.gridDidChangeNotifier.addObserver(this, &MapViewBase::gridDidChange);
@@ -160,6 +162,7 @@ namespace TrenchBroom {
 				document->documentWasNewedNotifier.removeObserver(this, &MapViewBase::documentDidChange);
 				document->documentWasClearedNotifier.removeObserver(this, &MapViewBase::documentDidChange);
 				document->documentWasLoadedNotifier.removeObserver(this, &MapViewBase::documentDidChange);
+                document->entityModelManager().modelsWereLoadedNotifier.removeObserver(this, &MapViewBase::entityModelsWereLoaded);
 
                 Grid& grid = document->grid();
                 grid.gridDidChangeNotifier.removeObserver(this, &MapViewBase::gridDidChange);
@@ -231,9 +234,14 @@ namespace TrenchBroom {
 			Refresh();
 		}
 
+        void MapViewBase::entityModelsWereLoaded() {
+            Refresh();
+        }
+
 		void MapViewBase::bindEvents() {
             Bind(wxEVT_SET_FOCUS, &MapViewBase::OnSetFocus, this);
             Bind(wxEVT_KILL_FOCUS, &MapViewBase::OnKillFocus, this);
+            Bind(wxEVT_IDLE, &MapViewBase::OnIdle, this);
 
             Bind(wxEVT_MENU, &MapViewBase::OnToggleClipSide,               this, CommandIds::Actions::ToggleClipSide);
             Bind(wxEVT_MENU, &MapViewBase::OnPerformClip,                  this, CommandIds::Actions::PerformClip);
@@ -746,6 +754,16 @@ namespace TrenchBroom {
             event.Skip();
 		}
 
+        void MapViewBase::OnIdle(wxIdleEvent& event) {
+            if (IsBeingDeleted()) return;
+
+            // Commit any entity models that finished loading in the background. This notifies all views to refresh.
+            MapDocumentSPtr document = lock(m_document);
+            if (document->entityModelManager().hasLoadedModels())
+                document->commitPendingAssets();
+            event.Skip();
+        }
+
         void MapViewBase::OnActivateFrame(wxActivateEvent& event) {
             if (IsBeingDeleted()) return;
 
@@ -874,11 +892,12 @@ namespace TrenchBroom {
             renderContext.setShowFog(mapViewConfig.showFog());
             renderContext.setShowGrid(grid.visible());
             renderContext.setGridSize(grid.actualSize());
+            renderContext.setFaceDrawStats(&m_faceDrawStats);
 
             setupGL(renderContext);
             setRenderOptions(renderContext);
 
-            Renderer::RenderBatch renderBatch(vertexVbo(), indexVbo());
+            Renderer::RenderBatch renderBatch(vertexVbo(), indexVbo(), streamVbo());
 
             doRenderGrid(renderContext, renderBatch);
             doRenderMap(m_renderer, renderContext, renderBatch);
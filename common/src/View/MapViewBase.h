@@ -76,6 +76,7 @@ namespace TrenchBroom {
         private:
             Renderer::MapRenderer& m_renderer;
             Renderer::Compass* m_compass;
+            Renderer::FaceDrawList::Stats m_faceDrawStats;
         protected:
             MapViewBase(wxWindow* parent, Logger* logger, MapDocumentWPtr document, MapViewToolBox& toolBox, Renderer::MapRenderer& renderer, GLContextManager& contextManager);
             
@@ -99,6 +100,7 @@ namespace TrenchBroom {
             void gridDidChange();
             void preferenceDidChange(const IO::Path& path);
 			void documentDidChange(MapDocument* document);
+            void entityModelsWereLoaded();
         private: // interaction events
             void bindEvents();
             
@@ -188,6 +190,7 @@ namespace TrenchBroom {
             void OnSetFocus(wxFocusEvent& event);
             void OnKillFocus(wxFocusEvent& event);
             void OnActivateFrame(wxActivateEvent& event);
+            void OnIdle(wxIdleEvent& event);
         protected: // accelerator table management
             void updateAcceleratorTable();
         private:
@@ -91,6 +91,10 @@ namespace TrenchBroom {
             return m_glContext->indexVbo();
         }
         
+        Renderer::Vbo& RenderView::streamVbo() {
+            return m_glContext->streamVbo();
+        }
+        
         Renderer::FontManager& RenderView::fontManager() {
             return m_glContext->fontManager();
         }
@@ -257,7 +257,7 @@ namespace TrenchBroom {
             const Model::Hit& angleHandleHit = pickResult.query().type(AngleHandleHit).occluded().first();
             const bool highlight = angleHandleHit.isMatch() || thisToolDragging();
             
-            renderBatch.addOneShot(new Render(m_helper, CenterHandleRadius, RotateHandleRadius, highlight));
+            renderBatch.addTransient(new Render(m_helper, CenterHandleRadius, RotateHandleRadius, highlight));
         }
         
         bool UVRotateTool::doCancel() {
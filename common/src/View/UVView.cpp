@@ -164,7 +164,7 @@ namespace TrenchBroom {
                 document->commitPendingAssets();
                 
                 Renderer::RenderContext renderContext(Renderer::RenderContext::RenderMode_2D, m_camera, fontManager(), shaderManager());
-                Renderer::RenderBatch renderBatch(vertexVbo(), indexVbo());
+                Renderer::RenderBatch renderBatch(vertexVbo(), indexVbo(), streamVbo());
                 
                 setupGL(renderContext);
                 renderTexture(renderContext, renderBatch);
@@ -273,7 +273,7 @@ namespace TrenchBroom {
             if (texture == nullptr)
                 return;
 
-            renderBatch.addOneShot(new RenderTexture(m_helper));
+            renderBatch.addTransient(new RenderTexture(m_helper));
         }
         
         void UVView::renderFace(Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch) {
@@ -25,20 +25,87 @@
 
 namespace TrenchBroom {
     namespace View {
+        const FloatType VertexHandleManagerBase::CellSize = 64.0;
+        const FloatType VertexHandleManagerBase::CellOffset = 0.5;
+        const FloatType VertexHandleManagerBase::CompareEpsilon = 0.1;
+        
+        VertexHandleManagerBase::CellKey::CellKey(const long i_x, const long i_y, const long i_z) :
+        x(i_x),
+        y(i_y),
+        z(i_z) {}
+        
+        bool VertexHandleManagerBase::CellKey::operator==(const CellKey& other) const {
+            return x == other.x && y == other.y && z == other.z;
+        }
+        
+        size_t VertexHandleManagerBase::CellKeyHash::operator()(const CellKey& key) const {
+            std::hash<long> hash;
+            size_t result = hash(key.x);
+            result = result * 31 + hash(key.y);
+            result = result * 31 + hash(key.z);
+            return result;
+        }
+        
+        VertexHandleManagerBase::CellKey VertexHandleManagerBase::cellKey(const Vec3& position) {
+            return CellKey(static_cast<long>(std::floor((position.x() + CellOffset) / CellSize)),
+                           static_cast<long>(std::floor((position.y() + CellOffset) / CellSize)),
+                           static_cast<long>(std::floor((position.z() + CellOffset) / CellSize)));
+        }
+        
+        const Vec3& VertexHandleManagerBase::handleAnchor(const Vec3& handle) {
+            return handle;
+        }
+        
+        const Vec3& VertexHandleManagerBase::handleAnchor(const Edge3& handle) {
+            return handle.start();
+        }
+        
+        const Vec3& VertexHandleManagerBase::handleAnchor(const Polygon3& handle) {
+            assert(handle.vertexCount() > 0);
+            return handle.vertices().front();
+        }
+        
+        BBox3 VertexHandleManagerBase::handleBounds(const Vec3& handle) {
+            return BBox3(handle, handle);
+        }
+        
+        BBox3 VertexHandleManagerBase::handleBounds(const Edge3& handle) {
+            return BBox3(handle.start(), handle.start()).mergeWith(handle.end());
+        }
+        
+        BBox3 VertexHandleManagerBase::handleBounds(const Polygon3& handle) {
+            return BBox3(handle.vertices());
+        }
+        
+        bool VertexHandleManagerBase::touches(const BBox3& bounds, const Ray3& pickRay, const Renderer::Camera& camera, const FloatType handleRadius) {
+            FloatType maxScaling = 0.0;
+            for (size_t i = 0; i < 8; ++i) {
+                const BBox3::Corner x = (i & 1) ? BBox3::Corner_Max : BBox3::Corner_Min;
+                const BBox3::Corner y = (i & 2) ? BBox3::Corner_Max : BBox3::Corner_Min;
+                const BBox3::Corner z = (i & 4) ? BBox3::Corner_Max : BBox3::Corner_Min;
+                const float scaling = camera.perspectiveScalingFactor(Vec3f(bounds.vertex(x, y, z)));
+                maxScaling = std::max(maxScaling, static_cast<FloatType>(std::abs(scaling)));
+            }
+            
+            const BBox3 expanded = bounds.expanded(2.0 * handleRadius * maxScaling);
+            return expanded.contains(pickRay.origin) || !Math::isnan(expanded.intersectWithRay(pickRay));
+        }
+        
         VertexHandleManagerBase::~VertexHandleManagerBase() {}
 
         const Model::Hit::HitType VertexHandleManager::HandleHit = Model::Hit::freeHitType();
 
         void VertexHandleManager::pick(const Ray3& pickRay, const Renderer::Camera& camera, Model::PickResult& pickResult) const {
-            for (const HandleEntry& entry : m_handles) {
-                const Vec3& position = entry.first;
-                const FloatType distance = camera.pickPointHandle(pickRay, position, pref(Preferences::HandleRadius));
-                if (!Math::isnan(distance)) {
-                    const Vec3 hitPoint = pickRay.pointAtDistance(distance);
-                    const FloatType error = pickRay.squaredDistanceToPoint(position).distance;
-                    pickResult.addHit(Model::Hit::hit(HandleHit, distance, hitPoint, position, error));
-                }
-            }
+            const FloatType handleRadius = pref(Preferences::HandleRadius);
+            pickHandles(pickRay, camera, handleRadius, [&](const Vec3& position) {
+                const FloatType distance = camera.pickPointHandle(pickRay, position, handleRadius);
+                if (Math::isnan(distance))
+                    return Model::Hit::NoHit;
+                
+                const Vec3 hitPoint = pickRay.pointAtDistance(distance);
+                const FloatType error = pickRay.squaredDistanceToPoint(position).distance;
+                return Model::Hit::hit(HandleHit, distance, hitPoint, position, error);
+            }, pickResult);
         }
         
         void VertexHandleManager::addHandles(const Model::Brush* brush) {
@@ -64,31 +131,34 @@ namespace TrenchBroom {
         const Model::Hit::HitType EdgeHandleManager::HandleHit = Model::Hit::freeHitType();
 
         void EdgeHandleManager::pickGridHandle(const Ray3& pickRay, const Renderer::Camera& camera, const Grid& grid, Model::PickResult& pickResult) const {
-            for (const HandleEntry& entry : m_handles) {
-                const Edge3& position = entry.first;
-                const FloatType edgeDist = camera.pickLineSegmentHandle(pickRay, position, pref(Preferences::HandleRadius));
-                if (!Math::isnan(edgeDist)) {
-                    const Vec3 pointHandle = grid.snap(pickRay.pointAtDistance(edgeDist), position);
-                    const FloatType pointDist = camera.pickPointHandle(pickRay, pointHandle, pref(Preferences::HandleRadius));
-                    if (!Math::isnan(pointDist)) {
-                        const Vec3 hitPoint = pickRay.pointAtDistance(pointDist);
-                        pickResult.addHit(Model::Hit::hit(HandleHit, pointDist, hitPoint, HitType(position, pointHandle)));
-                    }
-                }
-            }
+            const FloatType handleRadius = pref(Preferences::HandleRadius);
+            pickHandles(pickRay, camera, handleRadius, [&](const Edge3& position) {
+                const FloatType edgeDist = camera.pickLineSegmentHandle(pickRay, position, handleRadius);
+                if (Math::isnan(edgeDist))
+                    return Model::Hit::NoHit;
+                
+                const Vec3 pointHandle = grid.snap(pickRay.pointAtDistance(edgeDist), position);
+                const FloatType pointDist = camera.pickPointHandle(pickRay, pointHandle, handleRadius);
+                if (Math::isnan(pointDist))
+                    return Model::Hit::NoHit;
+                
+                const Vec3 hitPoint = pickRay.pointAtDistance(pointDist);
+                return Model::Hit::hit(HandleHit, pointDist, hitPoint, HitType(position, pointHandle));
+            }, pickResult);
         }
 
         void EdgeHandleManager::pickCenterHandle(const Ray3& pickRay, const Renderer::Camera& camera, Model::PickResult& pickResult) const {
-            for (const HandleEntry& entry : m_handles) {
-                const Edge3& position = entry.first;
+            const FloatType handleRadius = pref(Preferences::HandleRadius);
+            pickHandles(pickRay, camera, handleRadius, [&](const Edge3& position) {
                 const Vec3 pointHandle = position.center();
 
-                const FloatType pointDist = camera.pickPointHandle(pickRay, pointHandle, pref(Preferences::HandleRadius));
-                if (!Math::isnan(pointDist)) {
-                    const Vec3 hitPoint = pickRay.pointAtDistance(pointDist);
-                    pickResult.addHit(Model::Hit::hit(HandleHit, pointDist, hitPoint, position));
-                }
-            }
+                const FloatType pointDist = camera.pickPointHandle(pickRay, pointHandle, handleRadius);
+                if (Math::isnan(pointDist))
+                    return Model::Hit::NoHit;
+                
+                const Vec3 hitPoint = pickRay.pointAtDistance(pointDist);
+                return Model::Hit::hit(HandleHit, pointDist, hitPoint, position);
+            }, pickResult);
         }
 
         void EdgeHandleManager::addHandles(const Model::Brush* brush) {
@@ -114,37 +184,38 @@ namespace TrenchBroom {
         const Model::Hit::HitType FaceHandleManager::HandleHit = Model::Hit::freeHitType();
 
         void FaceHandleManager::pickGridHandle(const Ray3& pickRay, const Renderer::Camera& camera, const Grid& grid, Model::PickResult& pickResult) const {
-            for (const HandleEntry& entry : m_handles) {
-                const Polygon3& position = entry.first;
-                
+            const FloatType handleRadius = pref(Preferences::HandleRadius);
+            pickHandles(pickRay, camera, handleRadius, [&](const Polygon3& position) {
                 Plane3 plane;
                 if (!getPlane(std::begin(position), std::end(position), plane))
-                    continue;
+                    return Model::Hit::NoHit;
                 
                 const FloatType distance = intersectPolygonWithRay(pickRay, plane, std::begin(position), std::end(position));
-                if (!Math::isnan(distance)) {
-                    const Vec3 pointHandle = grid.snap(pickRay.pointAtDistance(distance), plane);
-                    
-                    const FloatType pointDist = camera.pickPointHandle(pickRay, pointHandle, pref(Preferences::HandleRadius));
-                    if (!Math::isnan(pointDist)) {
-                        const Vec3 hitPoint = pickRay.pointAtDistance(pointDist);
-                        pickResult.addHit(Model::Hit::hit(HandleHit, pointDist, hitPoint, HitType(position, pointHandle)));
-                    }
-                }
-            }
+                if (Math::isnan(distance))
+                    return Model::Hit::NoHit;
+                
+                const Vec3 pointHandle = grid.snap(pickRay.pointAtDistance(distance), plane);
+                const FloatType pointDist = camera.pickPointHandle(pickRay, pointHandle, handleRadius);
+                if (Math::isnan(pointDist))
+                    return Model::Hit::NoHit;
+                
+                const Vec3 hitPoint = pickRay.pointAtDistance(pointDist);
+                return Model::Hit::hit(HandleHit, pointDist, hitPoint, HitType(position, pointHandle));
+            }, pickResult);
         }
 
         void FaceHandleManager::pickCenterHandle(const Ray3& pickRay, const Renderer::Camera& camera, Model::PickResult& pickResult) const {
-            for (const HandleEntry& entry : m_handles) {
-                const Polygon3& position = entry.first;
+            const FloatType handleRadius = pref(Preferences::HandleRadius);
+            pickHandles(pickRay, camera, handleRadius, [&](const Polygon3& position) {
                 const Vec3 pointHandle = position.center();
 
-                const FloatType pointDist = camera.pickPointHandle(pickRay, pointHandle, pref(Preferences::HandleRadius));
-                if (!Math::isnan(pointDist)) {
-                    const Vec3 hitPoint = pickRay.pointAtDistance(pointDist);
-                    pickResult.addHit(Model::Hit::hit(HandleHit, pointDist, hitPoint, position));
-                }
-            }
+                const FloatType pointDist = camera.pickPointHandle(pickRay, pointHandle, handleRadius);
+                if (Math::isnan(pointDist))
+                    return Model::Hit::NoHit;
+                
+                const Vec3 hitPoint = pickRay.pointAtDistance(pointDist);
+                return Model::Hit::hit(HandleHit, pointDist, hitPoint, position);
+            }, pickResult);
         }
 
         void FaceHandleManager::addHandles(const Model::Brush* brush) {
@@ -31,7 +31,8 @@
 
 #include <algorithm>
 #include <iterator>
-#include <map>
+#include <unordered_map>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Model {
@@ -47,6 +48,47 @@ namespace TrenchBroom {
         class Grid;
         
         class VertexHandleManagerBase {
+        protected:
+            /**
+             * Handles are indexed in a hashed grid of cubic cells. A handle is stored in the cell that contains its
+             * anchor, which is the first vertex of the handle. The cell boundaries are offset by half a unit so that
+             * handles which lie on the integer grid never straddle a cell boundary.
+             */
+            static const FloatType CellSize;
+            static const FloatType CellOffset;
+            
+            /**
+             * Two handles are considered identical if all of their coordinates differ by at most this value.
+             */
+            static const FloatType CompareEpsilon;
+            
+            struct CellKey {
+                long x, y, z;
+                
+                CellKey(long i_x, long i_y, long i_z);
+                bool operator==(const CellKey& other) const;
+            };
+            
+            struct CellKeyHash {
+                size_t operator()(const CellKey& key) const;
+            };
+            
+            static CellKey cellKey(const Vec3& position);
+            
+            static const Vec3& handleAnchor(const Vec3& handle);
+            static const Vec3& handleAnchor(const Edge3& handle);
+            static const Vec3& handleAnchor(const Polygon3& handle);
+            
+            static BBox3 handleBounds(const Vec3& handle);
+            static BBox3 handleBounds(const Edge3& handle);
+            static BBox3 handleBounds(const Polygon3& handle);
+            
+            /**
+             * Checks whether the given pick ray can hit any handle within the given bounds. Since the pick radius of
+             * a handle depends on its distance to the camera, the bounds are expanded by the largest pick radius at
+             * any of their corners.
+             */
+            static bool touches(const BBox3& bounds, const Ray3& pickRay, const Renderer::Camera& camera, FloatType handleRadius);
         public:
             virtual ~VertexHandleManagerBase();
         public:
@@ -65,14 +107,6 @@ namespace TrenchBroom {
             virtual void removeHandles(const Model::Brush* brush) = 0;
         };
 
-        template <typename H>
-        class HCmp {
-        public:
-            bool operator()(const H& lhs, const H& rhs) const {
-                return lhs.compare(rhs, 0.1) < 0;
-            }
-        };
-
         template <typename H>
         class VertexHandleManagerBaseT : public VertexHandleManagerBase {
         public:
@@ -114,14 +148,23 @@ namespace TrenchBroom {
                 }
             };
             
-            typedef std::map<H, HandleInfo, HCmp<H>> HandleMap;
-            typedef typename HandleMap::value_type HandleEntry;
-
-            HandleMap m_handles;
+            struct Cell {
+                std::vector<size_t> indices;
+                BBox3 bounds;
+            };
+            
+            typedef std::unordered_map<CellKey, Cell, CellKeyHash> CellMap;
+            
+            // The handles and their infos are kept in packed arrays that are indexed by the grid cells.
+            HandleList m_handles;
+            std::vector<HandleInfo> m_infos;
+            CellMap m_cells;
             size_t m_selectedHandleCount;
+            size_t m_revision;
         public:
             VertexHandleManagerBaseT() :
-            m_selectedHandleCount(0) {}
+            m_selectedHandleCount(0),
+            m_revision(0) {}
             
             virtual ~VertexHandleManagerBaseT() {}
         public:
@@ -138,12 +181,17 @@ namespace TrenchBroom {
             size_t totalHandleCount() const {
                 return m_handles.size();
             }
+            
+            /**
+             * Returns a number that changes whenever a handle is added, removed, selected or deselected, so that data
+             * derived from the handles can be reused until the handles change.
+             */
+            size_t revision() const {
+                return m_revision;
+            }
         public:
-            HandleList allHandles() const {
-                HandleList result;
-                result.reserve(totalHandleCount());
-                collectHandles([](const HandleInfo& info) { return true; }, std::back_inserter(result));
-                return result;
+            const HandleList& allHandles() const {
+                return m_handles;
             }
             
             HandleList selectedHandles() const {
@@ -163,23 +211,21 @@ namespace TrenchBroom {
         private:
             template <typename T, typename O>
             void collectHandles(const T& test, O out) const {
-                for (const HandleEntry& entry : m_handles) {
-                    const Handle& handle = entry.first;
-                    const HandleInfo& info = entry.second;
-                    if (test(info))
-                        out = handle;
+                for (size_t i = 0; i < m_handles.size(); ++i) {
+                    if (test(m_infos[i]))
+                        out = m_handles[i];
                 }
             }
         public:
             bool contains(const Handle& handle) const {
-                return m_handles.count(handle) > 0;
+                return find(handle) < m_handles.size();
             }
 
             bool selected(const Handle& handle) const {
-                const auto it = m_handles.find(handle);
-                if (it == std::end(m_handles))
+                const size_t index = find(handle);
+                if (index == m_handles.size())
                     return false;
-                return it->second.selected;
+                return m_infos[index].selected;
             }
             
             bool anySelected() const {
@@ -191,28 +237,44 @@ namespace TrenchBroom {
             }
         public:
             void add(const Handle& handle) {
-                MapUtils::findOrInsert(m_handles, handle, HandleInfo())->second.inc();
+                size_t index = find(handle);
+                if (index == m_handles.size()) {
+                    m_handles.push_back(handle);
+                    m_infos.push_back(HandleInfo());
+                    
+                    Cell& cell = m_cells[cellKey(handleAnchor(handle))];
+                    const BBox3 bounds = handleBounds(handle);
+                    if (cell.indices.empty())
+                        cell.bounds = bounds;
+                    else
+                        cell.bounds.mergeWith(bounds);
+                    cell.indices.push_back(index);
+                    ++m_revision;
+                }
+                m_infos[index].inc();
             }
             
             bool remove(const Handle& handle) {
-                const auto it = m_handles.find(handle);
-                if (it != std::end(m_handles)) {
-                    HandleInfo& info = it->second;
-                    info.dec();
-                    
-                    if (info.count == 0) {
-                        deselect(info);
-                        m_handles.erase(it);
-                    }
-                    return true;
+                const size_t index = find(handle);
+                if (index == m_handles.size())
+                    return false;
+                
+                HandleInfo& info = m_infos[index];
+                info.dec();
+                
+                if (info.count == 0) {
+                    deselect(info);
+                    erase(index);
                 }
-
-                return false;
+                return true;
             }
 
             void clear() {
                 m_handles.clear();
+                m_infos.clear();
+                m_cells.clear();
                 m_selectedHandleCount = 0;
+                ++m_revision;
             }
 
             template <typename I>
@@ -221,9 +283,9 @@ namespace TrenchBroom {
             }
             
             void select(const Handle& handle) {
-                const auto it = m_handles.find(handle);
-                if (it != std::end(m_handles)) {
-                    select(it->second);
+                const size_t index = find(handle);
+                if (index < m_handles.size()) {
+                    select(m_infos[index]);
                 }
             }
             
@@ -233,16 +295,17 @@ namespace TrenchBroom {
             }
             
             void deselect(const Handle& handle) {
-                const auto it = m_handles.find(handle);
-                if (it != std::end(m_handles)) {
-                    deselect(it->second);
+                const size_t index = find(handle);
+                if (index < m_handles.size()) {
+                    deselect(m_infos[index]);
                 }
             }
             
             void deselectAll() {
-                std::for_each(std::begin(m_handles), std::end(m_handles), [this](HandleEntry& entry) {
-                    deselect(entry.second);
-                });
+                for (HandleInfo& info : m_infos)
+                    info.deselect();
+                m_selectedHandleCount = 0;
+                ++m_revision;
             }
             
             template <typename I>
@@ -251,9 +314,9 @@ namespace TrenchBroom {
             }
             
             void toggle(const Handle& handle) {
-                const auto it = m_handles.find(handle);
-                if (it != std::end(m_handles)) {
-                    toggle(it->second);
+                const size_t index = find(handle);
+                if (index < m_handles.size()) {
+                    toggle(m_infos[index]);
                 }
             }
         private:
@@ -261,6 +324,7 @@ namespace TrenchBroom {
                 if (info.select()) {
                     assert(selectedHandleCount() < totalHandleCount());
                     ++m_selectedHandleCount;
+                    ++m_revision;
                 }
             }
             
@@ -268,6 +332,7 @@ namespace TrenchBroom {
                 if (info.deselect()) {
                     assert(m_selectedHandleCount > 0);
                     --m_selectedHandleCount;
+                    ++m_revision;
                 }
             }
             
@@ -279,15 +344,106 @@ namespace TrenchBroom {
                     assert(m_selectedHandleCount > 0);
                     --m_selectedHandleCount;
                 }
+                ++m_revision;
+            }
+        private:
+            /**
+             * Returns the index of the given handle, or the number of handles if it is unknown. Only the cells
+             * which are within the compare epsilon of the handle's anchor are searched, which is usually just one.
+             */
+            size_t find(const Handle& handle) const {
+                const Vec3& anchor = handleAnchor(handle);
+                const CellKey min = cellKey(anchor - Vec3(CompareEpsilon, CompareEpsilon, CompareEpsilon));
+                const CellKey max = cellKey(anchor + Vec3(CompareEpsilon, CompareEpsilon, CompareEpsilon));
+                
+                for (long x = min.x; x <= max.x; ++x) {
+                    for (long y = min.y; y <= max.y; ++y) {
+                        for (long z = min.z; z <= max.z; ++z) {
+                            const auto it = m_cells.find(CellKey(x, y, z));
+                            if (it == std::end(m_cells))
+                                continue;
+                            
+                            for (const size_t index : it->second.indices) {
+                                if (m_handles[index].compare(handle, CompareEpsilon) == 0)
+                                    return index;
+                            }
+                        }
+                    }
+                }
+                return m_handles.size();
+            }
+            
+            /**
+             * Removes the handle at the given index by moving the last handle into its place.
+             */
+            void erase(const size_t index) {
+                removeFromCell(index);
+                
+                const size_t last = m_handles.size() - 1;
+                if (index != last) {
+                    Cell& cell = m_cells.at(cellKey(handleAnchor(m_handles[last])));
+                    std::replace(std::begin(cell.indices), std::end(cell.indices), last, index);
+                    
+                    m_handles[index] = m_handles[last];
+                    m_infos[index] = m_infos[last];
+                }
+                
+                m_handles.pop_back();
+                m_infos.pop_back();
+                ++m_revision;
+            }
+            
+            void removeFromCell(const size_t index) {
+                const auto it = m_cells.find(cellKey(handleAnchor(m_handles[index])));
+                assert(it != std::end(m_cells));
+                
+                // The cell bounds are not shrunk here, they just become less tight until the cell is emptied.
+                std::vector<size_t>& indices = it->second.indices;
+                const auto pos = std::find(std::begin(indices), std::end(indices), index);
+                assert(pos != std::end(indices));
+                *pos = indices.back();
+                indices.pop_back();
+                
+                if (indices.empty())
+                    m_cells.erase(it);
             }
         public:
+            /**
+             * Adds every handle which passes the given handle test to the given output iterator. The handles of cells
+             * whose bounds do not pass the given bounds test are skipped without testing them.
+             */
+            template <typename B, typename T, typename O>
+            void findHandles(const B& boundsTest, const T& handleTest, O out) const {
+                for (const auto& entry : m_cells) {
+                    const Cell& cell = entry.second;
+                    if (!boundsTest(cell.bounds))
+                        continue;
+                    
+                    for (const size_t index : cell.indices) {
+                        const Handle& handle = m_handles[index];
+                        if (handleTest(handle))
+                            out = handle;
+                    }
+                }
+            }
+            
+            /**
+             * Tests the handles of every cell that the given pick ray comes close enough to and adds the hits returned
+             * by the given test to the given pick result.
+             */
             template <typename P>
-            void pick(const P& test, Model::PickResult& pickResult) const {
-                std::for_each(std::begin(m_handles), std::end(m_handles), [&test, &pickResult](const HandleEntry& entry) {
-                    const Model::Hit hit = test(entry.first);
-                    if (hit.isMatch())
-                        pickResult.addHit(hit);
-                });
+            void pickHandles(const Ray3& pickRay, const Renderer::Camera& camera, const FloatType handleRadius, const P& test, Model::PickResult& pickResult) const {
+                for (const auto& entry : m_cells) {
+                    const Cell& cell = entry.second;
+                    if (!touches(cell.bounds, pickRay, camera, handleRadius))
+                        continue;
+                    
+                    for (const size_t index : cell.indices) {
+                        const Model::Hit hit = test(m_handles[index]);
+                        if (hit.isMatch())
+                            pickResult.addHit(hit);
+                    }
+                }
             }
         public:
             template <typename I>
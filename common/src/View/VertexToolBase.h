@@ -46,6 +46,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <limits>
 #include <numeric>
 
 namespace TrenchBroom {
@@ -78,12 +79,23 @@ namespace TrenchBroom {
             
             H m_dragHandlePosition;
             bool m_dragging;
+        private:
+            typedef std::vector<typename H::FloatType> RenderHandleList;
+            
+            /**
+             * The handles are rendered by every map view, so their positions are collected once per revision of the
+             * handle manager and shared by all views instead of being collected by each view in every frame.
+             */
+            mutable RenderHandleList m_unselectedRenderHandles;
+            mutable RenderHandleList m_selectedRenderHandles;
+            mutable size_t m_renderHandleRevision;
         protected:
             VertexToolBase(MapDocumentWPtr document) :
             Tool(false),
             m_document(document),
             m_changeCount(0),
-            m_dragging(false) {}
+            m_dragging(false),
+            m_renderHandleRevision(std::numeric_limits<size_t>::max()) {}
         public:
             virtual ~VertexToolBase() override {}
         public:
@@ -158,10 +170,10 @@ namespace TrenchBroom {
             void select(const Lasso& lasso, const bool modifySelection) {
                 typedef std::vector<H> HandleList;
                 
-                const HandleList allHandles = handleManager().allHandles();
                 HandleList selectedHandles;
-                
-                lasso.selected(std::begin(allHandles), std::end(allHandles), std::back_inserter(selectedHandles));
+                handleManager().findHandles([&lasso](const BBox3& bounds) { return lasso.mayContain(bounds); },
+                                            [&lasso](const H& handle) { return lasso.selects(handle); },
+                                            std::back_inserter(selectedHandles));
                 if (!modifySelection)
                     handleManager().deselectAll();
                 handleManager().toggle(std::begin(selectedHandles), std::end(selectedHandles));
@@ -252,11 +264,13 @@ namespace TrenchBroom {
             }
         public: // rendering
             void renderHandles(Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch) const {
+                validateRenderHandles();
+                
                 Renderer::RenderService renderService(renderContext, renderBatch);
-                if (!handleManager().allSelected())
-                    renderHandles(handleManager().unselectedHandles(), renderService, pref(Preferences::HandleColor));
-                if (handleManager().anySelected())
-                    renderHandles(handleManager().selectedHandles(), renderService, pref(Preferences::SelectedHandleColor));
+                if (!m_unselectedRenderHandles.empty())
+                    renderHandles(m_unselectedRenderHandles, renderService, pref(Preferences::HandleColor));
+                if (!m_selectedRenderHandles.empty())
+                    renderHandles(m_selectedRenderHandles, renderService, pref(Preferences::SelectedHandleColor));
             }
             
             void renderDragHandle(Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch) const {
@@ -276,10 +290,19 @@ namespace TrenchBroom {
                 renderGuide(renderContext, renderBatch, m_dragHandlePosition);
             }
 
-            template <typename HH>
-            void renderHandles(const std::vector<HH>& handles, Renderer::RenderService& renderService, const Color& color) const {
+            void renderHandles(const RenderHandleList& handles, Renderer::RenderService& renderService, const Color& color) const {
                 renderService.setForegroundColor(color);
-                renderService.renderHandles(VectorUtils::cast<typename HH::FloatType>(handles));
+                renderService.renderHandles(handles);
+            }
+            
+            void validateRenderHandles() const {
+                const HandleManager& manager = handleManager();
+                if (m_renderHandleRevision == manager.revision())
+                    return;
+                
+                m_unselectedRenderHandles = VectorUtils::cast<typename H::FloatType>(manager.unselectedHandles());
+                m_selectedRenderHandles = VectorUtils::cast<typename H::FloatType>(manager.selectedHandles());
+                m_renderHandleRevision = manager.revision();
             }
             
             template <typename HH>
@@ -0,0 +1,79 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "MathUtils.h"
+#include "VecMath.h"
+#include "Assets/EntityModelBVH.h"
+
+namespace TrenchBroom {
+    namespace Assets {
+        // a row of unit squares in the XY plane at z = 0, each made of two triangles
+        static Vec3f::List makeSquares(const size_t count) {
+            Vec3f::List result;
+            for (size_t i = 0; i < count; ++i) {
+                const float x = static_cast<float>(i);
+                result.push_back(Vec3f(x,        0.0f, 0.0f));
+                result.push_back(Vec3f(x + 1.0f, 0.0f, 0.0f));
+                result.push_back(Vec3f(x + 1.0f, 1.0f, 0.0f));
+                
+                result.push_back(Vec3f(x,        0.0f, 0.0f));
+                result.push_back(Vec3f(x + 1.0f, 1.0f, 0.0f));
+                result.push_back(Vec3f(x,        1.0f, 0.0f));
+            }
+            return result;
+        }
+        
+        TEST(EntityModelBVHTest, emptyHierarchy) {
+            const EntityModelBVH bvh((Vec3f::List()));
+            ASSERT_EQ(0u, bvh.triangleCount());
+            ASSERT_EQ(0u, bvh.nodeCount());
+            ASSERT_TRUE(Math::isnan(bvh.intersectWithRay(Ray3f(Vec3f(0.5f, 0.5f, 1.0f), Vec3f::NegZ))));
+        }
+        
+        TEST(EntityModelBVHTest, buildHierarchy) {
+            const EntityModelBVH bvh(makeSquares(100));
+            ASSERT_EQ(200u, bvh.triangleCount());
+            ASSERT_LT(1u, bvh.nodeCount());
+            ASSERT_GT(200u, bvh.nodeCount());
+        }
+        
+        TEST(EntityModelBVHTest, intersectWithRay) {
+            const EntityModelBVH bvh(makeSquares(100));
+            
+            ASSERT_FLOAT_EQ(4.0f, bvh.intersectWithRay(Ray3f(Vec3f(42.5f, 0.25f, 4.0f), Vec3f::NegZ)));
+            ASSERT_FLOAT_EQ(2.0f, bvh.intersectWithRay(Ray3f(Vec3f(99.75f, 0.5f, -2.0f), Vec3f::PosZ)));
+            ASSERT_TRUE(Math::isnan(bvh.intersectWithRay(Ray3f(Vec3f(42.5f, 1.5f, 4.0f), Vec3f::NegZ))));
+            ASSERT_TRUE(Math::isnan(bvh.intersectWithRay(Ray3f(Vec3f(42.5f, 0.5f, 4.0f), Vec3f::PosZ))));
+        }
+        
+        TEST(EntityModelBVHTest, intersectWithRayReturnsClosestHit) {
+            Vec3f::List triangles = makeSquares(10);
+            for (size_t i = 0; i < 60; ++i) {
+                const Vec3f& v = triangles[i];
+                triangles.push_back(Vec3f(v.x(), v.y(), 3.0f));
+            }
+            
+            const EntityModelBVH bvh(triangles);
+            ASSERT_FLOAT_EQ(2.0f, bvh.intersectWithRay(Ray3f(Vec3f(5.5f, 0.5f, 5.0f), Vec3f::NegZ)));
+            ASSERT_FLOAT_EQ(1.0f, bvh.intersectWithRay(Ray3f(Vec3f(5.5f, 0.5f, -1.0f), Vec3f::PosZ)));
+        }
+    }
+}
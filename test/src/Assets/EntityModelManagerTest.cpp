@@ -0,0 +1,209 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Exceptions.h"
+#include "Assets/EntityModel.h"
+#include "Assets/EntityModelManager.h"
+#include "Assets/ModelDefinition.h"
+#include "IO/EntityModelLoader.h"
+#include "IO/Path.h"
+#include "Renderer/TexturedIndexRangeRenderer.h"
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <thread>
+
+namespace TrenchBroom {
+    namespace Assets {
+        class TestModel : public EntityModel {
+        private:
+            std::atomic<size_t>& m_deleted;
+        public:
+            TestModel(std::atomic<size_t>& deleted) :
+            m_deleted(deleted) {}
+            
+            ~TestModel() override {
+                ++m_deleted;
+            }
+        private:
+            Renderer::TexturedIndexRangeRenderer* doBuildRenderer(const size_t skinIndex, const size_t frameIndex) const override {
+                return new Renderer::TexturedIndexRangeRenderer();
+            }
+            
+            BBox3f doGetBounds(const size_t skinIndex, const size_t frameIndex) const override {
+                return BBox3f(8.0f);
+            }
+            
+            BBox3f doGetTransformedBounds(const size_t skinIndex, const size_t frameIndex, const Mat4x4f& transformation) const override {
+                return BBox3f(8.0f);
+            }
+            
+            Vec3f::List doGetTriangles(const size_t frameIndex) const override {
+                return Vec3f::List();
+            }
+            
+            void doPrepare(int minFilter, int magFilter) override {}
+            void doSetTextureMode(int minFilter, int magFilter) override {}
+        };
+        
+        /*
+         * Loads a test model for every path except for "missing.mdl", which it cannot find, and "broken.mdl", which
+         * makes it fail with an exception that is not a TrenchBroom exception. Every load waits until the loader is
+         * released.
+         */
+        class TestModelLoader : public IO::EntityModelLoader {
+        private:
+            std::shared_future<void> m_released;
+        public:
+            mutable std::atomic<size_t> loads;
+            mutable std::atomic<size_t> deleted;
+            
+            TestModelLoader(std::shared_future<void> released) :
+            m_released(released),
+            loads(0),
+            deleted(0) {}
+        private:
+            EntityModel* doLoadEntityModel(const IO::Path& path) const override {
+                m_released.wait();
+                ++loads;
+                
+                if (path == IO::Path("missing.mdl"))
+                    throw GameException("Cannot find model " + path.asString());
+                if (path == IO::Path("broken.mdl"))
+                    throw std::runtime_error("Cannot read model " + path.asString());
+                return new TestModel(deleted);
+            }
+        };
+        
+        class LoadObserver {
+        public:
+            size_t notifications;
+            
+            LoadObserver() :
+            notifications(0) {}
+            
+            void modelsWereLoaded() {
+                ++notifications;
+            }
+        };
+        
+        static void waitForLoadedModels(const EntityModelManager& manager) {
+            while (!manager.hasLoadedModels())
+                std::this_thread::yield();
+        }
+        
+        TEST(EntityModelManagerTest, loadModelAsync) {
+            std::promise<void> release;
+            TestModelLoader loader(release.get_future().share());
+            LoadObserver observer;
+            
+            EntityModelManager manager(nullptr, 0, 0);
+            manager.setLoader(&loader);
+            manager.modelsWereLoadedNotifier.addObserver(&observer, &LoadObserver::modelsWereLoaded);
+            
+            const ModelSpecification spec(IO::Path("model.mdl"));
+            
+            // querying for a model does not load it
+            ASSERT_EQ(nullptr, manager.rendererIfLoaded(spec));
+            ASSERT_FALSE(manager.hasModel(spec));
+            ASSERT_FALSE(manager.hasPendingModels());
+            
+            manager.requestModel(spec.path);
+            manager.requestModel(spec.path);
+            ASSERT_TRUE(manager.hasPendingModels());
+            ASSERT_FALSE(manager.hasLoadedModels());
+            ASSERT_EQ(nullptr, manager.rendererIfLoaded(spec));
+            
+            release.set_value();
+            waitForLoadedModels(manager);
+            ASSERT_EQ(nullptr, manager.rendererIfLoaded(spec));
+            ASSERT_EQ(0u, observer.notifications);
+            
+            manager.commitLoadedModels();
+            ASSERT_EQ(1u, observer.notifications);
+            ASSERT_FALSE(manager.hasPendingModels());
+            ASSERT_TRUE(manager.hasModel(spec));
+            ASSERT_NE(nullptr, manager.rendererIfLoaded(spec));
+            
+            // a loaded model is not requested again
+            manager.requestModel(spec.path);
+            ASSERT_FALSE(manager.hasPendingModels());
+            ASSERT_EQ(1u, loader.loads);
+        }
+        
+        TEST(EntityModelManagerTest, loadMissingModelAsync) {
+            std::promise<void> release;
+            release.set_value();
+            TestModelLoader loader(release.get_future().share());
+            
+            EntityModelManager manager(nullptr, 0, 0);
+            manager.setLoader(&loader);
+            
+            for (const IO::Path path : { IO::Path("missing.mdl"), IO::Path("broken.mdl") }) {
+                manager.requestModel(path);
+                waitForLoadedModels(manager);
+                manager.commitLoadedModels();
+                
+                ASSERT_FALSE(manager.hasPendingModels());
+                ASSERT_FALSE(manager.hasModel(ModelSpecification(path)));
+                ASSERT_EQ(nullptr, manager.safeGetModel(path));
+                
+                // a model that failed to load is not requested again
+                manager.requestModel(path);
+                ASSERT_FALSE(manager.hasPendingModels());
+            }
+            
+            ASSERT_EQ(2u, loader.loads);
+        }
+        
+        TEST(EntityModelManagerTest, cancelPendingModels) {
+            std::promise<void> release;
+            TestModelLoader loader(release.get_future().share());
+            
+            {
+                EntityModelManager manager(nullptr, 0, 0);
+                manager.setLoader(&loader);
+                
+                manager.requestModel(IO::Path("model.mdl"));
+                manager.requestModel(IO::Path("missing.mdl"));
+                manager.requestModel(IO::Path("broken.mdl"));
+                ASSERT_TRUE(manager.hasPendingModels());
+                
+                // the manager waits for the pending loads, discards their results and ignores their errors
+                std::thread releaser([&release]() { release.set_value(); });
+                ASSERT_NO_THROW(manager.clear());
+                releaser.join();
+                
+                ASSERT_FALSE(manager.hasPendingModels());
+                ASSERT_EQ(3u, loader.loads);
+                ASSERT_EQ(1u, loader.deleted);
+                
+                manager.requestModel(IO::Path("other.mdl"));
+                manager.requestModel(IO::Path("broken.mdl"));
+            }
+            
+            // destroying the manager cancels the pending loads, too
+            ASSERT_EQ(5u, loader.loads);
+            ASSERT_EQ(2u, loader.deleted);
+        }
+    }
+}
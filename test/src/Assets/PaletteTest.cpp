@@ -0,0 +1,70 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Exceptions.h"
+#include "Assets/Palette.h"
+#include "IO/MappedFile.h"
+#include "IO/Path.h"
+
+namespace TrenchBroom {
+    namespace Assets {
+        static IO::MappedFile::Ptr createFile(const String& name, const size_t size) {
+            char* data = new char[size];
+            for (size_t i = 0; i < size; ++i)
+                data[i] = static_cast<char>(i % 256);
+            return IO::MappedFile::Ptr(new IO::MappedFileBuffer(IO::Path(name), data, size));
+        }
+
+        TEST(PaletteTest, loadLmp) {
+            const Palette palette = Palette::loadLmp(createFile("palette.lmp", 768));
+
+            unsigned char index = 1;
+            Buffer<unsigned char> rgbImage(3);
+            Color averageColor;
+            palette.indexedToRgb(&index, 1, rgbImage, averageColor);
+
+            ASSERT_EQ(3, rgbImage[0]);
+            ASSERT_EQ(4, rgbImage[1]);
+            ASSERT_EQ(5, rgbImage[2]);
+        }
+
+        TEST(PaletteTest, loadPcx) {
+            // the palette is stored in the last 768 bytes
+            const Palette palette = Palette::loadPcx(createFile("colormap.pcx", 1024));
+
+            unsigned char index = 0;
+            Buffer<unsigned char> rgbImage(3);
+            Color averageColor;
+            palette.indexedToRgb(&index, 1, rgbImage, averageColor);
+
+            ASSERT_EQ(0, rgbImage[0]);
+            ASSERT_EQ(1, rgbImage[1]);
+            ASSERT_EQ(2, rgbImage[2]);
+        }
+
+        TEST(PaletteTest, loadShortFile) {
+            ASSERT_THROW(Palette::loadLmp(createFile("palette.lmp", 0)), AssetException);
+            ASSERT_THROW(Palette::loadLmp(createFile("palette.lmp", 767)), AssetException);
+            ASSERT_THROW(Palette::loadPcx(createFile("colormap.pcx", 0)), AssetException);
+            ASSERT_THROW(Palette::loadPcx(createFile("colormap.pcx", 767)), AssetException);
+        }
+    }
+}
@@ -22,6 +22,7 @@
 namespace TrenchBroom {
     GLMock::GLMock() {
         glewInitialize.bindMemFunc(this, &GLMock::GlewInitialize);
+        glewIsSupported.bindMemFunc(this, &GLMock::GlewIsSupported);
 
         glGetError.bindMemFunc(this, &GLMock::GetError);
         glGetString.bindMemFunc(this, &GLMock::GetString);
@@ -72,6 +73,13 @@ namespace TrenchBroom {
         glBufferSubData.bindMemFunc(this, &GLMock::BufferSubData);
         glMapBuffer.bindMemFunc(this, &GLMock::MapBuffer);
         glUnmapBuffer.bindMemFunc(this, &GLMock::UnmapBuffer);
+        glBufferStorage.bindMemFunc(this, &GLMock::BufferStorage);
+        glMapBufferRange.bindMemFunc(this, &GLMock::MapBufferRange);
+        
+        glFenceSync.bindMemFunc(this, &GLMock::FenceSync);
+        glClientWaitSync.bindMemFunc(this, &GLMock::ClientWaitSync);
+        glDeleteSync.bindMemFunc(this, &GLMock::DeleteSync);
+        glFinish.bindMemFunc(this, &GLMock::Finish);
         
         glEnableVertexAttribArray.bindMemFunc(this, &GLMock::EnableVertexAttribArray);
         glDisableVertexAttribArray.bindMemFunc(this, &GLMock::DisableVertexAttribArray);
@@ -80,6 +88,7 @@ namespace TrenchBroom {
         glClientActiveTexture.bindMemFunc(this, &GLMock::ClientActiveTexture);
         
         glVertexAttribPointer.bindMemFunc(this, &GLMock::VertexAttribPointer);
+        glVertexAttribDivisor.bindMemFunc(this, &GLMock::VertexAttribDivisor);
         glVertexPointer.bindMemFunc(this, &GLMock::VertexPointer);
         glNormalPointer.bindMemFunc(this, &GLMock::NormalPointer);
         glColorPointer.bindMemFunc(this, &GLMock::ColorPointer);
@@ -87,6 +96,7 @@ namespace TrenchBroom {
         
         glDrawArrays.bindMemFunc(this, &GLMock::DrawArrays);
         glMultiDrawArrays.bindMemFunc(this, &GLMock::MultiDrawArrays);
+        glDrawArraysInstanced.bindMemFunc(this, &GLMock::DrawArraysInstanced);
         
         glCreateShader.bindMemFunc(this, &GLMock::CreateShader);
         glDeleteShader.bindMemFunc(this, &GLMock::DeleteShader);
@@ -141,6 +151,7 @@ namespace TrenchBroom {
         glUniformMatrix4x3fv.bindMemFunc(this, &GLMock::UniformMatrix4x3fv);
         
         glGetUniformLocation.bindMemFunc(this, &GLMock::GetUniformLocation);
+        glGetAttribLocation.bindMemFunc(this, &GLMock::GetAttribLocation);
         
 #ifdef __APPLE__
         glFinishObjectAPPLE.bindMemFunc(this, &GLMock::FinishObjectAPPLE);
@@ -32,6 +32,7 @@ namespace TrenchBroom {
         const GLubyte* GetString(GLenum) { return nullptr; }
         
         MOCK_METHOD0(GlewInitialize, void());
+        MOCK_METHOD1(GlewIsSupported, GLboolean(const char*));
         
         MOCK_METHOD1(Enable, void(GLenum));
         MOCK_METHOD1(Disable, void(GLenum));
@@ -79,6 +80,13 @@ namespace TrenchBroom {
         MOCK_METHOD4(BufferSubData, void(GLenum, GLintptr, GLsizeiptr, const GLvoid*));
         MOCK_METHOD2(MapBuffer, void*(GLenum, GLenum));
         MOCK_METHOD1(UnmapBuffer, GLboolean(GLenum));
+        MOCK_METHOD4(BufferStorage, void(GLenum, GLsizeiptr, const GLvoid*, GLbitfield));
+        MOCK_METHOD4(MapBufferRange, void*(GLenum, GLintptr, GLsizeiptr, GLbitfield));
+        
+        MOCK_METHOD2(FenceSync, GLsync(GLenum, GLbitfield));
+        MOCK_METHOD3(ClientWaitSync, GLenum(GLsync, GLbitfield, GLuint64));
+        MOCK_METHOD1(DeleteSync, void(GLsync));
+        MOCK_METHOD0(Finish, void());
         
         MOCK_METHOD1(EnableVertexAttribArray, void(GLuint));
         MOCK_METHOD1(DisableVertexAttribArray, void(GLuint));
@@ -87,6 +95,7 @@ namespace TrenchBroom {
         MOCK_METHOD1(ClientActiveTexture, void(GLenum));
         
         MOCK_METHOD6(VertexAttribPointer, void(GLuint, GLint, GLenum, GLboolean, GLsizei, const GLvoid*));
+        MOCK_METHOD2(VertexAttribDivisor, void(GLuint, GLuint));
         MOCK_METHOD4(VertexPointer, void(GLint, GLenum, GLsizei, const GLvoid*));
         MOCK_METHOD3(NormalPointer, void(GLenum, GLsizei, const GLvoid*));
         MOCK_METHOD4(ColorPointer, void(GLint, GLenum, GLsizei, const GLvoid*));
@@ -94,6 +103,7 @@ namespace TrenchBroom {
         
         MOCK_METHOD3(DrawArrays, void(GLenum, GLint, GLsizei));
         MOCK_METHOD4(MultiDrawArrays, void(GLenum, const GLint*, const GLsizei*, GLsizei));
+        MOCK_METHOD4(DrawArraysInstanced, void(GLenum, GLint, GLsizei, GLsizei));
         
         MOCK_METHOD1(CreateShader, GLuint(GLenum));
         MOCK_METHOD1(DeleteShader, void(GLuint));
@@ -148,6 +158,7 @@ namespace TrenchBroom {
         MOCK_METHOD4(UniformMatrix4x3fv, void(GLint, GLsizei, GLboolean, const GLfloat*));
         
         MOCK_METHOD2(GetUniformLocation, GLint(GLuint, const GLchar*));
+        MOCK_METHOD2(GetAttribLocation, GLint(GLuint, const GLchar*));
         
 #ifdef __APPLE__
         void FinishObjectAPPLE(GLenum, GLint) {}
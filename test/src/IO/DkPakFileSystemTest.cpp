@@ -149,5 +149,36 @@ namespace TrenchBroom {
             
             ASSERT_TRUE(fs.openFile(Path("amnet.cfg")) != nullptr);
         }
+        
+        TEST(DkPakFileSystemTest, openFileTwice) {
+            const Path pakPath = Disk::getCurrentWorkingDir() + Path("data/IO/Pak/dkpak_test.pak");
+            const MappedFile::Ptr pakFile = Disk::openFile(pakPath);
+            assert(pakFile != nullptr);
+            
+            const DkPakFileSystem fs(pakPath, pakFile);
+            const MappedFile::Ptr file1 = fs.openFile(Path("amnet.cfg"));
+            const MappedFile::Ptr file2 = fs.openFile(Path("AMNET.CFG"));
+            
+            ASSERT_TRUE(file1 != nullptr);
+            ASSERT_EQ(file1, file2);
+            ASSERT_EQ(file1->size(), file2->size());
+        }
+        
+        TEST(DkPakFileSystemTest, openFileFromAnotherFileSystem) {
+            const Path pakPath = Disk::getCurrentWorkingDir() + Path("data/IO/Pak/dkpak_test.pak");
+            
+            MappedFile::Ptr file1;
+            {
+                const DkPakFileSystem fs(pakPath, Disk::openFile(pakPath));
+                file1 = fs.openFile(Path("amnet.cfg"));
+            }
+            
+            // the decompressed contents are shared when the archive is opened again
+            const DkPakFileSystem fs(pakPath, Disk::openFile(pakPath));
+            const MappedFile::Ptr file2 = fs.openFile(Path("amnet.cfg"));
+            
+            ASSERT_TRUE(file1 != nullptr);
+            ASSERT_EQ(file1, file2);
+        }
     }
 }
@@ -0,0 +1,88 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "CollectionUtils.h"
+#include "Logger.h"
+#include "Assets/EntityDefinition.h"
+#include "IO/EntityDefinitionCache.h"
+#include "IO/Path.h"
+#include "IO/TestParserStatus.h"
+
+namespace TrenchBroom {
+    namespace IO {
+        static Assets::EntityDefinitionList parseDefinitions(size_t& parseCount, ParserStatus& status) {
+            ++parseCount;
+            status.warn(1, "a warning");
+            
+            Assets::EntityDefinitionList definitions;
+            definitions.push_back(new Assets::BrushEntityDefinition("worldspawn", Color(), "the world", Assets::AttributeDefinitionList()));
+            definitions.push_back(new Assets::BrushEntityDefinition("func_door", Color(), "a door", Assets::AttributeDefinitionList()));
+            return definitions;
+        }
+        
+        TEST(EntityDefinitionCacheTest, parseOnlyOnce) {
+            EntityDefinitionCache cache;
+            size_t parseCount = 0;
+            auto parse = [&parseCount](ParserStatus& status) { return parseDefinitions(parseCount, status); };
+            
+            TestParserStatus firstStatus;
+            TestParserStatus secondStatus;
+            Assets::EntityDefinitionList first = cache.definitions(Path("/defs/test.fgd"), 1, Color(), firstStatus, parse);
+            Assets::EntityDefinitionList second = cache.definitions(Path("/defs/test.fgd"), 1, Color(), secondStatus, parse);
+            
+            ASSERT_EQ(1u, parseCount);
+            
+            // the messages logged while parsing are replayed when the cached definitions are returned
+            ASSERT_EQ(1u, firstStatus.countStatus(Logger::LogLevel_Debug));
+            ASSERT_EQ(1u, secondStatus.countStatus(Logger::LogLevel_Debug));
+            ASSERT_EQ(2u, first.size());
+            ASSERT_EQ(2u, second.size());
+            for (size_t i = 0; i < first.size(); ++i) {
+                ASSERT_NE(first[i], second[i]);
+                ASSERT_EQ(first[i]->name(), second[i]->name());
+                ASSERT_EQ(first[i]->description(), second[i]->description());
+            }
+            
+            VectorUtils::clearAndDelete(first);
+            VectorUtils::clearAndDelete(second);
+        }
+        
+        TEST(EntityDefinitionCacheTest, parseModifiedFile) {
+            EntityDefinitionCache cache;
+            size_t parseCount = 0;
+            auto parse = [&parseCount](ParserStatus& status) { return parseDefinitions(parseCount, status); };
+            
+            TestParserStatus status;
+            Assets::EntityDefinitionList first = cache.definitions(Path("/defs/test.fgd"), 1, Color(), status, parse);
+            Assets::EntityDefinitionList second = cache.definitions(Path("/defs/test.fgd"), 2, Color(), status, parse);
+            Assets::EntityDefinitionList third = cache.definitions(Path("/defs/test.fgd"), 2, Color(1.0f, 0.0f, 0.0f, 1.0f), status, parse);
+            Assets::EntityDefinitionList fourth = cache.definitions(Path("/defs/other.fgd"), 2, Color(1.0f, 0.0f, 0.0f, 1.0f), status, parse);
+            
+            ASSERT_EQ(4u, parseCount);
+            ASSERT_EQ(4u, status.countStatus(Logger::LogLevel_Debug));
+            
+            VectorUtils::clearAndDelete(first);
+            VectorUtils::clearAndDelete(second);
+            VectorUtils::clearAndDelete(third);
+            VectorUtils::clearAndDelete(fourth);
+        }
+    }
+}
@@ -0,0 +1,147 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "IO/DiskFileSystem.h"
+#include "IO/FileSystemHierarchy.h"
+#include "IO/IdPakFileSystem.h"
+#include "IO/MappedFile.h"
+
+#include <atomic>
+#include <cassert>
+#include <thread>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace IO {
+        static FileSystem* createPakFileSystem(const String& name) {
+            const Path pakPath = Disk::getCurrentWorkingDir() + Path("data/IO/Pak") + Path(name);
+            const MappedFile::Ptr pakFile = Disk::openFile(pakPath);
+            assert(pakFile != nullptr);
+            return new IdPakFileSystem(pakPath, pakFile);
+        }
+        
+        TEST(FileSystemHierarchyTest, fileExists) {
+            FileSystemHierarchy fs;
+            fs.addFileSystem(createPakFileSystem("pak1.pak"));
+            fs.addFileSystem(createPakFileSystem("pak3.pak"));
+            
+            ASSERT_TRUE(fs.fileExists(Path("pics/tag1.pcx")));
+            ASSERT_TRUE(fs.fileExists(Path("gfx/palette.lmp")));
+            ASSERT_TRUE(fs.fileExists(Path("GFX/Palette.LMP")));
+            ASSERT_TRUE(fs.fileExists(Path("pics/../gfx/palette.lmp")));
+            ASSERT_FALSE(fs.fileExists(Path("gfx/asdf.lmp")));
+            ASSERT_FALSE(fs.fileExists(Path("gfx")));
+        }
+        
+        TEST(FileSystemHierarchyTest, directoryExists) {
+            FileSystemHierarchy fs;
+            fs.addFileSystem(createPakFileSystem("pak1.pak"));
+            fs.addFileSystem(createPakFileSystem("pak3.pak"));
+            
+            ASSERT_TRUE(fs.directoryExists(Path("")));
+            ASSERT_TRUE(fs.directoryExists(Path("pics")));
+            ASSERT_TRUE(fs.directoryExists(Path("GFX")));
+            ASSERT_FALSE(fs.directoryExists(Path("gfx/palette.lmp")));
+            ASSERT_FALSE(fs.directoryExists(Path("asdf")));
+        }
+        
+        TEST(FileSystemHierarchyTest, updateIndexWhenFileSystemsChange) {
+            FileSystemHierarchy fs;
+            fs.addFileSystem(createPakFileSystem("pak1.pak"));
+            ASSERT_FALSE(fs.fileExists(Path("gfx/palette.lmp")));
+            
+            fs.addFileSystem(createPakFileSystem("pak3.pak"));
+            ASSERT_TRUE(fs.fileExists(Path("gfx/palette.lmp")));
+            
+            fs.clear();
+            ASSERT_FALSE(fs.fileExists(Path("pics/tag1.pcx")));
+        }
+        
+        TEST(FileSystemHierarchyTest, queryMutableFileSystems) {
+            FileSystemHierarchy fs;
+            fs.addFileSystem(createPakFileSystem("pak1.pak"));
+            fs.addFileSystem(new DiskFileSystem(Disk::getCurrentWorkingDir() + Path("data/IO")));
+            
+            ASSERT_TRUE(fs.fileExists(Path("pics/tag1.pcx")));
+            ASSERT_TRUE(fs.fileExists(Path("Pak/pak1.pak")));
+            ASSERT_TRUE(fs.directoryExists(Path("Pak")));
+            ASSERT_TRUE(fs.openFile(Path("Pak/pak1.pak")) != nullptr);
+        }
+        
+        class UnreadableFileSystem : public FileSystem {
+        private:
+            Path m_file;
+        public:
+            UnreadableFileSystem(const Path& file) :
+            m_file(file) {}
+        private:
+            Path doMakeAbsolute(const Path& relPath) const override {
+                return Path("/unreadable") + relPath;
+            }
+            
+            bool doDirectoryExists(const Path& path) const override {
+                return path.isEmpty();
+            }
+            
+            bool doFileExists(const Path& path) const override {
+                return path == m_file;
+            }
+            
+            Path::List doGetDirectoryContents(const Path& path) const override {
+                return Path::List(1, m_file);
+            }
+            
+            const MappedFile::Ptr doOpenFile(const Path& path) const override {
+                return MappedFile::Ptr();
+            }
+        };
+        
+        TEST(FileSystemHierarchyTest, openShadowedFileIfShadowingFileCannotBeOpened) {
+            FileSystemHierarchy fs;
+            fs.addFileSystem(createPakFileSystem("pak1.pak"));
+            fs.addFileSystem(new UnreadableFileSystem(Path("pics/tag1.pcx")));
+            
+            const MappedFile::Ptr file = fs.openFile(Path("pics/tag1.pcx"));
+            ASSERT_TRUE(file != nullptr);
+        }
+        
+        TEST(FileSystemHierarchyTest, concurrentLookups) {
+            FileSystemHierarchy fs;
+            fs.addFileSystem(createPakFileSystem("pak1.pak"));
+            fs.addFileSystem(createPakFileSystem("pak3.pak"));
+            
+            std::atomic<size_t> found(0);
+            std::vector<std::thread> threads;
+            for (size_t i = 0; i < 4; ++i) {
+                threads.push_back(std::thread([&fs, &found]() {
+                    for (size_t j = 0; j < 100; ++j) {
+                        if (fs.fileExists(Path("pics/tag1.pcx")) && fs.fileExists(Path("gfx/palette.lmp")))
+                            ++found;
+                    }
+                }));
+            }
+            
+            for (std::thread& thread : threads)
+                thread.join();
+            ASSERT_EQ(400u, found.load());
+        }
+    }
+}
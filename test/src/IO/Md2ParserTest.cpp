@@ -0,0 +1,136 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Exceptions.h"
+#include "Assets/Md2Model.h"
+#include "Assets/Palette.h"
+#include "IO/DiskFileSystem.h"
+#include "IO/MappedFile.h"
+#include "IO/Md2Parser.h"
+#include "IO/Path.h"
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace IO {
+        struct Md2Spec {
+            int32_t frameSize;
+            int32_t frameCount;
+            int32_t vertexIndex;
+            size_t truncate;
+
+            Md2Spec() :
+            frameSize(56),
+            frameCount(2),
+            vertexIndex(2),
+            truncate(0) {}
+        };
+
+        template <typename T>
+        static void write(std::vector<char>& data, const T value) {
+            const char* bytes = reinterpret_cast<const char*>(&value);
+            data.insert(std::end(data), bytes, bytes + sizeof(T));
+        }
+
+        /*
+         * Creates a model without skins and with a single triangle strip of three vertices. Every frame has four
+         * vertices, but the last one is not referenced by the strip.
+         */
+        static MappedFile::Ptr createMd2(const Md2Spec& spec) {
+            static const int32_t CommandOffset = 68;
+            static const int32_t CommandCount = 11;
+            static const int32_t FrameOffset = CommandOffset + CommandCount * 4;
+
+            std::vector<char> data;
+            const int32_t header[] = {
+                Md2Layout::Ident, Md2Layout::Version,
+                0, 0, spec.frameSize,  // skin width and height, frame size
+                0, 4, 0, 0, CommandCount, spec.frameCount, // skins, vertices, tex coords, triangles, commands, frames
+                CommandOffset, 0, 0, FrameOffset, CommandOffset, 0 // offsets of skins, tex coords, triangles, frames, commands, end
+            };
+            for (const int32_t value : header)
+                write(data, value);
+
+            write<int32_t>(data, 3);
+            for (const int32_t index : { 0, 1, spec.vertexIndex }) {
+                write(data, 0.0f);
+                write(data, 0.0f);
+                write(data, index);
+            }
+            write<int32_t>(data, 0);
+
+            for (int32_t i = 0; i < spec.frameCount; ++i) {
+                for (const float value : { 1.0f, 1.0f, 1.0f, static_cast<float>(i), 0.0f, 0.0f })
+                    write(data, value);
+                data.insert(std::end(data), 16, '\0');
+                for (const unsigned char value : { 0, 0, 0, 0,  10, 0, 0, 0,  0, 20, 0, 0,  255, 255, 255, 0 })
+                    data.push_back(static_cast<char>(value));
+                if (spec.frameSize > 56)
+                    data.insert(std::end(data), static_cast<size_t>(spec.frameSize - 56), '\0');
+            }
+
+            data.resize(data.size() - spec.truncate);
+
+            char* buffer = new char[data.size()];
+            std::memcpy(buffer, data.data(), data.size());
+            return MappedFile::Ptr(new MappedFileBuffer(Path("model.md2"), buffer, data.size()));
+        }
+
+        static Assets::EntityModel* parseMd2(const Md2Spec& spec) {
+            DiskFileSystem fs(IO::Disk::getCurrentWorkingDir());
+            const Assets::Palette palette = Assets::Palette::loadFile(fs, Path("data/palette.lmp"));
+
+            Md2Parser parser("model", createMd2(spec), palette, fs);
+            return parser.parseModel();
+        }
+
+        TEST(Md2ParserTest, parseModel) {
+            std::unique_ptr<Assets::EntityModel> entityModel(parseMd2(Md2Spec()));
+
+            const Assets::Md2Model* model = dynamic_cast<const Assets::Md2Model*>(entityModel.get());
+            ASSERT_TRUE(model != nullptr);
+            ASSERT_EQ(2u, model->frameCount());
+
+            const Vec3f::List triangles = model->triangles(1);
+            ASSERT_EQ((Vec3f::List { Vec3f(1.0f, 0.0f, 0.0f), Vec3f(11.0f, 0.0f, 0.0f), Vec3f(1.0f, 20.0f, 0.0f) }), triangles);
+        }
+
+        TEST(Md2ParserTest, parseMalformedModel) {
+            Md2Spec truncatedHeader;
+            truncatedHeader.truncate = 2 * 56 + 44 + 8;
+            ASSERT_THROW(parseMd2(truncatedHeader), AssetException);
+
+            Md2Spec truncatedFrames;
+            truncatedFrames.truncate = 1;
+            ASSERT_THROW(parseMd2(truncatedFrames), AssetException);
+
+            Md2Spec smallFrames;
+            smallFrames.frameSize = 52;
+            ASSERT_THROW(parseMd2(smallFrames), AssetException);
+
+            Md2Spec invalidVertexIndex;
+            invalidVertexIndex.vertexIndex = 4;
+            ASSERT_THROW(parseMd2(invalidVertexIndex), AssetException);
+        }
+    }
+}
@@ -0,0 +1,79 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Algorithms.h"
+#include "Assets/MdlModel.h"
+#include "Assets/Palette.h"
+#include "IO/DiskFileSystem.h"
+#include "IO/MdlParser.h"
+#include "IO/Path.h"
+
+#include <memory>
+
+namespace TrenchBroom {
+    namespace IO {
+        static BBox3f triangleBounds(const Vec3f::List& triangles) {
+            return BBox3f(std::begin(triangles), std::end(triangles), Identity());
+        }
+
+        TEST(MdlParserTest, decodeFramesOnDemand) {
+            DiskFileSystem fs(IO::Disk::getCurrentWorkingDir());
+            const Assets::Palette palette = Assets::Palette::loadFile(fs, Path("data/palette.lmp"));
+
+            MdlParser parser("tetrahedron", fs.openFile(Path("data/IO/Mdl/tetrahedron.mdl")), palette);
+            std::unique_ptr<Assets::EntityModel> entityModel(parser.parseModel());
+
+            const Assets::MdlModel* model = dynamic_cast<const Assets::MdlModel*>(entityModel.get());
+            ASSERT_TRUE(model != nullptr);
+
+            // the second frame is a frame group, only its first frame is used
+            ASSERT_EQ(2u, model->frameCount());
+            ASSERT_EQ(0u, model->decodedFrameCount());
+
+            // bounds are computed without decoding any frames
+            const BBox3f bounds0 = model->bounds(0, 0);
+            const BBox3f bounds1 = model->bounds(0, 1);
+            const Mat4x4f transformation = translationMatrix(Vec3f(16.0f, 0.0f, 0.0f));
+            const BBox3f transformedBounds1 = model->transformedBounds(0, 1, transformation);
+            ASSERT_EQ(0u, model->decodedFrameCount());
+
+            ASSERT_EQ(BBox3f(Vec3f(-8.0f, -8.0f, -8.0f), Vec3f( 2.0f, 12.0f, 22.0f)), bounds0);
+            ASSERT_EQ(BBox3f(Vec3f(-3.0f, -3.0f, -3.0f), Vec3f(32.0f, 42.0f, 52.0f)), bounds1);
+            ASSERT_EQ(bounds1.translated(Vec3f(16.0f, 0.0f, 0.0f)), transformedBounds1);
+
+            // a frame is decoded when it is first accessed, and its bounds match the decoded triangles
+            const Vec3f::List triangles1 = model->triangles(1);
+            ASSERT_EQ(12u, triangles1.size());
+            ASSERT_EQ(1u, model->decodedFrameCount());
+            ASSERT_EQ(bounds1, triangleBounds(triangles1));
+            ASSERT_EQ(bounds1, model->bounds(0, 1));
+            ASSERT_EQ(transformedBounds1, model->transformedBounds(0, 1, transformation));
+
+            // accessing a decoded frame again does not decode it again
+            ASSERT_EQ(triangles1, model->triangles(1));
+            ASSERT_EQ(1u, model->decodedFrameCount());
+
+            const Vec3f::List triangles0 = model->triangles(0);
+            ASSERT_EQ(2u, model->decodedFrameCount());
+            ASSERT_EQ(bounds0, triangleBounds(triangles0));
+        }
+    }
+}
@@ -300,5 +300,25 @@ namespace TrenchBroom {
             ASSERT_FALSE(Path("dir/dir2/dir3") < Path("dir/dir2"));
         }
 #endif
+        
+        TEST(PathTest, hash) {
+            ASSERT_EQ(Path("").hash(), Path(" ").hash());
+            ASSERT_EQ(Path("dir/file.txt").hash(), Path("dir/file.txt").hash());
+            ASSERT_EQ(Path("dir/file.txt").hash(), (Path("dir") + Path("file.txt")).hash());
+            ASSERT_EQ(Path("dir/file.txt").hash(), Path("DIR/File.TXT").hash());
+            ASSERT_EQ(Path("dir/file.txt").hash(), Path("dir/file").addExtension("txt").hash());
+            ASSERT_EQ(Path("dir/file.txt").hash(), Path("DIR/FILE.TXT").makeLowerCase().hash());
+            ASSERT_EQ(Path("dir/file.txt").hash(), Path("root/dir/file.txt").deleteFirstComponent().hash());
+            ASSERT_NE(Path("dir").hash(), Path("dir/file.txt").hash());
+        }
+        
+        TEST(PathTest, caseInsensitiveLess) {
+            const Path::Less<StringUtils::CaseInsensitiveStringLess> less;
+            ASSERT_FALSE(less(Path("dir/file"), Path("DIR/FILE")));
+            ASSERT_FALSE(less(Path("DIR/FILE"), Path("dir/file")));
+            ASSERT_TRUE(less(Path("dir"), Path("DIR/file")));
+            ASSERT_TRUE(less(Path("a/file"), Path("a.b/file")));
+            ASSERT_FALSE(less(Path("a.b/file"), Path("a/file")));
+        }
     }
 }
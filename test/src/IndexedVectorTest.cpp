@@ -0,0 +1,95 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "IndexedVector.h"
+
+#include <vector>
+
+typedef IndexedVector<int> IntVector;
+
+void assertItems(const std::vector<int>& expected, const IntVector& actual) {
+    ASSERT_EQ(expected, actual.items());
+    ASSERT_EQ(expected.size(), actual.size());
+    for (const int i : expected)
+        ASSERT_TRUE(actual.contains(i));
+}
+
+TEST(IndexedVectorTest, insert) {
+    IntVector v;
+    ASSERT_TRUE(v.empty());
+
+    ASSERT_TRUE(v.insert(1));
+    ASSERT_TRUE(v.insert(2));
+    ASSERT_TRUE(v.insert(3));
+    ASSERT_FALSE(v.insert(2));
+
+    assertItems(std::vector<int>({ 1, 2, 3 }), v);
+    ASSERT_FALSE(v.contains(4));
+}
+
+TEST(IndexedVectorTest, insertRange) {
+    const std::vector<int> items({ 3, 1, 3, 2, 1 });
+
+    IntVector v(std::begin(items), std::end(items));
+    assertItems(std::vector<int>({ 3, 1, 2 }), v);
+}
+
+TEST(IndexedVectorTest, erase) {
+    IntVector v;
+    v.insert(1);
+    v.insert(2);
+    v.insert(3);
+    v.insert(4);
+
+    ASSERT_FALSE(v.erase(5));
+
+    // the last item takes the place of the removed item
+    ASSERT_TRUE(v.erase(2));
+    assertItems(std::vector<int>({ 1, 4, 3 }), v);
+    ASSERT_FALSE(v.contains(2));
+    ASSERT_FALSE(v.erase(2));
+
+    ASSERT_TRUE(v.erase(3));
+    assertItems(std::vector<int>({ 1, 4 }), v);
+
+    // the moved item can still be found and removed
+    ASSERT_TRUE(v.erase(4));
+    assertItems(std::vector<int>({ 1 }), v);
+
+    ASSERT_TRUE(v.erase(1));
+    ASSERT_TRUE(v.empty());
+
+    // removed items can be added again
+    ASSERT_TRUE(v.insert(2));
+    assertItems(std::vector<int>({ 2 }), v);
+}
+
+TEST(IndexedVectorTest, clear) {
+    IntVector v;
+    v.insert(1);
+    v.insert(2);
+    v.clear();
+
+    ASSERT_TRUE(v.empty());
+    ASSERT_FALSE(v.contains(1));
+    ASSERT_TRUE(v.insert(1));
+    assertItems(std::vector<int>({ 1 }), v);
+}
@@ -0,0 +1,113 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Assets/Texture.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushContentType.h"
+#include "Model/BrushContentTypeBuilder.h"
+#include "Model/BrushContentTypeEvaluator.h"
+#include "Model/BrushFace.h"
+#include "Model/MapFormat.h"
+#include "Model/World.h"
+
+#include <memory>
+
+namespace TrenchBroom {
+    namespace Model {
+        static const BrushContentType::FlagType Trigger = 1 << 0;
+        static const BrushContentType::FlagType Clip = 1 << 1;
+        static const BrushContentType::FlagType Detail = 1 << 2;
+
+        static BrushContentType::List createContentTypes() {
+            BrushContentType::List contentTypes;
+            contentTypes.push_back(BrushContentType("Trigger", true, Trigger, BrushContentTypeEvaluator::textureNameEvaluator("trigger")));
+            contentTypes.push_back(BrushContentType("Clip", true, Clip, BrushContentTypeEvaluator::textureNameEvaluator("clip*")));
+            contentTypes.push_back(BrushContentType("Detail", false, Detail, BrushContentTypeEvaluator::contentFlagsEvaluator(1 << 27)));
+            return contentTypes;
+        }
+
+        static BrushContentType::FlagType contentTypeFlags(const Brush* brush) {
+            BrushContentType::FlagType flags = 0;
+            for (const BrushContentType::FlagType flag : { Trigger, Clip, Detail }) {
+                if (brush->hasContentType(flag))
+                    flags |= flag;
+            }
+            return flags;
+        }
+
+        TEST(BrushContentTypeBuilderTest, buildContentType) {
+            const BBox3 worldBounds(4096.0);
+            World world(MapFormat::Standard, nullptr, worldBounds);
+            const BrushContentTypeBuilder contentTypeBuilder(createContentTypes());
+
+            BrushBuilder builder(&world, worldBounds);
+            std::unique_ptr<Brush> trigger(builder.createCube(64.0, "trigger"));
+            std::unique_ptr<Brush> clip(builder.createCube(64.0, "clip", "clipmonster", "clip", "clip", "clip", "clip"));
+            std::unique_ptr<Brush> mixed(builder.createCube(64.0, "trigger", "clip", "clip", "clip", "clip", "clip"));
+
+            trigger->setContentTypeBuilder(&contentTypeBuilder);
+            clip->setContentTypeBuilder(&contentTypeBuilder);
+            mixed->setContentTypeBuilder(&contentTypeBuilder);
+
+            ASSERT_EQ(Trigger, contentTypeFlags(trigger.get()));
+            ASSERT_TRUE(trigger->transparent());
+            ASSERT_EQ(Clip, contentTypeFlags(clip.get()));
+            ASSERT_EQ(0, contentTypeFlags(mixed.get()));
+            ASSERT_FALSE(mixed->transparent());
+        }
+
+        TEST(BrushContentTypeBuilderTest, invalidateContentTypeOnTextureChange) {
+            const BBox3 worldBounds(4096.0);
+            World world(MapFormat::Standard, nullptr, worldBounds);
+            const BrushContentTypeBuilder contentTypeBuilder(createContentTypes());
+
+            BrushBuilder builder(&world, worldBounds);
+            std::unique_ptr<Brush> brush(builder.createCube(64.0, "trigger", "clip", "trigger", "trigger", "trigger", "trigger"));
+            brush->setContentTypeBuilder(&contentTypeBuilder);
+            ASSERT_EQ(0, contentTypeFlags(brush.get()));
+
+            // the cached face masks must not hide a change of a face's texture
+            Assets::Texture texture("trigger", 16, 16);
+            BrushFace* face = brush->faces()[1];
+            ASSERT_EQ("clip", face->textureName());
+            face->setTexture(&texture);
+            ASSERT_EQ(Trigger, contentTypeFlags(brush.get()));
+            ASSERT_TRUE(brush->transparent());
+
+            face->unsetTexture();
+            ASSERT_EQ(0, contentTypeFlags(brush.get()));
+            ASSERT_FALSE(brush->transparent());
+
+            face->setTexture(&texture);
+            ASSERT_EQ(Trigger, contentTypeFlags(brush.get()));
+
+            for (BrushFace* current : brush->faces())
+                current->setSurfaceContents(1 << 27);
+            ASSERT_EQ(Trigger | Detail, contentTypeFlags(brush.get()));
+
+            face->setSurfaceContents(0);
+            ASSERT_EQ(Trigger, contentTypeFlags(brush.get()));
+
+            face->unsetTexture();
+        }
+    }
+}
@@ -0,0 +1,65 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Model/EditorContext.h"
+#include "Model/Entity.h"
+
+namespace TrenchBroom {
+    namespace Model {
+        TEST(EditorContextTest, reusedIndexDoesNotInheritCachedState) {
+            EditorContext editorContext;
+            
+            Entity* entity1 = new Entity();
+            entity1->setVisiblityState(Visibility_Hidden);
+            entity1->setLockState(Lock_Locked);
+            ASSERT_FALSE(editorContext.visible(entity1));
+            ASSERT_FALSE(editorContext.editable(entity1));
+            
+            const size_t index = entity1->index();
+            const size_t generation = entity1->generation();
+            delete entity1;
+            
+            // the new entity reuses the index of the destroyed one, but not its cached visibility and editability
+            Entity* entity2 = new Entity();
+            ASSERT_EQ(index, entity2->index());
+            ASSERT_NE(generation, entity2->generation());
+            ASSERT_TRUE(editorContext.visible(entity2));
+            ASSERT_TRUE(editorContext.editable(entity2));
+            delete entity2;
+        }
+        
+        TEST(EditorContextTest, invalidateCachedState) {
+            EditorContext editorContext;
+            
+            Entity* entity = new Entity();
+            ASSERT_TRUE(editorContext.visible(entity));
+            
+            entity->setVisiblityState(Visibility_Hidden);
+            editorContext.invalidateNodes(NodeList(1, entity));
+            ASSERT_FALSE(editorContext.visible(entity));
+            
+            entity->setVisiblityState(Visibility_Shown);
+            editorContext.invalidateAllNodes();
+            ASSERT_TRUE(editorContext.visible(entity));
+            delete entity;
+        }
+    }
+}
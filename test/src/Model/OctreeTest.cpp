@@ -73,5 +73,26 @@ namespace TrenchBroom {
             octree.addObject(aBounds, a);
             ASSERT_THROW(octree.removeObject(b), OctreeException);
         }
+        
+        TEST(OctreeTest, findObjectsNearRay) {
+            const BBox3f bounds(-128.0f, +128.0f);
+            const float minSize = 32.0f;
+            Octree<float,int> octree(bounds, minSize);
+            
+            const int a = 1;
+            const int b = 2;
+            octree.addObject(BBox3f(Vec3f(10.0f, 0.0f, 0.0f), Vec3f(12.0f, 1.0f, 1.0f)), a);
+            octree.addObject(BBox3f(Vec3f(60.0f, 40.0f, 0.0f), Vec3f(64.0f, 44.0f, 4.0f)), b);
+            
+            const Ray3f ray(Vec3f(-120.0f, 0.5f, 0.5f), Vec3f::PosX);
+            
+            const std::vector<int> onRay = octree.findObjects(ray);
+            ASSERT_EQ(1u, onRay.size());
+            ASSERT_EQ(a, onRay.front());
+            
+            const std::vector<int> nearRay = octree.findObjects(ray, 0.0f, 0.2f);
+            ASSERT_EQ(2u, nearRay.size());
+            ASSERT_TRUE(std::find(std::begin(nearRay), std::end(nearRay), b) != std::end(nearRay));
+        }
     }
 }
@@ -499,6 +499,48 @@ TEST(PolyhedronTest, testSimpleConvexHullOfCube) {
     ASSERT_TRUE(hasQuadOf(p, p2, p6, p8, p4));
 }
 
+TEST(PolyhedronTest, convexHullOfCubeGridDropsInnerPoints) {
+    Vec3d::List points;
+    for (size_t x = 0; x < 3; ++x) {
+        for (size_t y = 0; y < 3; ++y) {
+            for (size_t z = 0; z < 3; ++z)
+                points.push_back(Vec3d(8.0 * x - 8.0, 8.0 * y - 8.0, 8.0 * z - 8.0));
+        }
+    }
+    
+    Polyhedron3d p(points);
+    ASSERT_TRUE(p.closed());
+    ASSERT_EQ(8u, p.vertexCount());
+    ASSERT_EQ(12u, p.edgeCount());
+    ASSERT_EQ(6u, p.faceCount());
+    ASSERT_EQ(BBox3d(8.0), p.bounds());
+}
+
+TEST(PolyhedronTest, convexHullOfWedge) {
+    // the points of the initial simplex are dropped from the pending points before the furthest point is found
+    const Vec3d::List points = Vec3d::parseList("(-64 -64 64) (-64 64 64) (64 -64 64) (64 64 64) (-64 0 -64) (64 0 -64)");
+    
+    Polyhedron3d p(points);
+    ASSERT_TRUE(p.closed());
+    ASSERT_EQ(6u, p.vertexCount());
+    ASSERT_EQ(9u, p.edgeCount());
+    ASSERT_EQ(5u, p.faceCount());
+    for (const Vec3d& point : points)
+        ASSERT_TRUE(p.hasVertex(point));
+}
+
+TEST(PolyhedronTest, addPointsMatchesIncrementalConvexHull) {
+    const Vec3d::List points = Vec3d::parseList("(0 0 0) (3 1 2) (-4 2 7) (5 -6 1) (2 2 2) (-3 -3 -3) (7 4 -2) (1 -1 8) (-6 5 -1) (0 9 3) (4 4 4) (-2 -7 5) (6 0 6) (1 1 -8)");
+    
+    Polyhedron3d incremental;
+    for (const Vec3d& point : points)
+        incremental.addPoint(point);
+    
+    const Polyhedron3d batch(points);
+    ASSERT_TRUE(batch.closed());
+    ASSERT_EQ(incremental, batch);
+}
+
 TEST(PolyhedronTest, initEmpty) {
     Polyhedron3d p;
     ASSERT_TRUE(p.empty());
@@ -2234,6 +2276,33 @@ TEST(PolyhedronTest, subtractTetrahedronFromCubeWithOverlappingFragments) {
     ASSERT_EQ(3u, result.size());
 }
 
+TEST(PolyhedronTest, subtractNotch) {
+    /*
+     ____________
+     |          |
+     |  ______  |
+     |  |    |  |
+     |__|    |__|
+        |    |
+        |____|
+     */
+    
+    const Polyhedron3d    minuend(BBox3d(Vec3d(-32.0, -16.0, -32.0), Vec3d(32.0, 16.0, 32.0)));
+    const Polyhedron3d subtrahend(BBox3d(Vec3d(-16.0, -32.0, -64.0), Vec3d(16.0, 32.0,  0.0)));
+    
+    Polyhedron3d::SubtractResult result = minuend.subtract(subtrahend);
+    
+    const Vec3d::List left  = Vec3d::parseList("(-32 -16 -32) (-32 16 -32) (-32 -16 32) (-32 16 32) (-16 -16 -32) (-16 16 -32) (-16 -16 32) (-16 16 32)");
+    const Vec3d::List right = Vec3d::parseList("(16 -16 -32) (16 16 -32) (16 -16 32) (16 16 32) (32 -16 -32) (32 16 -32) (32 -16 32) (32 16 32)");
+    const Vec3d::List top   = Vec3d::parseList("(-16 -16 0) (-16 16 0) (-16 -16 32) (-16 16 32) (16 -16 0) (16 16 0) (16 -16 32) (16 16 32)");
+    
+    ASSERT_TRUE(findAndRemove(result, left));
+    ASSERT_TRUE(findAndRemove(result, right));
+    ASSERT_TRUE(findAndRemove(result, top));
+    
+    ASSERT_TRUE(result.empty());
+}
+
 TEST(PolyhedronTest, intersection_empty_polyhedron) {
     const Polyhedron3d empty;
     const Polyhedron3d point      { Vec3d(1.0, 0.0, 0.0) };
@@ -0,0 +1,124 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "CollectionUtils.h"
+#include "VecMath.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/MapFormat.h"
+#include "Model/World.h"
+#include "Renderer/BrushRenderer.h"
+
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        TEST(BrushRendererTest, sortBrushesBySize) {
+            const BBox3 worldBounds(4096.0);
+            Model::World world(Model::MapFormat::Standard, nullptr, worldBounds);
+            Model::BrushBuilder builder(&world, worldBounds);
+            
+            Model::Brush* small = builder.createCube(8.0, "texture");
+            Model::Brush* large = builder.createCuboid(Vec3(16.0, 64.0, 32.0), "texture");
+            Model::Brush* medium = builder.createCube(32.0, "texture");
+            Model::Brush* tiny = builder.createCube(1.0, "texture");
+            
+            Model::BrushList brushes { small, large, medium, tiny };
+            std::vector<FloatType> brushSizes;
+            BrushRenderer::sortBrushes(brushes, brushSizes);
+            
+            // brushes are sorted by decreasing size, where the size of a brush is its largest extent
+            ASSERT_EQ((Model::BrushList { large, medium, small, tiny }), brushes);
+            ASSERT_EQ((std::vector<FloatType> { 64.0, 32.0, 8.0, 1.0 }), brushSizes);
+            
+            VectorUtils::clearAndDelete(brushes);
+        }
+        
+        TEST(BrushRendererTest, releaseEmptyChunks) {
+            const BBox3 worldBounds(4096.0);
+            Model::World world(Model::MapFormat::Standard, nullptr, worldBounds);
+            Model::BrushBuilder builder(&world, worldBounds);
+            
+            Model::BrushList brushes { builder.createCube(8.0, "texture"), builder.createCube(16.0, "texture"), builder.createCube(32.0, "texture") };
+            
+            BrushRenderer renderer(false);
+            ASSERT_EQ(0u, renderer.chunkCount());
+            
+            renderer.addBrushes(brushes);
+            ASSERT_EQ(1u, renderer.chunkCount());
+            
+            renderer.removeBrushes(Model::BrushList { brushes[0], brushes[2] });
+            ASSERT_EQ(1u, renderer.chunkCount());
+            
+            // removing a brush twice has no effect
+            renderer.removeBrushes(Model::BrushList { brushes[0] });
+            ASSERT_EQ(1u, renderer.chunkCount());
+            
+            renderer.removeBrushes(Model::BrushList { brushes[1] });
+            ASSERT_EQ(0u, renderer.chunkCount());
+            
+            renderer.addBrushes(Model::BrushList { brushes[2] });
+            ASSERT_EQ(1u, renderer.chunkCount());
+            
+            renderer.clear();
+            VectorUtils::clearAndDelete(brushes);
+        }
+        
+        TEST(BrushRendererTest, edgeRanges) {
+            // four cubes with 12 edges each, each of which is represented by one point when it is too small
+            const std::vector<FloatType> brushSizes { 64.0, 32.0, 16.0, 8.0 };
+            const std::vector<size_t> edgeIndexCounts { 0, 24, 48, 72, 96 };
+            const std::vector<size_t> pointIndexCounts { 0, 1, 2, 3, 4 };
+            
+            const BrushRenderer::EdgeRanges all = BrushRenderer::edgeRanges(brushSizes, edgeIndexCounts, pointIndexCounts, 0.0);
+            ASSERT_EQ(4u, all.detailBrushCount);
+            ASSERT_EQ(96u, all.edgeIndexCount);
+            ASSERT_EQ(4u, all.pointIndexOffset);
+            ASSERT_EQ(0u, all.pointIndexCount);
+            
+            const BrushRenderer::EdgeRanges some = BrushRenderer::edgeRanges(brushSizes, edgeIndexCounts, pointIndexCounts, 20.0);
+            ASSERT_EQ(2u, some.detailBrushCount);
+            ASSERT_EQ(48u, some.edgeIndexCount);
+            ASSERT_EQ(2u, some.pointIndexOffset);
+            ASSERT_EQ(2u, some.pointIndexCount);
+            
+            // a brush whose size equals the minimum detail size is still rendered with its edges
+            const BrushRenderer::EdgeRanges exact = BrushRenderer::edgeRanges(brushSizes, edgeIndexCounts, pointIndexCounts, 16.0);
+            ASSERT_EQ(3u, exact.detailBrushCount);
+            ASSERT_EQ(72u, exact.edgeIndexCount);
+            ASSERT_EQ(3u, exact.pointIndexOffset);
+            ASSERT_EQ(1u, exact.pointIndexCount);
+            
+            const BrushRenderer::EdgeRanges none = BrushRenderer::edgeRanges(brushSizes, edgeIndexCounts, pointIndexCounts, 128.0);
+            ASSERT_EQ(0u, none.detailBrushCount);
+            ASSERT_EQ(0u, none.edgeIndexCount);
+            ASSERT_EQ(0u, none.pointIndexOffset);
+            ASSERT_EQ(4u, none.pointIndexCount);
+        }
+        
+        TEST(BrushRendererTest, edgeRangesOfEmptyChunk) {
+            const BrushRenderer::EdgeRanges ranges = BrushRenderer::edgeRanges(std::vector<FloatType>(), std::vector<size_t>(1, 0), std::vector<size_t>(1, 0), 16.0);
+            ASSERT_EQ(0u, ranges.detailBrushCount);
+            ASSERT_EQ(0u, ranges.edgeIndexCount);
+            ASSERT_EQ(0u, ranges.pointIndexCount);
+        }
+    }
+}
@@ -0,0 +1,86 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Renderer/EntityModelRenderer.h"
+#include "Renderer/TexturedIndexRangeRenderer.h"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        static Mat4x4f translation(const float x) {
+            return translationMatrix(Vec3f(x, 0.0f, 0.0f));
+        }
+        
+        TEST(EntityModelRendererTest, buildInstanceGroups) {
+            // each renderer stands for a model specification, i.e., a model, skin and frame
+            TexturedIndexRangeRenderer renderer1;
+            TexturedIndexRangeRenderer renderer2;
+            TexturedIndexRangeRenderer renderer3;
+            
+            EntityModelRenderer::InstanceList instances;
+            instances.push_back(EntityModelRenderer::Instance(&renderer1, translation(1.0f)));
+            instances.push_back(EntityModelRenderer::Instance(&renderer2, translation(2.0f)));
+            instances.push_back(EntityModelRenderer::Instance(&renderer1, translation(3.0f)));
+            instances.push_back(EntityModelRenderer::Instance(&renderer3, translation(4.0f)));
+            instances.push_back(EntityModelRenderer::Instance(&renderer1, translation(5.0f)));
+            instances.push_back(EntityModelRenderer::Instance(&renderer2, translation(6.0f)));
+            
+            EntityModelRenderer::TransformList transforms;
+            EntityModelRenderer::InstanceGroupList groups;
+            EntityModelRenderer::buildInstanceGroups(instances, transforms, groups);
+            
+            ASSERT_EQ(instances.size(), transforms.size());
+            ASSERT_EQ(3u, groups.size());
+            
+            // every renderer has exactly one group, and the groups cover all transforms without overlapping
+            size_t offset = 0;
+            for (const EntityModelRenderer::InstanceGroup& group : groups) {
+                ASSERT_EQ(offset, group.offset);
+                ASSERT_EQ(1, std::count_if(std::begin(groups), std::end(groups), [&group](const EntityModelRenderer::InstanceGroup& other) {
+                    return other.renderer == group.renderer;
+                }));
+                
+                // the group holds the transforms of all instances with its renderer in their original order
+                EntityModelRenderer::TransformList expected;
+                for (const EntityModelRenderer::Instance& instance : instances) {
+                    if (instance.first == group.renderer)
+                        expected.push_back(instance.second);
+                }
+                
+                ASSERT_EQ(expected.size(), group.count);
+                const auto first = std::begin(transforms) + static_cast<std::ptrdiff_t>(group.offset);
+                ASSERT_EQ(expected, EntityModelRenderer::TransformList(first, first + static_cast<std::ptrdiff_t>(group.count)));
+                offset += group.count;
+            }
+        }
+        
+        TEST(EntityModelRendererTest, buildEmptyInstanceGroups) {
+            EntityModelRenderer::TransformList transforms(1, translation(1.0f));
+            EntityModelRenderer::InstanceGroupList groups;
+            EntityModelRenderer::buildInstanceGroups(EntityModelRenderer::InstanceList(), transforms, groups);
+            
+            ASSERT_TRUE(transforms.empty());
+            ASSERT_TRUE(groups.empty());
+        }
+    }
+}
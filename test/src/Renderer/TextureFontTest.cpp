@@ -0,0 +1,76 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Renderer/FontTexture.h"
+#include "Renderer/TextureFont.h"
+
+#include <memory>
+#include <string>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        static const unsigned char FirstChar = 32;
+        static const unsigned char CharCount = 96;
+        
+        static TextureFont* createFont() {
+            FontGlyph::List glyphs;
+            for (size_t i = 0; i < CharCount; ++i)
+                glyphs.push_back(FontGlyph(i * 8, 0, 8, 8, 8));
+            return new TextureFont(new FontTexture(CharCount, 8, 1), glyphs, 8, FirstChar, CharCount);
+        }
+        
+        TEST(TextureFontTest, cacheGlyphRuns) {
+            std::unique_ptr<TextureFont> font(createFont());
+            
+            const TextureFont::GlyphRun::Ptr run = font->glyphRun(AttrString("abc"), true);
+            ASSERT_EQ(Vec2f(24.0f, 8.0f), run->size);
+            ASSERT_EQ(3u * 4u * 2u, run->vertices.size());
+            ASSERT_EQ(1u, font->cachedGlyphRunCount());
+            
+            // a hit returns the cached run
+            ASSERT_EQ(run, font->glyphRun(AttrString("abc"), true));
+            ASSERT_EQ(1u, font->cachedGlyphRunCount());
+            
+            // the winding is part of the key
+            ASSERT_NE(run, font->glyphRun(AttrString("abc"), false));
+            ASSERT_EQ(2u, font->cachedGlyphRunCount());
+        }
+        
+        TEST(TextureFontTest, evictLeastRecentlyUsedGlyphRun) {
+            std::unique_ptr<TextureFont> font(createFont());
+            
+            const TextureFont::GlyphRun::Ptr first = font->glyphRun(AttrString("first"), true);
+            const TextureFont::GlyphRun::Ptr second = font->glyphRun(AttrString("second"), true);
+            for (size_t i = 2; i < TextureFont::MaxCachedGlyphRuns; ++i)
+                font->glyphRun(AttrString(std::to_string(i)), true);
+            ASSERT_EQ(TextureFont::MaxCachedGlyphRuns, font->cachedGlyphRunCount());
+            
+            // using the first run again makes the second run the least recently used one
+            ASSERT_EQ(first, font->glyphRun(AttrString("first"), true));
+            
+            font->glyphRun(AttrString("another"), true);
+            ASSERT_EQ(TextureFont::MaxCachedGlyphRuns, font->cachedGlyphRunCount());
+            ASSERT_EQ(first, font->glyphRun(AttrString("first"), true));
+            ASSERT_NE(second, font->glyphRun(AttrString("second"), true));
+            ASSERT_EQ(TextureFont::MaxCachedGlyphRuns, font->cachedGlyphRunCount());
+        }
+    }
+}
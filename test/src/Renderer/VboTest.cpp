@@ -24,6 +24,8 @@
 #include "Renderer/Vbo.h"
 #include "Renderer/VboBlock.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <limits>
 #include <vector>
 
@@ -183,5 +185,194 @@ namespace TrenchBroom {
             // destroy vbo
             EXPECT_CALL(glMock, DeleteBuffers(1, Pointee(13)));
         }
+        
+        TEST(VboTest, streamWithoutBufferStorage) {
+            using namespace testing;
+            InSequence forceInSequenceMockCalls;
+            
+            typedef std::vector<unsigned char> Buf;
+            
+            GLMock glMock;
+            EXPECT_CALL(glMock, BufferSubData(_, _, _, _)).Times(0);
+            
+            Vbo vbo(64, GL_ARRAY_BUFFER, GL_STREAM_DRAW, Vbo::Mode_Stream);
+            
+            // activate for the first time
+            EXPECT_CALL(glMock, GenBuffers(1,_)).WillOnce(SetArgumentPointee<1>(13));
+            EXPECT_CALL(glMock, BindBuffer(GL_ARRAY_BUFFER, 13));
+            EXPECT_CALL(glMock, GlewIsSupported(_)).WillOnce(Return(GL_FALSE));
+            EXPECT_CALL(glMock, BufferData(GL_ARRAY_BUFFER, 64, nullptr, GL_STREAM_DRAW));
+            {
+                ActivateVbo activate(vbo);
+                vbo.beginFrame();
+                
+                VboBlock* block1 = vbo.allocateBlock(20);
+                ASSERT_EQ(0u, block1->offset());
+                VboBlock* block2 = vbo.allocateBlock(8);
+                ASSERT_EQ(32u, block2->offset());
+                
+                const Buf data1(20, 1);
+                const Buf data2(8, 2);
+                {
+                    MapVboBlock map(block1);
+                    block1->writeBuffer(0, data1);
+                }
+                {
+                    MapVboBlock map(block2);
+                    block2->writeBuffer(0, data2);
+                }
+                
+                // the frame is uploaded in one call that orphans the previous buffer contents
+                Buf uploaded;
+                EXPECT_CALL(glMock, BufferData(GL_ARRAY_BUFFER, 48, NotNull(), GL_STREAM_DRAW)).WillOnce(Invoke([&uploaded](GLenum, GLsizeiptr size, const GLvoid* data, GLenum) {
+                    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+                    uploaded.assign(bytes, bytes + size);
+                }));
+                vbo.flush();
+                vbo.endFrame();
+                
+                ASSERT_TRUE(std::equal(std::begin(data1), std::end(data1), std::begin(uploaded)));
+                ASSERT_TRUE(std::equal(std::begin(data2), std::end(data2), std::begin(uploaded) + 32));
+                
+                block1->free();
+                block2->free();
+                
+                // exceeding the capacity grows the client buffer only
+                vbo.beginFrame();
+                VboBlock* block3 = vbo.allocateBlock(100);
+                ASSERT_EQ(0u, block3->offset());
+                block3->free();
+                
+                // deactivate by leaving block
+                EXPECT_CALL(glMock, BindBuffer(GL_ARRAY_BUFFER, 0));
+            }
+            
+            // destroy vbo
+            EXPECT_CALL(glMock, DeleteBuffers(1, Pointee(13)));
+        }
+        
+        TEST(VboTest, streamWithPersistentMapping) {
+            using namespace testing;
+            InSequence forceInSequenceMockCalls;
+            
+            typedef std::vector<unsigned char> Buf;
+            
+            GLMock glMock;
+            EXPECT_CALL(glMock, BufferSubData(_, _, _, _)).Times(0);
+            
+            Vbo vbo(64, GL_ARRAY_BUFFER, GL_STREAM_DRAW, Vbo::Mode_Stream);
+            
+            const GLbitfield flags = GL_MAP_READ_BIT | GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            unsigned char buffer[3 * 64];
+            
+            const GLsync fence1 = reinterpret_cast<GLsync>(static_cast<uintptr_t>(1));
+            const GLsync fence2 = reinterpret_cast<GLsync>(static_cast<uintptr_t>(2));
+            const GLsync fence3 = reinterpret_cast<GLsync>(static_cast<uintptr_t>(3));
+            const GLsync fence4 = reinterpret_cast<GLsync>(static_cast<uintptr_t>(4));
+            const GLsync fence5 = reinterpret_cast<GLsync>(static_cast<uintptr_t>(5));
+            
+            // activate for the first time
+            EXPECT_CALL(glMock, GenBuffers(1,_)).WillOnce(SetArgumentPointee<1>(13));
+            EXPECT_CALL(glMock, BindBuffer(GL_ARRAY_BUFFER, 13));
+            EXPECT_CALL(glMock, GlewIsSupported(StrEq("GL_ARB_sync"))).WillOnce(Return(GL_TRUE));
+            EXPECT_CALL(glMock, BufferStorage(GL_ARRAY_BUFFER, 3 * 64, nullptr, flags));
+            EXPECT_CALL(glMock, MapBufferRange(GL_ARRAY_BUFFER, 0, 3 * 64, flags)).WillOnce(Return(buffer));
+            {
+                ActivateVbo activate(vbo);
+                
+                // first frame uses the second segment and writes directly into the mapped buffer
+                vbo.beginFrame();
+                VboBlock* block = vbo.allocateBlock(16);
+                ASSERT_EQ(64u, block->offset());
+                
+                const Buf data(16, 7);
+                {
+                    MapVboBlock map(block);
+                    block->writeBuffer(0, data);
+                }
+                ASSERT_TRUE(std::equal(std::begin(data), std::end(data), buffer + 64));
+                block->free();
+                
+                vbo.flush();
+                EXPECT_CALL(glMock, FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0)).WillOnce(Return(fence1));
+                vbo.endFrame();
+                
+                // the next two frames use the remaining segments
+                vbo.beginFrame();
+                EXPECT_CALL(glMock, FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0)).WillOnce(Return(fence2));
+                vbo.endFrame();
+                
+                vbo.beginFrame();
+                EXPECT_CALL(glMock, FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0)).WillOnce(Return(fence3));
+                vbo.endFrame();
+                
+                // the fourth frame reuses the first frame's segment and must wait for its fence
+                EXPECT_CALL(glMock, ClientWaitSync(fence1, GL_SYNC_FLUSH_COMMANDS_BIT, _)).WillOnce(Return(GL_TIMEOUT_EXPIRED));
+                EXPECT_CALL(glMock, ClientWaitSync(fence1, GL_SYNC_FLUSH_COMMANDS_BIT, _)).WillOnce(Return(GL_ALREADY_SIGNALED));
+                EXPECT_CALL(glMock, DeleteSync(fence1));
+                vbo.beginFrame();
+                
+                block = vbo.allocateBlock(16);
+                ASSERT_EQ(64u, block->offset());
+                block->free();
+                
+                EXPECT_CALL(glMock, FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0)).WillOnce(Return(fence4));
+                vbo.endFrame();
+                
+                // if waiting for a fence fails, all commands must finish before its segment is reused
+                EXPECT_CALL(glMock, ClientWaitSync(fence2, GL_SYNC_FLUSH_COMMANDS_BIT, _)).WillOnce(Return(GL_WAIT_FAILED));
+                EXPECT_CALL(glMock, Finish());
+                EXPECT_CALL(glMock, DeleteSync(fence2));
+                vbo.beginFrame();
+                
+                EXPECT_CALL(glMock, FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0)).WillOnce(Return(fence5));
+                vbo.endFrame();
+                
+                // deactivate by leaving block
+                EXPECT_CALL(glMock, BindBuffer(GL_ARRAY_BUFFER, 0));
+            }
+            
+            // destroy vbo
+            EXPECT_CALL(glMock, DeleteSync(fence3));
+            EXPECT_CALL(glMock, DeleteSync(fence4));
+            EXPECT_CALL(glMock, DeleteSync(fence5));
+            EXPECT_CALL(glMock, DeleteBuffers(1, Pointee(13)));
+        }
+        
+        TEST(VboTest, streamWithUnboundBufferStorage) {
+            using namespace testing;
+            InSequence forceInSequenceMockCalls;
+            
+            GLMock glMock;
+            // glBufferStorage is not bound if the driver does not support GL_ARB_buffer_storage
+            glBufferStorage.unbindFunc();
+            EXPECT_CALL(glMock, GlewIsSupported(_)).Times(0);
+            EXPECT_CALL(glMock, MapBufferRange(_, _, _, _)).Times(0);
+            
+            Vbo vbo(64, GL_ARRAY_BUFFER, GL_STREAM_DRAW, Vbo::Mode_Stream);
+            
+            // activate for the first time
+            EXPECT_CALL(glMock, GenBuffers(1,_)).WillOnce(SetArgumentPointee<1>(13));
+            EXPECT_CALL(glMock, BindBuffer(GL_ARRAY_BUFFER, 13));
+            EXPECT_CALL(glMock, BufferData(GL_ARRAY_BUFFER, 64, nullptr, GL_STREAM_DRAW));
+            {
+                ActivateVbo activate(vbo);
+                vbo.beginFrame();
+                
+                VboBlock* block = vbo.allocateBlock(16);
+                ASSERT_EQ(0u, block->offset());
+                block->free();
+                
+                EXPECT_CALL(glMock, BufferData(GL_ARRAY_BUFFER, 16, NotNull(), GL_STREAM_DRAW));
+                vbo.flush();
+                vbo.endFrame();
+                
+                // deactivate by leaving block
+                EXPECT_CALL(glMock, BindBuffer(GL_ARRAY_BUFFER, 0));
+            }
+            
+            // destroy vbo
+            EXPECT_CALL(glMock, DeleteBuffers(1, Pointee(13)));
+        }
     }
 }
@@ -0,0 +1,61 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Exceptions.h"
+#include "ThreadPool.h"
+
+#include <atomic>
+#include <vector>
+
+namespace TrenchBroom {
+    TEST(ThreadPoolTest, defaultWorkerCount) {
+        ThreadPool pool;
+        ASSERT_LE(1u, pool.workerCount());
+    }
+    
+    TEST(ThreadPoolTest, submitReturnsResult) {
+        ThreadPool pool(2);
+        
+        std::vector<std::future<size_t>> results;
+        for (size_t i = 0; i < 100; ++i)
+            results.push_back(pool.submit([i]() { return i * i; }));
+        
+        for (size_t i = 0; i < results.size(); ++i)
+            ASSERT_EQ(i * i, results[i].get());
+    }
+    
+    TEST(ThreadPoolTest, submitPropagatesException) {
+        ThreadPool pool(1);
+        
+        std::future<int> result = pool.submit([]() -> int { throw GameException("test"); });
+        ASSERT_THROW(result.get(), GameException);
+    }
+    
+    TEST(ThreadPoolTest, destructorRunsPendingTasks) {
+        std::atomic<size_t> count(0);
+        {
+            ThreadPool pool(2);
+            for (size_t i = 0; i < 50; ++i)
+                pool.submit([&count]() { ++count; });
+        }
+        ASSERT_EQ(50u, count.load());
+    }
+}
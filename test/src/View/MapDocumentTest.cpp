@@ -26,6 +26,7 @@
 #include "Model/Group.h"
 #include "Model/Layer.h"
 #include "Model/BrushFace.h"
+#include "Model/EditorContext.h"
 #include "Model/BrushBuilder.h"
 #include "Model/MapFormat.h"
 #include "Model/ParallelTexCoordSystem.h"
@@ -355,5 +356,95 @@ namespace TrenchBroom {
             ASSERT_EQ((Model::NodeSet {}), SetUtils::makeSet(group1->children()));
             ASSERT_EQ((Model::NodeSet {ent1, ent2}), SetUtils::makeSet(group2->children()));
         }
+        
+        TEST_F(MapDocumentTest, hideLayerInvalidatesCachedVisibility) {
+            Model::Layer* layer = new Model::Layer("Layer 1", document->worldBounds());
+            document->addNode(layer, document->world());
+            
+            Model::Brush* brush1 = createBrush();
+            document->addNode(brush1, layer);
+            
+            Model::Entity* entity = new Model::Entity();
+            document->addNode(entity, layer);
+            Model::Brush* brush2 = createBrush();
+            document->addNode(brush2, entity);
+            
+            const Model::EditorContext& editorContext = document->editorContext();
+            ASSERT_TRUE(editorContext.visible(brush1));
+            ASSERT_TRUE(editorContext.visible(brush2));
+            ASSERT_TRUE(editorContext.visible(entity));
+            
+            document->hide(Model::NodeList {layer});
+            ASSERT_FALSE(editorContext.visible(brush1));
+            ASSERT_FALSE(editorContext.visible(brush2));
+            ASSERT_FALSE(editorContext.visible(entity));
+            
+            document->show(Model::NodeList {layer});
+            ASSERT_TRUE(editorContext.visible(brush1));
+            ASSERT_TRUE(editorContext.visible(brush2));
+            ASSERT_TRUE(editorContext.visible(entity));
+            
+            // the visibility of a brush entity depends on its children
+            document->hide(Model::NodeList {brush2});
+            ASSERT_TRUE(editorContext.visible(brush1));
+            ASSERT_FALSE(editorContext.visible(entity));
+        }
+        
+        TEST_F(MapDocumentTest, groupInvalidatesCachedVisibilityAndEditability) {
+            Model::Brush* brush1 = createBrush();
+            Model::Brush* brush2 = createBrush();
+            Model::Brush* brush3 = createBrush();
+            document->addNode(brush1, document->currentParent());
+            document->addNode(brush2, document->currentParent());
+            document->addNode(brush3, document->currentParent());
+            
+            document->select(Model::NodeList {brush1, brush2});
+            Model::Group* group = document->groupSelection("Group");
+            document->deselectAll();
+            
+            const Model::EditorContext& editorContext = document->editorContext();
+            ASSERT_TRUE(editorContext.editable(brush1));
+            ASSERT_TRUE(editorContext.editable(brush3));
+            
+            // opening a group locks everything outside of it
+            document->openGroup(group);
+            ASSERT_TRUE(editorContext.editable(brush1));
+            ASSERT_FALSE(editorContext.editable(brush3));
+            
+            document->closeGroup();
+            ASSERT_TRUE(editorContext.editable(brush1));
+            ASSERT_TRUE(editorContext.editable(brush3));
+            
+            ASSERT_TRUE(editorContext.visible(group));
+            ASSERT_TRUE(editorContext.visible(brush1));
+            document->hide(Model::NodeList {group});
+            ASSERT_FALSE(editorContext.visible(group));
+            ASSERT_FALSE(editorContext.visible(brush1));
+            ASSERT_TRUE(editorContext.visible(brush3));
+        }
+        
+        TEST_F(MapDocumentTest, editorContextChangeInvalidatesCachedVisibility) {
+            Model::Brush* brush = createBrush();
+            document->addNode(brush, document->currentParent());
+            
+            Model::Entity* entity = new Model::Entity();
+            document->addNode(entity, document->currentParent());
+            
+            Model::EditorContext& editorContext = document->editorContext();
+            ASSERT_TRUE(editorContext.visible(brush));
+            ASSERT_TRUE(editorContext.visible(entity));
+            
+            editorContext.setShowBrushes(false);
+            ASSERT_FALSE(editorContext.visible(brush));
+            ASSERT_TRUE(editorContext.visible(entity));
+            
+            editorContext.setShowPointEntities(false);
+            ASSERT_FALSE(editorContext.visible(entity));
+            
+            editorContext.setShowBrushes(true);
+            editorContext.setShowPointEntities(true);
+            ASSERT_TRUE(editorContext.visible(brush));
+            ASSERT_TRUE(editorContext.visible(entity));
+        }
     }
 }
@@ -91,5 +91,25 @@ namespace TrenchBroom {
             
             ASSERT_EQ(1u, document->selectedNodes().nodeCount());
         }
+        
+        TEST_F(SelectionTest, deselectKeepsOrderOfRemainingNodes) {
+            Model::Brush* brush1 = createBrush();
+            Model::Brush* brush2 = createBrush();
+            Model::Brush* brush3 = createBrush();
+            Model::Brush* brush4 = createBrush();
+            document->addNode(brush1, document->currentParent());
+            document->addNode(brush2, document->currentParent());
+            document->addNode(brush3, document->currentParent());
+            document->addNode(brush4, document->currentParent());
+            
+            document->select(Model::NodeList({ brush1, brush2, brush3, brush4 }));
+            document->deselect(Model::NodeList({ brush4, brush2 }));
+            
+            ASSERT_EQ(Model::NodeList({ brush1, brush3 }), document->selectedNodes().nodes());
+            ASSERT_EQ(Model::BrushList({ brush1, brush3 }), document->selectedNodes().brushes());
+            
+            document->deselect(brush1);
+            ASSERT_EQ(Model::NodeList({ brush3 }), document->selectedNodes().nodes());
+        }
     }
 }
@@ -0,0 +1,138 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "TestUtils.h"
+#include "View/VertexHandleManager.h"
+
+#include <iterator>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace View {
+        TEST(VertexHandleManagerTest, addAndRemoveCountsReferences) {
+            VertexHandleManager manager;
+            manager.add(Vec3(1.0, 2.0, 3.0));
+            manager.add(Vec3(1.0, 2.0, 3.0));
+            manager.add(Vec3(4.0, 5.0, 6.0));
+            ASSERT_EQ(2u, manager.totalHandleCount());
+            
+            ASSERT_TRUE(manager.remove(Vec3(1.0, 2.0, 3.0)));
+            ASSERT_TRUE(manager.contains(Vec3(1.0, 2.0, 3.0)));
+            ASSERT_TRUE(manager.remove(Vec3(1.0, 2.0, 3.0)));
+            ASSERT_FALSE(manager.contains(Vec3(1.0, 2.0, 3.0)));
+            ASSERT_FALSE(manager.remove(Vec3(1.0, 2.0, 3.0)));
+            
+            ASSERT_EQ(1u, manager.totalHandleCount());
+            ASSERT_TRUE(manager.contains(Vec3(4.0, 5.0, 6.0)));
+        }
+        
+        TEST(VertexHandleManagerTest, findAcrossCellBoundaries) {
+            VertexHandleManager manager;
+            
+            // 63.5 lies on a cell boundary, so nearly identical handles end up in different cells
+            manager.add(Vec3(63.45, 0.0, 0.0));
+            ASSERT_TRUE(manager.contains(Vec3(63.55, 0.0, 0.0)));
+            
+            manager.add(Vec3(63.55, 0.0, 0.0));
+            ASSERT_EQ(1u, manager.totalHandleCount());
+            
+            ASSERT_FALSE(manager.contains(Vec3(63.7, 0.0, 0.0)));
+        }
+        
+        TEST(VertexHandleManagerTest, selectionSurvivesRemoval) {
+            VertexHandleManager manager;
+            for (size_t i = 0; i < 10; ++i)
+                manager.add(Vec3(static_cast<FloatType>(i) * 16.0, 0.0, 0.0));
+            
+            manager.select(Vec3(144.0, 0.0, 0.0));
+            manager.select(Vec3(32.0, 0.0, 0.0));
+            ASSERT_EQ(2u, manager.selectedHandleCount());
+            
+            // removing a handle moves the last handle into its place
+            ASSERT_TRUE(manager.remove(Vec3(0.0, 0.0, 0.0)));
+            ASSERT_EQ(9u, manager.totalHandleCount());
+            ASSERT_EQ(2u, manager.selectedHandleCount());
+            ASSERT_TRUE(manager.selected(Vec3(144.0, 0.0, 0.0)));
+            ASSERT_TRUE(manager.selected(Vec3(32.0, 0.0, 0.0)));
+            ASSERT_FALSE(manager.selected(Vec3(16.0, 0.0, 0.0)));
+            
+            ASSERT_TRUE(manager.remove(Vec3(32.0, 0.0, 0.0)));
+            ASSERT_EQ(1u, manager.selectedHandleCount());
+            ASSERT_EQ(1u, manager.selectedHandles().size());
+            ASSERT_EQ(7u, manager.unselectedHandles().size());
+        }
+        
+        TEST(VertexHandleManagerTest, revisionChangesWithHandles) {
+            VertexHandleManager manager;
+            size_t revision = manager.revision();
+            
+            manager.add(Vec3(1.0, 2.0, 3.0));
+            ASSERT_NE(revision, manager.revision());
+            revision = manager.revision();
+            
+            // adding a reference to an existing handle or selecting a selected handle changes nothing
+            manager.add(Vec3(1.0, 2.0, 3.0));
+            ASSERT_EQ(revision, manager.revision());
+            
+            manager.select(Vec3(1.0, 2.0, 3.0));
+            ASSERT_NE(revision, manager.revision());
+            revision = manager.revision();
+            
+            manager.select(Vec3(1.0, 2.0, 3.0));
+            ASSERT_EQ(revision, manager.revision());
+            
+            manager.toggle(Vec3(1.0, 2.0, 3.0));
+            ASSERT_NE(revision, manager.revision());
+            revision = manager.revision();
+            
+            ASSERT_TRUE(manager.remove(Vec3(1.0, 2.0, 3.0)));
+            ASSERT_EQ(revision, manager.revision());
+            ASSERT_TRUE(manager.remove(Vec3(1.0, 2.0, 3.0)));
+            ASSERT_NE(revision, manager.revision());
+        }
+        
+        TEST(VertexHandleManagerTest, findHandlesSkipsCells) {
+            VertexHandleManager manager;
+            manager.add(Vec3(0.0, 0.0, 0.0));
+            manager.add(Vec3(16.0, 0.0, 0.0));
+            manager.add(Vec3(256.0, 0.0, 0.0));
+            
+            const BBox3 query(Vec3(-1.0, -1.0, -1.0), Vec3(32.0, 1.0, 1.0));
+            size_t testedHandles = 0;
+            
+            std::vector<Vec3> result;
+            manager.findHandles([&query](const BBox3& bounds) { return query.intersects(bounds); },
+                                [&testedHandles](const Vec3& handle) { ++testedHandles; return handle.x() > 8.0; },
+                                std::back_inserter(result));
+            
+            ASSERT_EQ(2u, testedHandles);
+            ASSERT_EQ(1u, result.size());
+            ASSERT_VEC_EQ(Vec3(16.0, 0.0, 0.0), result.front());
+        }
+        
+        TEST(VertexHandleManagerTest, edgeHandles) {
+            EdgeHandleManager manager;
+            manager.add(Edge3(Vec3(0.0, 0.0, 0.0), Vec3(128.0, 0.0, 0.0)));
+            ASSERT_TRUE(manager.contains(Edge3(Vec3(128.0, 0.0, 0.0), Vec3(0.05, 0.0, 0.0))));
+            ASSERT_FALSE(manager.contains(Edge3(Vec3(0.0, 0.0, 0.0), Vec3(64.0, 0.0, 0.0))));
+        }
+    }
+}